@@ -6,13 +6,19 @@
 #include <sstream>
 #include <string>
 #include <fstream>
+#include <chrono>
+#include <limits>
+#include <algorithm>
 #include "analysis/AnalysisI.h"
 #include "conf/AnalysisConstantsI.h"
 #include "conf/AccpetanceMapsI.h"
 #include "conf/AnalysisCutsI.h"
+#include "conf/ObservablesI.h"
 #include "utils/KinematicUtils.h"
 #include "utils/DetectorUtils.h"
+#include "utils/ParticleUtils.h"
 #include "utils/Utils.h"
+#include "utils/Serialization.h"
 
 using namespace e4nu; 
 
@@ -26,6 +32,19 @@ AnalysisI::~AnalysisI() { this->Initialize();}
 
 bool AnalysisI::Analyse( EventI * event ) {
 
+  // Step 1 : Apply generic cuts
+  if( ! this->ApplyEventCuts( event ) ) return false ; 
+
+  // Step 2 and 3: Apply momentum cut (detector specific) and cook event
+  // Both are applied in a single pass over the particles
+  this->ApplyParticleCuts( event, false, nullptr ) ; 
+
+  return true ; 
+}
+
+bool AnalysisI::ApplyEventCuts( EventI * event ) {
+  CutFlow::Timer timer( kCutFlow, kStageEventCuts ) ; 
+
   TLorentzVector in_mom = event -> GetInLepton4Mom() ;
   TLorentzVector out_mom = event -> GetOutLepton4Mom() ;
 
@@ -44,126 +63,332 @@ bool AnalysisI::Analyse( EventI * event ) {
     exit(11); 
   }
 
+  kCutFlow.FillStep( kStepRead, event->GetTotalWeight() ) ; 
+
+  // Electron cuts. The cut order is optimised after the warm up events
+  // Rejected events are assigned to the failing cut which was added first (lowest flow_id), so that the
+  // rejection table does not depend on the evaluation order
+  bool warm_up = kNEventsCutWarmUp < kNCutWarmUp ; 
+  if( warm_up ) { 
+    // During the warm up, all cuts are evaluated to measure the pass rate and cost
+    bool pass = true ; 
+    unsigned int flow_id = 0 ; 
+    for( unsigned int i = 0 ; i < kEventCuts.size() ; ++i ) { 
+      auto start = std::chrono::steady_clock::now() ; 
+      bool pass_cut = (this->*kEventCuts[i].cut)( event, out_mom ) ; 
+      kEventCuts[i].time += std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count() ; 
+      ++kEventCuts[i].n_tested ; 
+      if( pass_cut ) ++kEventCuts[i].n_passed ; 
+      else if( pass || kEventCuts[i].flow_id < flow_id ) flow_id = kEventCuts[i].flow_id ; 
+      pass = pass && pass_cut ; 
+    }
+    ++kNEventsCutWarmUp ; 
+    if( kNEventsCutWarmUp == kNCutWarmUp ) this->SortEventCuts() ; 
+    if( !pass ) { 
+      kCutFlow.FillRejection( flow_id, event->GetTotalWeight() ) ; 
+      return false ; 
+    }
+  } else { 
+    for( unsigned int i = 0 ; i < kEventCuts.size() ; ++i ) { 
+      if( ! (this->*kEventCuts[i].cut)( event, out_mom ) ) { 
+	// The cuts before i passed. The cuts after i are only evaluated if they were added before the failing one
+	unsigned int flow_id = kEventCuts[i].flow_id ; 
+	for( unsigned int j = i + 1 ; j < kEventCuts.size() ; ++j ) { 
+	  if( kEventCuts[j].flow_id < flow_id && ! (this->*kEventCuts[j].cut)( event, out_mom ) ) flow_id = kEventCuts[j].flow_id ; 
+	}
+	kCutFlow.FillRejection( flow_id, event->GetTotalWeight() ) ; 
+	return false ; 
+      }
+    }
+  }
+
+  // Apply Mott Scaling to correct for different coupling
+  if ( ApplyMottScaling() ) { 
+    event -> SetMottXSecWeight() ; 
+  }
+
+  // Store analysis record before momentum cuts (0) :
+  event->StoreAnalysisRecord(kid_bcuts);
+  kCutFlow.FillStep( kStepElectronCuts, event->GetTotalWeight() ) ; 
+
+  return true ; 
+}
+
+bool AnalysisI::PassWeightCut( EventI * event, const TLorentzVector & ) {
   // Check weight is physical
   double wght = event->GetEventWeight() ; 
-  if ( wght < 0 || wght > 10 || wght == 0 ) {
-    delete event ;
-    return false ; 
-  }
+  if ( wght < 0 || wght > 10 || wght == 0 ) return false ; 
+  return true ; 
+}
 
+bool AnalysisI::PassElectronThetaCut( EventI * , const TLorentzVector & out_mom ) {
   if( out_mom.Theta() * 180 / TMath::Pi() < GetElectronMinTheta( out_mom ) ) return false ;
+  return true ; 
+}
 
+bool AnalysisI::PassSectorCut( EventI * , const TLorentzVector & out_mom ) {
   double e_phi = out_mom.Phi() ; 
   if( !IsData() ) e_phi += TMath::Pi() ;
-  if( !utils::IsValidSector( e_phi, EBeam, UseAllSectors() ) ) return false ;
+  return utils::IsValidSector( e_phi, GetConfiguredEBeam(), UseAllSectors() ) ;
+}
+
+bool AnalysisI::PassOutElectronMomCut( EventI * , const TLorentzVector & out_mom ) {
+  if( out_mom.P() < conf::GetMinMomentumCut( conf::kPdgElectron, GetConfiguredEBeam() ) ) return false ; 
+  return true ; 
+}
+
+bool AnalysisI::PassThetaSliceCut( EventI * , const TLorentzVector & out_mom ) {
+  if( out_mom.Theta() * 180./TMath::Pi() < conf::kMinEThetaSlice ) return false ; 
+  if( out_mom.Theta() * 180./TMath::Pi() > conf::kMaxEThetaSlice ) return false ; 
+  return true ; 
+}
+
+bool AnalysisI::PassPhiOpeningAngleCut( EventI * , const TLorentzVector & out_mom ) {
+  double phi = out_mom.Phi() ; 
+  if ( ! IsData() ) phi += TMath::Pi() ; 
+  return conf::ValidPhiOpeningAngle( phi ) ;  
+}
+
+bool AnalysisI::PassGoodSectorPhiSliceCut( EventI * , const TLorentzVector & out_mom ) {
+  double phi = out_mom.Phi() ; 
+  if ( ! IsData() ) phi += TMath::Pi() ; 
+  return conf::GoodSectorPhiSlice( phi ) ; 
+}
 
-  if( ApplyOutElectronCut() ){
-    if( out_mom.P() < conf::GetMinMomentumCut( conf::kPdgElectron, EBeam ) ) return false ; 
+bool AnalysisI::PassQ2Cut( EventI * , const TLorentzVector & out_mom ) {
+  double EBeam = GetConfiguredEBeam() ; 
+  double MaxQ2 = 0 ; 
+  if( conf::GetQ2Cut( MaxQ2, EBeam ) ) {
+    if( utils::GetRecoQ2( out_mom, EBeam ) < MaxQ2 ) return false ; 
   }
+  return true ; 
+}
 
-  if( ApplyThetaSlice() ) {
-    if( out_mom.Theta() * 180./TMath::Pi() < conf::kMinEThetaSlice ) return false ; 
-    if( out_mom.Theta() * 180./TMath::Pi() > conf::kMaxEThetaSlice ) return false ; 
+bool AnalysisI::PassWCut( EventI * , const TLorentzVector & out_mom ) {
+  double EBeam = GetConfiguredEBeam() ; 
+  double MinW = 0 ; 
+  if( conf::GetWCut( MinW, EBeam ) ) {
+    if( utils::GetRecoW( out_mom, EBeam ) > MinW ) return false ; 
   }
+  return true ; 
+}
 
-  if( ApplyPhiOpeningAngle() ) {
-    double phi = out_mom.Phi() ; 
-    if ( ! IsData() ) phi += TMath::Pi() ; 
-    if ( ! conf::ValidPhiOpeningAngle( phi ) ) return false ;  
+template<conf::BeamPeriod period>
+bool AnalysisI::PassOutElectronMomCutT( EventI * , const TLorentzVector & out_mom ) {
+  if( out_mom.P() < conf::BeamPeriodCuts<period>::kMinEMom ) return false ; 
+  return true ; 
+}
+
+template<conf::BeamPeriod period>
+bool AnalysisI::PassQ2CutT( EventI * , const TLorentzVector & out_mom ) {
+  if( utils::GetRecoQ2( out_mom, GetConfiguredEBeam() ) < conf::BeamPeriodCuts<period>::kQ2Cut ) return false ; 
+  return true ; 
+}
+
+template<conf::BeamPeriod period>
+bool AnalysisI::PassWCutT( EventI * , const TLorentzVector & out_mom ) {
+  if( utils::GetRecoW( out_mom, GetConfiguredEBeam() ) > conf::BeamPeriodCuts<period>::kWCut ) return false ; 
+  return true ; 
+}
+
+template<conf::BeamPeriod period>
+void AnalysisI::AddBeamPeriodCuts(void) {
+  // Cuts which are not defined for this beam period are not added
+  if( ApplyOutElectronCut() ) AddEventCut( "OutEMom", &AnalysisI::PassOutElectronMomCutT<period> ) ; 
+  if( ApplyQ2Cut() && conf::BeamPeriodCuts<period>::kApplyQ2Cut ) AddEventCut( "Q2", &AnalysisI::PassQ2CutT<period> ) ; 
+  if( ApplyWCut() && conf::BeamPeriodCuts<period>::kApplyWCut ) AddEventCut( "W", &AnalysisI::PassWCutT<period> ) ; 
+}
+
+void AnalysisI::AddEventCut( const std::string name, bool (AnalysisI::*cut)( EventI * event, const TLorentzVector & out_mom ) ) {
+  EventCut event_cut ; 
+  event_cut.name = name ; 
+  event_cut.cut = cut ; 
+  event_cut.flow_id = kCutFlow.AddRejection( name ) ; 
+  kEventCuts.push_back( event_cut ) ; 
+}
+
+void AnalysisI::SortEventCuts(void) {
+  // The expected cost is minimised by ordering independent cuts by cost / rejection rate
+  // Cuts which never reject events are evaluated last
+  std::vector<double> rank ; 
+  for( unsigned int i = 0 ; i < kEventCuts.size() ; ++i ) { 
+    double cost = kEventCuts[i].time / kEventCuts[i].n_tested ; 
+    double rejection = 1. - (double) kEventCuts[i].n_passed / kEventCuts[i].n_tested ; 
+    if( rejection > 0 ) rank.push_back( cost / rejection ) ; 
+    else rank.push_back( std::numeric_limits<double>::max() ) ; 
   }
 
-  if( ApplyGoodSectorPhiSlice() ) {
-    double phi = out_mom.Phi() ; 
-    if ( ! IsData() ) phi += TMath::Pi() ; 
-    if ( ! conf::GoodSectorPhiSlice( phi ) ) return false ; 
+  std::vector<unsigned int> order ; 
+  for( unsigned int i = 0 ; i < kEventCuts.size() ; ++i ) order.push_back( i ) ; 
+  std::stable_sort( order.begin(), order.end(), [&rank]( unsigned int a, unsigned int b ) { return rank[a] < rank[b] ; } ) ; 
+
+  std::vector<EventCut> sorted_cuts ; 
+  std::cout << " Electron cut order after " << kNEventsCutWarmUp << " events : " << std::endl;
+  for( unsigned int i = 0 ; i < order.size() ; ++i ) { 
+    const EventCut & cut = kEventCuts[order[i]] ; 
+    std::cout << "    " << cut.name << " : pass rate " << (double) cut.n_passed / cut.n_tested 
+	      << ", cost " << 1E9 * cut.time / cut.n_tested << " ns " << std::endl;
+    sorted_cuts.push_back( cut ) ; 
   }
+  kEventCuts = sorted_cuts ; 
+}
 
-  double reco_Q2 = utils::GetRecoQ2( out_mom, EBeam ) ; 
-  double W_var = utils::GetRecoW( out_mom, EBeam ) ;
+void AnalysisI::WriteCutState( std::ostream & out ) const {
+  utils::WriteBinary( out, kNEventsCutWarmUp ) ; 
+  utils::WriteBinary( out, (unsigned long) kEventCuts.size() ) ; 
+  for( unsigned int i = 0 ; i < kEventCuts.size() ; ++i ) { 
+    utils::WriteBinary( out, kEventCuts[i].name ) ; 
+    utils::WriteBinary( out, kEventCuts[i].n_tested ) ; 
+    utils::WriteBinary( out, kEventCuts[i].n_passed ) ; 
+    utils::WriteBinary( out, kEventCuts[i].time ) ; 
+  }
+  kCutFlow.WriteState( out ) ; 
+}
 
-  if( ApplyQ2Cut() ) {
-    double MaxQ2 = 0 ; 
-    if( conf::GetQ2Cut( MaxQ2, EBeam ) ) {
-      if( reco_Q2 < MaxQ2 ) return false ; 
-    }
+bool AnalysisI::ReadCutState( std::istream & in ) {
+  // The cuts are restored in the stored order, so that the evaluation order does not change
+  unsigned long n_cuts = 0 ; 
+  if( ! utils::ReadBinary( in, kNEventsCutWarmUp ) || ! utils::ReadBinary( in, n_cuts ) ) return false ; 
+  if( n_cuts != kEventCuts.size() ) return false ; 
+  std::vector<EventCut> stored_cuts ; 
+  for( unsigned int i = 0 ; i < n_cuts ; ++i ) { 
+    std::string name ; 
+    if( ! utils::ReadBinary( in, name ) ) return false ; 
+    unsigned int j = 0 ; 
+    while( j < kEventCuts.size() && kEventCuts[j].name != name ) ++j ; 
+    if( j == kEventCuts.size() ) return false ; 
+    EventCut cut = kEventCuts[j] ; 
+    if( ! ( utils::ReadBinary( in, cut.n_tested ) && utils::ReadBinary( in, cut.n_passed ) && utils::ReadBinary( in, cut.time ) ) ) return false ; 
+    stored_cuts.push_back( cut ) ; 
   }
+  kEventCuts = stored_cuts ; 
+  return kCutFlow.ReadState( in ) ; 
+}
 
-  if( ApplyWCut() ) {
-    double MinW = 0 ; 
-    if( conf::GetWCut( MinW, EBeam ) ) {
-      if( W_var > MinW ) return false ; 
-    }
+template<bool apply_mom_cut, bool apply_reso, bool apply_fiducial>
+bool AnalysisI::ApplyParticleCutsT( EventI * event, const Fiducial * fiducial ) {
+  CutFlow::Timer timer( kCutFlow, kStageParticleCuts ) ; 
+  // Single in-place pass over the particles. For each particle : 
+  // 1. Momentum cut on the uncorrected momentum (detector specific)
+  // 2. Cook event : remove particles not specified in topology maps. These are ignored in the analysis
+  // 3. Smear particle momentum (if apply_reso)
+  // 4. Fiducial cut (if apply_fiducial)
+  // The status of each particle is kept in kParticleMask. The maps are only compacted at the end
+  // It returns false if the electron is not in the fiducial volume
+  double EBeam = GetConfiguredEBeam() ; 
+  std::map<int,unsigned int> Topology = GetTopology();
+  std::map<int,std::vector<TLorentzVector>> & part_map = event -> GetFinalParticles4MomRef() ;
+  std::map<int,std::vector<TLorentzVector>> & part_map_uncorr = event -> GetFinalParticlesUnCorr4MomRef() ;
+  TLorentzVector out_mom = event -> GetOutLepton4Mom() ;
+
+  // The electron is smeared first. The particle index is used as counter in the smearing stream
+  CounterRNG rng( GetRandomSeed(), event -> GetRandomKey(), kRandomSmearing ) ; 
+  if( apply_reso ) { 
+    TLorentzVector smeared_out_mom = out_mom ; 
+    utils::ApplyResolution( conf::kPdgElectron, smeared_out_mom, EBeam, rng, 0 ) ; 
+    event -> SetOutLeptonKinematics( smeared_out_mom ) ; 
   }
 
-  // Apply Mott Scaling to correct for different coupling
-  if ( ApplyMottScaling() ) { 
-    event -> SetMottXSecWeight() ; 
+  kParticleMask.clear() ; 
+  std::vector<int> pdg_list_acuts ; 
+  for( auto it = part_map_uncorr.begin() ; it != part_map_uncorr.end() ; ++it ) {
+    int pdg = it->first ; 
+    bool in_topology = Topology.find( pdg ) != Topology.end() ; 
+    double min_p = apply_mom_cut ? conf::GetMinMomentumCut( pdg, EBeam ) : 0 ; 
+    std::vector<TLorentzVector> & particles = part_map[pdg] ; 
+    for( unsigned int i = 0 ; i < (it->second).size() ; ++i ) {
+      unsigned int status = 0 ; 
+      bool pass_mom_cut = true ; 
+      if( apply_mom_cut ) { 
+	// Only keep particles above threshold. Apply photon cuts for MC and data 
+	if( (it->second)[i].P() <= min_p ) pass_mom_cut = false ; 
+	else if( pdg == conf::kPdgPhoton && ! conf::ApplyPhotRadCut( out_mom, (it->second)[i] ) ) pass_mom_cut = false ; 
+      }
+      if( pass_mom_cut ) { 
+	status |= kPassMomCut ; 
+	pdg_list_acuts.push_back( pdg ) ; 
+	if( in_topology ) { 
+	  status |= kPassTopology ;
+	  particles[i] = (it->second)[i] ; 
+	  if( apply_reso ) utils::ApplyResolution( pdg, particles[i], EBeam, rng, kParticleMask.size() + 1 ) ;
+	  if( !apply_fiducial || fiducial -> FiducialCut( pdg, EBeam, particles[i].Vect(), IsData() ) ) status |= kPassFiducial ;
+	}
+      }
+      kParticleMask.push_back( status ) ; 
+    }
   }
 
-  // Store analysis record before momentum cuts (0) :
-  event->StoreAnalysisRecord(kid_bcuts);
+  // Store analysis record after momentum cuts (1) : 
+  event->StoreAnalysisRecord( kid_acuts, pdg_list_acuts );
 
-  // Step 2: Apply momentum cut (detector specific) 
-  if( ApplyMomCut() ) { 
-    this->ApplyMomentumCut( event ) ; 
+  // Apply fiducial cut to electron
+  if( apply_fiducial ) { 
+    if( ! fiducial -> FiducialCut( conf::kPdgElectron, EBeam, event -> GetOutLepton4Mom().Vect(), IsData() ) ) return false ; 
   }
-  // Store analysis record after momentum cuts:
-  event->StoreAnalysisRecord(kid_acuts);
 
-  // Step 3 : Cook event
-  // Remove particles not specified in topology maps
-  // These are ignored in the analysis
-  // No Cuts are applied on those
-  this->CookEvent( event ) ; 
+  // Compact the particle maps according to the mask
+  const unsigned int pass_all = kPassMomCut | kPassTopology | kPassFiducial ; 
+  unsigned int mask_id = 0 ; 
+  for( auto it = part_map_uncorr.begin() ; it != part_map_uncorr.end() ; ) {
+    int pdg = it->first ; 
+    unsigned int n_particles = (it->second).size() ; 
+    if( Topology.find( pdg ) == Topology.end() ) { 
+      mask_id += n_particles ; 
+      part_map.erase( pdg ) ; 
+      it = part_map_uncorr.erase( it ) ; 
+      continue ; 
+    }
+    std::vector<TLorentzVector> & particles = part_map[pdg] ; 
+    unsigned int n_active = 0 ; 
+    for( unsigned int i = 0 ; i < n_particles ; ++i, ++mask_id ) { 
+      if( ( kParticleMask[mask_id] & pass_all ) != pass_all ) continue ; 
+      particles[n_active] = particles[i] ; 
+      (it->second)[n_active] = (it->second)[i] ; 
+      ++n_active ; 
+    }
+    particles.resize( n_active ) ; 
+    (it->second).resize( n_active ) ; 
+
+    // Particles with no visible entries are removed after fiducial cuts
+    if( apply_fiducial && n_active == 0 ) { 
+      part_map.erase( pdg ) ; 
+      it = part_map_uncorr.erase( it ) ; 
+      continue ; 
+    }
+    ++it ; 
+  }
 
+  kCutFlow.FillStep( kStepParticleCuts, event->GetTotalWeight() ) ; 
   return true ; 
 }
 
-
-void AnalysisI::ApplyMomentumCut( EventI * event ) {
-
-  std::map<int,std::vector<TLorentzVector>> unsmeared_part_map = event -> GetFinalParticlesUnCorr4Mom() ;
-  TLorentzVector out_mom = event -> GetOutLepton4Mom() ;
-  // Remove particles below threshold
-  for( auto it = unsmeared_part_map.begin() ; it != unsmeared_part_map.end() ; ++it ) {
-    std::vector<TLorentzVector> above_th_particles ; 
-    for( unsigned int i = 0 ; i < unsmeared_part_map[it->first].size() ; ++i ) {
-      // Only store particles above threshold
-      if( unsmeared_part_map[it->first][i].P() <= conf::GetMinMomentumCut( it->first, GetConfiguredEBeam() ) )  continue ; 
-	 
-      // Apply photon cuts for MC and data 
-      if( it->first == conf::kPdgPhoton ) {
-	if( ! conf::ApplyPhotRadCut( out_mom, unsmeared_part_map[it->first][i] ) ) continue ; 
-      }
-      above_th_particles.push_back( unsmeared_part_map[it->first][i] ) ;
+bool AnalysisI::ApplyParticleCuts( EventI * event, const bool apply_reso, const Fiducial * fiducial ) {
+  // Select the pipeline specialized for this flag combination. Disabled stages are compiled away
+  if( ApplyMomCut() ) { 
+    if( apply_reso ) { 
+      if( fiducial ) return ApplyParticleCutsT<true,true,true>( event, fiducial ) ; 
+      return ApplyParticleCutsT<true,true,false>( event, fiducial ) ; 
     }
-    unsmeared_part_map[it->first] = above_th_particles ;
+    if( fiducial ) return ApplyParticleCutsT<true,false,true>( event, fiducial ) ; 
+    return ApplyParticleCutsT<true,false,false>( event, fiducial ) ; 
   }
-  event -> SetFinalParticlesKinematics( unsmeared_part_map ) ;
-  event -> SetFinalParticlesUnCorrKinematics( unsmeared_part_map ) ; 
-  
-  return ;
+  if( apply_reso ) { 
+    if( fiducial ) return ApplyParticleCutsT<false,true,true>( event, fiducial ) ; 
+    return ApplyParticleCutsT<false,true,false>( event, fiducial ) ; 
+  }
+  if( fiducial ) return ApplyParticleCutsT<false,false,true>( event, fiducial ) ; 
+  return ApplyParticleCutsT<false,false,false>( event, fiducial ) ; 
 }
 
-void AnalysisI::CookEvent( EventI * event ) { 
-  // Remove particles not specified in topology maps
-  // These are ignored in the analysis
-  // No Cuts are applied on those
-  TLorentzVector out_mom = event -> GetOutLepton4Mom() ; 
-  std::map<int,std::vector<TLorentzVector>> part_map = event -> GetFinalParticlesUnCorr4Mom() ;
-  std::map<int,unsigned int> Topology = GetTopology();
-  std::map<int,std::vector<TLorentzVector>> cooked_part_map ; 
-  for( auto it = part_map.begin() ; it != part_map.end() ; ++it ) {
-    if( Topology.find(it->first) == Topology.end() ) continue ; 
-    std::vector<TLorentzVector> topology_particles ;
-    for( unsigned int i = 0 ; i < part_map[it->first].size() ; ++i ) {
-      topology_particles.push_back( part_map[it->first][i] ) ;
-    }
-    cooked_part_map[it->first] = topology_particles ;
+bool AnalysisI::PassMomentumCut( const int pdg, const TLorentzVector & mom, const TLorentzVector & out_mom ) const {
+  if( ! ApplyMomCut() ) return true ; 
+  // Only keep particles above threshold
+  if( mom.P() <= conf::GetMinMomentumCut( pdg, GetConfiguredEBeam() ) ) return false ; 
+  // Apply photon cuts for MC and data 
+  if( pdg == conf::kPdgPhoton ) {
+    if( ! conf::ApplyPhotRadCut( out_mom, mom ) ) return false ; 
   }
-  event -> SetFinalParticlesKinematics( cooked_part_map ) ;
-  event -> SetFinalParticlesUnCorrKinematics( cooked_part_map ) ;
-  return ; 
+  return true ; 
 }
 
 void AnalysisI::PlotBkgInformation( EventI * event ) {
@@ -186,9 +411,10 @@ void AnalysisI::PlotBkgInformation( EventI * event ) {
       || !kHistograms[kid_2p0pitruebkg] || !kHistograms[kid_1p1pitruebkg] || !kHistograms[kid_2p1pitruebkg] || !kHistograms[kid_1p2pitruebkg] 
       || !kHistograms[kid_2p0piestbkg] || !kHistograms[kid_1p1piestbkg] || !kHistograms[kid_2p1piestbkg] || !kHistograms[kid_1p2piestbkg] ) return ;
 
+  double ECal = event->GetObservable( conf::kObsECal ) ; 
   if( (record_afiducials.first).size() > min_mult ) {
     // This is used to estimate the total background contribution 
-    kHistograms[kid_totestbkg]->Fill( event->GetObservable("ECal"), - event->GetTotalWeight() ) ; 
+    kHistograms[kid_totestbkg]->Fill( ECal, - event->GetTotalWeight() ) ; 
 
     // Store contributions from different multiplicities 
     // Check only direct contribution : 
@@ -200,7 +426,7 @@ void AnalysisI::PlotBkgInformation( EventI * event ) {
       // Fill for direct contributions only
       unsigned int id2 = kid_totestbkg + original_mult - min_mult ; 	
       if( kHistograms[id2] && is_m_bkg ) {
-	kHistograms[id2]->Fill( event->GetObservable("ECal"), -event->GetTotalWeight() ) ;
+	kHistograms[id2]->Fill( ECal, -event->GetTotalWeight() ) ;
       }
 
       // Filling for specific topologies:
@@ -222,12 +448,12 @@ void AnalysisI::PlotBkgInformation( EventI * event ) {
       // Add breakdown in topologies
       if( original_mult == 2 ) {
 	// Store according to initial topology
-	if( nprotons == 2 && npions == 0 ) kHistograms[kid_2p0piestbkg]->Fill( event->GetObservable("ECal"), -event->GetTotalWeight() ) ;
-	if( nprotons == 1 && npions == 1 ) kHistograms[kid_1p1piestbkg]->Fill( event->GetObservable("ECal"), -event->GetTotalWeight() ) ;
+	if( nprotons == 2 && npions == 0 ) kHistograms[kid_2p0piestbkg]->Fill( ECal, -event->GetTotalWeight() ) ;
+	if( nprotons == 1 && npions == 1 ) kHistograms[kid_1p1piestbkg]->Fill( ECal, -event->GetTotalWeight() ) ;
       } else if (original_mult == 3 ) { 
 	// Store according to initial topology
-	if( nprotons == 2 && npions == 1 ) kHistograms[kid_2p1piestbkg]->Fill( event->GetObservable("ECal"), -event->GetTotalWeight() ) ;
-	if( nprotons == 1 && npions == 2 ) kHistograms[kid_1p2piestbkg]->Fill( event->GetObservable("ECal"), -event->GetTotalWeight() ) ;
+	if( nprotons == 2 && npions == 1 ) kHistograms[kid_2p1piestbkg]->Fill( ECal, -event->GetTotalWeight() ) ;
+	if( nprotons == 1 && npions == 2 ) kHistograms[kid_1p2piestbkg]->Fill( ECal, -event->GetTotalWeight() ) ;
       }
 
       ++original_mult; 
@@ -236,15 +462,15 @@ void AnalysisI::PlotBkgInformation( EventI * event ) {
   } else { 
     // These are singal events. They are classified as either true signal or bkg events that contribute to signal after fiducial
     if( (record_afiducials.first).size() == (record_amomcuts.first).size() && (record_acccorr.first).size() == 0 ) {
-      kHistograms[kid_signal]->Fill( event->GetObservable("ECal"), event->GetTotalWeight() ) ;
+      kHistograms[kid_signal]->Fill( ECal, event->GetTotalWeight() ) ;
     } else if( (record_afiducials.first).size() == (record_amomcuts.first).size() && (record_acccorr.first).size() != 0 ) {
-      kHistograms[kid_acccorr]->Fill( event->GetObservable("ECal"), event->GetTotalWeight() ) ;
+      kHistograms[kid_acccorr]->Fill( ECal, event->GetTotalWeight() ) ;
     } else { 
-      kHistograms[kid_tottruebkg]->Fill( event->GetObservable("ECal"), event->GetTotalWeight() ) ;
+      kHistograms[kid_tottruebkg]->Fill( ECal, event->GetTotalWeight() ) ;
      
       // Fill each multiplicity contribution 
       unsigned int id = (record_amomcuts.first).size() - min_mult ; 
-      if( kHistograms[kid_tottruebkg+id] ) kHistograms[kid_tottruebkg+id]->Fill( event->GetObservable("ECal"), event->GetTotalWeight() ) ;
+      if( kHistograms[kid_tottruebkg+id] ) kHistograms[kid_tottruebkg+id]->Fill( ECal, event->GetTotalWeight() ) ;
 
       // Count number of protons and pions
       unsigned int nprotons = 0 ; 
@@ -258,12 +484,12 @@ void AnalysisI::PlotBkgInformation( EventI * event ) {
       // Add breakdown in topologies
       if( (record_amomcuts.first).size() == 2 ) {
 	// Store according to initial topology
-	if( nprotons == 2 && npions == 0 ) kHistograms[kid_2p0pitruebkg]->Fill( event->GetObservable("ECal"), event->GetTotalWeight() ) ;
-	if( nprotons == 1 && npions == 1 ) kHistograms[kid_1p1pitruebkg]->Fill( event->GetObservable("ECal"), event->GetTotalWeight() ) ;
+	if( nprotons == 2 && npions == 0 ) kHistograms[kid_2p0pitruebkg]->Fill( ECal, event->GetTotalWeight() ) ;
+	if( nprotons == 1 && npions == 1 ) kHistograms[kid_1p1pitruebkg]->Fill( ECal, event->GetTotalWeight() ) ;
       } else if ( (record_amomcuts.first).size() == 3 ) { 
 	// Store according to initial topology
-	if( nprotons == 2 && npions == 1 ) kHistograms[kid_2p1pitruebkg]->Fill( event->GetObservable("ECal"), event->GetTotalWeight() ) ;
-	if( nprotons == 1 && npions == 2 ) kHistograms[kid_1p2pitruebkg]->Fill( event->GetObservable("ECal"), event->GetTotalWeight() ) ;
+	if( nprotons == 2 && npions == 1 ) kHistograms[kid_2p1pitruebkg]->Fill( ECal, event->GetTotalWeight() ) ;
+	if( nprotons == 1 && npions == 2 ) kHistograms[kid_1p2pitruebkg]->Fill( ECal, event->GetTotalWeight() ) ;
       }
     }
   }
@@ -282,6 +508,29 @@ void AnalysisI::Initialize(void) {
   if( Ebeam == 4.461 ) { kElectronFit -> SetParameters(13.5,15) ; }
   if( !kElectronFit ) kIsConfigured = false ; 
   if( kIsConfigured ) kIsConfigured = InitializeFiducial() ; 
+
+  // Electron cuts, in the default order
+  kCutFlow = CutFlow() ; 
+  kEventCuts.clear() ; 
+  kNEventsCutWarmUp = 0 ; 
+  kNCutWarmUp = GetNCutWarmUpEvents() ; 
+  AddEventCut( "Weight", &AnalysisI::PassWeightCut ) ; 
+  AddEventCut( "ElectronTheta", &AnalysisI::PassElectronThetaCut ) ; 
+  AddEventCut( "Sector", &AnalysisI::PassSectorCut ) ; 
+  if( ApplyThetaSlice() ) AddEventCut( "ThetaSlice", &AnalysisI::PassThetaSliceCut ) ; 
+  if( ApplyPhiOpeningAngle() ) AddEventCut( "PhiOpeningAngle", &AnalysisI::PassPhiOpeningAngleCut ) ; 
+  if( ApplyGoodSectorPhiSlice() ) AddEventCut( "GoodSectorPhiSlice", &AnalysisI::PassGoodSectorPhiSliceCut ) ; 
+
+  // Beam dependent cuts. The cut values are compile-time constants for known beam periods
+  switch( conf::GetBeamPeriod( GetConfiguredEBeam() ) ) { 
+  case conf::k1161Period : AddBeamPeriodCuts<conf::k1161Period>() ; break ; 
+  case conf::k2261Period : AddBeamPeriodCuts<conf::k2261Period>() ; break ; 
+  case conf::k4461Period : AddBeamPeriodCuts<conf::k4461Period>() ; break ; 
+  default : 
+    if( ApplyOutElectronCut() ) AddEventCut( "OutEMom", &AnalysisI::PassOutElectronMomCut ) ; 
+    if( ApplyQ2Cut() ) AddEventCut( "Q2", &AnalysisI::PassQ2Cut ) ; 
+    if( ApplyWCut() ) AddEventCut( "W", &AnalysisI::PassWCut ) ; 
+  }
 }
 
 bool AnalysisI::Finalise(void) {
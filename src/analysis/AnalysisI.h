@@ -7,12 +7,15 @@
 
 #include <vector>
 #include <map>
+#include <string>
 #include "TH1D.h"
 #include "TFile.h"
 #include "TTree.h"
 #include "physics/EventI.h"
 #include "utils/Fiducial.h"
+#include "utils/CutFlow.h"
 #include "analysis/BackgroundI.h"
+#include "conf/AnalysisCutsI.h"
 
 namespace e4nu { 
 
@@ -29,9 +32,10 @@ namespace e4nu {
     bool Finalise(void) ;
 
   protected : 
-    void CookEvent( EventI * event ) ;
+    bool ApplyEventCuts( EventI * event ) ; 
+    bool ApplyParticleCuts( EventI * event, const bool apply_reso, const Fiducial * fiducial ) ;
+    bool PassMomentumCut( const int pdg, const TLorentzVector & mom, const TLorentzVector & out_mom ) const ;
     void PlotBkgInformation( EventI * event ) ;
-    void ApplyMomentumCut( EventI * event ) ;
     double GetElectronMinTheta( TLorentzVector emom ) ;      
 
     // ID for Background historams
@@ -39,10 +43,58 @@ namespace e4nu {
     unsigned int kid_2p0pitruebkg, kid_1p1pitruebkg, kid_2p1pitruebkg, kid_1p2pitruebkg ;
     unsigned int kid_2p0piestbkg, kid_1p1piestbkg, kid_2p1piestbkg, kid_1p2piestbkg ;
 
+    // Cut-flow and timing per analysis stage
+    CutFlow kCutFlow ; 
+
+    // Electron cut order and counters, and cut-flow. Used for the analysis checkpoints
+    void WriteCutState( std::ostream & out ) const ; 
+    bool ReadCutState( std::istream & in ) ; 
+
     virtual ~AnalysisI();
 
   private : 
     TF1 * kElectronFit = nullptr ; 
+
+    // Particle status after each step of ApplyParticleCuts
+    static const unsigned int kPassMomCut = 1 ; 
+    static const unsigned int kPassTopology = 2 ; 
+    static const unsigned int kPassFiducial = 4 ; 
+    std::vector<unsigned int> kParticleMask ; 
+
+    // ApplyParticleCuts specialized for each combination of momentum cut, resolution and fiducial flags
+    template<bool apply_mom_cut, bool apply_reso, bool apply_fiducial> 
+    bool ApplyParticleCutsT( EventI * event, const Fiducial * fiducial ) ; 
+
+    // Electron cuts. These are reordered after the warm up events
+    bool PassWeightCut( EventI * event, const TLorentzVector & out_mom ) ; 
+    bool PassElectronThetaCut( EventI * event, const TLorentzVector & out_mom ) ; 
+    bool PassSectorCut( EventI * event, const TLorentzVector & out_mom ) ; 
+    bool PassOutElectronMomCut( EventI * event, const TLorentzVector & out_mom ) ; 
+    bool PassThetaSliceCut( EventI * event, const TLorentzVector & out_mom ) ; 
+    bool PassPhiOpeningAngleCut( EventI * event, const TLorentzVector & out_mom ) ; 
+    bool PassGoodSectorPhiSliceCut( EventI * event, const TLorentzVector & out_mom ) ; 
+    bool PassQ2Cut( EventI * event, const TLorentzVector & out_mom ) ; 
+    bool PassWCut( EventI * event, const TLorentzVector & out_mom ) ; 
+
+    // Specialized electron cuts for known beam periods (see conf::BeamPeriodCuts)
+    template<conf::BeamPeriod period> bool PassOutElectronMomCutT( EventI * event, const TLorentzVector & out_mom ) ; 
+    template<conf::BeamPeriod period> bool PassQ2CutT( EventI * event, const TLorentzVector & out_mom ) ; 
+    template<conf::BeamPeriod period> bool PassWCutT( EventI * event, const TLorentzVector & out_mom ) ; 
+    template<conf::BeamPeriod period> void AddBeamPeriodCuts(void) ; 
+
+    struct EventCut { 
+      std::string name ; 
+      bool (AnalysisI::*cut)( EventI * event, const TLorentzVector & out_mom ) = nullptr ; 
+      unsigned long n_tested = 0 ; 
+      unsigned long n_passed = 0 ; 
+      double time = 0 ; // seconds
+      unsigned int flow_id = 0 ; // rejection counter in kCutFlow
+    } ; 
+    void AddEventCut( const std::string name, bool (AnalysisI::*cut)( EventI * event, const TLorentzVector & out_mom ) ) ; 
+    void SortEventCuts(void) ; 
+    std::vector<EventCut> kEventCuts ; 
+    unsigned int kNCutWarmUp = 0 ; 
+    unsigned int kNEventsCutWarmUp = 0 ; 
       
   };
 }
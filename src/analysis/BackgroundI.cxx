@@ -6,12 +6,15 @@
 #include <sstream>
 #include <string>
 #include <fstream>
+#include <cmath>
+#include <algorithm>
 #include "analysis/BackgroundI.h"
 #include "conf/AnalysisConstantsI.h"
 #include "conf/AccpetanceMapsI.h"
 #include "conf/AnalysisCutsI.h"
 #include "utils/KinematicUtils.h"
 #include "utils/Utils.h"
+#include "utils/RotationKernel.h"
 
 using namespace e4nu; 
 
@@ -29,6 +32,8 @@ BackgroundI::BackgroundI( const double EBeam, const unsigned int TargetPdg ) : C
 
 BackgroundI::~BackgroundI() {
   delete kRotation ;
+  delete kOrbitAcceptance ;
+  delete kElectronAcceptance ;
 }
 
 void BackgroundI::Initialize(void){
@@ -36,10 +41,172 @@ void BackgroundI::Initialize(void){
     kRotation = new Subtraction();
     kRotation->InitSubtraction( GetConfiguredEBeam(), GetConfiguredTarget(), GetNRotations(), GetFiducialCut() );
     kRotation->ResetQVector(); 
+    kRotation->SetRotationMethod( GetRotationMethod() ) ; 
+    if( GetRotationMethod() == kAnalyticRotations ) kOrbitAcceptance = new OrbitAcceptance( GetFiducialCut(), GetConfiguredEBeam(), IsData() ) ;
+    if( ApplyElectronAccCorrection() ) kElectronAcceptance = new ElectronAcceptanceTable( GetFiducialCut(), GetConfiguredEBeam(), IsData() ) ;
+    if( GetMaxRotations() != GetNRotations() && GetRotationMethod() != kAnalyticRotations ) {
+      std::cout << " WARN : NRotations is not a multiple of " << GetRotationBlockSize() << ". Using at most " << GetMaxRotations() << " rotations per event" << std::endl;
+    }
   }
 }
 
+unsigned int BackgroundI::GetRotationBlockSize(void) const {
+  if( GetRotationPrecision() <= 0 ) return GetNRotations() ;
+  return std::min( kRotationBlock, GetNRotations() ) ;
+}
+
+unsigned int BackgroundI::GetMaxRotations(void) const {
+  // Only whole blocks are rotated, so that the last block is a full set of stratified or lattice angles
+  // NRotations is a cap, so it is rounded down. The block size is at most NRotations, hence there is at least one block
+  unsigned int block = GetRotationBlockSize() ;
+  if( block == 0 ) return 0 ;
+  return ( GetNRotations() / block ) * block ;
+}
+
 unsigned int BackgroundI::GetMinParticleMultiplicity( int pdg ) const {
   std::map<int,unsigned int> Topology = GetTopology();
   return Topology[pdg] ;
 }
+
+void BackgroundI::GetMaskWeights( const std::vector<std::pair<unsigned long,double>> & rotations, const unsigned int n_particles,
+				  std::vector<std::pair<unsigned long,double>> & mask_weights ) const {
+  mask_weights.clear() ;
+  if( n_particles <= kMaxFlatMaskParticles ) {
+    std::vector<double> weights( 1UL << n_particles, 0 ) ;
+    std::vector<char> is_filled( weights.size(), false ) ;
+    for( unsigned int i = 0 ; i < rotations.size() ; ++i ) {
+      weights[rotations[i].first] += rotations[i].second ;
+      is_filled[rotations[i].first] = true ;
+    }
+    for( unsigned long mask = 0 ; mask < weights.size() ; ++mask ) {
+      if( is_filled[mask] ) mask_weights.push_back( std::make_pair( mask, weights[mask] ) ) ;
+    }
+    return ;
+  }
+
+  std::vector<std::pair<unsigned long,double>> sorted = rotations ;
+  std::sort( sorted.begin(), sorted.end() ) ;
+  for( unsigned int i = 0 ; i < sorted.size() ; ++i ) {
+    if( mask_weights.size() && mask_weights.back().first == sorted[i].first ) mask_weights.back().second += sorted[i].second ;
+    else mask_weights.push_back( sorted[i] ) ;
+  }
+}
+
+void BackgroundI::GetDetectionFraction( const std::vector<std::pair<unsigned long,double>> & rotations, const std::vector<char> & is_detected,
+					double & fraction, double & variance ) const {
+  double total = 0, detected = 0 ;
+  for( unsigned int i = 0 ; i < rotations.size() ; ++i ) {
+    total += rotations[i].second ;
+    if( is_detected[i] ) detected += rotations[i].second ;
+  }
+  fraction = total > 0 ? detected / total : 0 ;
+
+  // Analytic rotations are exact. Uniform rotations are binomial
+  // Stratified and lattice angles are ordered in the orbit. The variance is estimated from the differences between neighbour pairs
+  // The pairs are formed inside each block, so that the two angles of a pair belong to the same set
+  variance = 0 ;
+  unsigned int n_rot = rotations.size() ;
+  if( GetRotationMethod() == kRandomRotations ) {
+    if( n_rot > 1 ) variance = fraction * ( 1 - fraction ) / ( n_rot - 1 ) ;
+  } else if( GetRotationMethod() != kAnalyticRotations ) {
+    unsigned int block = std::max( GetRotationBlockSize(), 1u ) ;
+    for( unsigned int start = 0 ; start < n_rot ; start += block ) {
+      unsigned int end = std::min( start + block, n_rot ) ;
+      for( unsigned int i = start ; i + 1 < end ; i += 2 ) {
+	if( is_detected[i] != is_detected[i+1] ) variance += 1 ;
+      }
+    }
+    variance /= (double) n_rot * n_rot ;
+  }
+}
+
+bool BackgroundI::IsRotationConverged( const std::vector<std::pair<unsigned long,double>> & rotations, const std::vector<char> & is_detected ) const {
+  if( GetRotationMethod() == kAnalyticRotations ) return true ;
+  if( rotations.size() >= GetMaxRotations() ) return true ;
+  if( GetRotationPrecision() <= 0 ) return false ;
+
+  double fraction = 0, variance = 0 ;
+  GetDetectionFraction( rotations, is_detected, fraction, variance ) ;
+  // If all rotations agree, the variance estimate is 0. The fraction is replaced by (k+1)/(n+2)
+  unsigned int n_rot = rotations.size() ;
+  if( fraction == 0 || fraction == 1 ) {
+    fraction = ( fraction * n_rot + 1 ) / ( n_rot + 2 ) ;
+    variance = fraction * ( 1 - fraction ) / n_rot ;
+  }
+  // Relative uncertainty of the detected fraction, which is also the relative uncertainty of the corrected event weights
+  return std::sqrt( variance ) < GetRotationPrecision() * fraction ;
+}
+
+void BackgroundI::AddRotationStats( const unsigned int m, const std::vector<std::pair<unsigned long,double>> & rotations, const std::vector<char> & is_detected ) {
+  if( rotations.empty() ) return ;
+  double fraction = 0, variance = 0 ;
+  GetDetectionFraction( rotations, is_detected, fraction, variance ) ;
+
+  std::lock_guard<std::mutex> lock( kRotationStatsMutex ) ;
+  RotationStats & stats = kRotationStats[m] ;
+  ++stats.n_events ;
+  stats.n_rotations += rotations.size() ;
+  stats.sum_fraction += fraction ;
+  stats.sum_variance += variance ;
+  stats.sum_binomial += fraction * ( 1 - fraction ) ;
+}
+
+void BackgroundI::PrintRotationStats(void) const {
+  std::lock_guard<std::mutex> lock( kRotationStatsMutex ) ;
+  if( kRotationStats.empty() ) return ;
+  std::cout << "\nRotation estimates : " << std::endl;
+  for( auto it = kRotationStats.begin() ; it != kRotationStats.end() ; ++it ) {
+    const RotationStats & stats = it->second ;
+    std::cout << "    Multiplicity " << it->first << ( it->first == GetMinBkgMult() ? " (acceptance correction)" : " (background)" )
+	      << " : " << stats.n_events << " events, mean detection fraction " << stats.sum_fraction / stats.n_events
+	      << ", mean variance " << stats.sum_variance / stats.n_events ;
+    if( GetRotationMethod() != kAnalyticRotations ) std::cout << ", mean rotations " << stats.n_rotations / (double) stats.n_events ;
+    // Number of uniform rotations with the same mean variance
+    if( stats.sum_variance > 0 ) std::cout << ", equivalent to " << stats.sum_binomial / stats.sum_variance << " uniform rotations" ;
+    std::cout << std::endl;
+  }
+}
+
+bool BackgroundI::GetRotatedDetection( const std::vector<int> & pdgs, const std::vector<TVector3> & momenta, const TVector3 & axis,
+				       const CounterRNG & rng, const bool require_all, std::vector<std::pair<unsigned long,double>> & rotations ) const {
+  if( pdgs.size() > 64 ) {
+    std::cout << " ERROR : Cannot rotate events with more than 64 particles in the signal definition" << std::endl;
+    return false ;
+  }
+
+  if( GetRotationMethod() == kAnalyticRotations ) {
+    if( !kOrbitAcceptance ) return false ;
+    std::vector<std::pair<unsigned long,double>> segments ;
+    kOrbitAcceptance->GetSegments( pdgs, momenta, axis, segments ) ;
+    rotations.insert( rotations.end(), segments.begin(), segments.end() ) ;
+    return true ;
+  }
+
+  if( !kFiducialCut ) return false ;
+  // Each block is a full set of stratified or lattice angles
+  unsigned int block = GetRotationBlockSize() ;
+  unsigned int first_rotation = rotations.size() ;
+  unsigned int last_rotation = std::min( first_rotation + block, GetMaxRotations() ) ;
+  if( last_rotation <= first_rotation ) return true ;
+  std::vector<double> angles( last_rotation - first_rotation ) ;
+  for ( unsigned int rot_id = first_rotation ; rot_id < last_rotation ; ++rot_id ) {
+    angles[rot_id-first_rotation] = rng.RotationAngle( GetRotationMethod(), rot_id, block ) ;
+  }
+
+  // All the particles are rotated at once
+  RotationKernel kernel( axis, momenta ) ;
+  kernel.Rotate( angles ) ;
+  // Each particle is checked for all the angles at once
+  unsigned int n_angles = angles.size() ;
+  std::vector<unsigned long> detected( n_angles, 0 ) ;
+  std::unique_ptr<bool[]> is_detected( new bool[n_angles] ) ;
+  for( unsigned int k = 0 ; k < pdgs.size() ; ++k ) {
+    kFiducialCut->FiducialCutBatch( pdgs[k], GetConfiguredEBeam(), n_angles, kernel.GetX( k ), kernel.GetY( k ), kernel.GetZ( k ), is_detected.get(), IsData() ) ;
+    for ( unsigned int j = 0 ; j < n_angles ; ++j ) {
+      // With require_all, the particles after the first undetected one are not flagged
+      if( is_detected[j] && ( !require_all || detected[j] == ( 1UL << k ) - 1 ) ) detected[j] |= 1UL << k ;
+    }
+  }
+  for ( unsigned int j = 0 ; j < n_angles ; ++j ) rotations.push_back( std::make_pair( detected[j], 1. ) ) ;
+  return true ;
+}
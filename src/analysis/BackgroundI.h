@@ -8,6 +8,7 @@
 
 #include <vector>
 #include <map>
+#include <mutex>
 #include "TH1D.h"
 #include "TFile.h"
 #include "TTree.h"
@@ -15,6 +16,11 @@
 #include "physics/EventI.h"
 #include "physics/MCEvent.h"
 #include "utils/Subtraction.h"
+#include "utils/Tracer.h"
+#include "utils/ParallelUtils.h"
+#include "utils/CounterRNG.h"
+#include "utils/OrbitAcceptance.h"
+#include "utils/ElectronAcceptanceTable.h"
 
 namespace e4nu { 
 
@@ -29,6 +35,9 @@ namespace e4nu {
 
     // Some useful functions:
     unsigned int GetMinParticleMultiplicity( int pdg ) const ;
+
+    // Prints the estimated variance of the rotation estimates, per multiplicity
+    void PrintRotationStats(void) const ;
     
     // Definition of Background mehtod
     // These template class guarantees the same substraction method for data and MC
@@ -37,138 +46,209 @@ namespace e4nu {
       bool BackgroundSubstraction( std::map<int,std::vector<T*>> & event_holder ) { 
       if( !ApplyFiducial()  ) return true ; 
       if( !GetSubtractBkg() ) return true ;
-      Fiducial * fiducial = GetFiducialCut() ; 
 
       unsigned int max_mult = GetMaxBkgMult(); // Max multiplicity specified in conf file
       unsigned int min_mult = GetMinBkgMult(); // Signal multiplicity
-      std::map<int,unsigned int> Topology = GetTopology();
       unsigned int m = max_mult ;
   
       while ( m > min_mult ) {
 	if( event_holder.find(m) != event_holder.end() ) {
 	  std::cout<< " Substracting background events with with multiplicity " << m << ". The total number of bkg events is: " << event_holder[m].size() <<std::endl; 
+	  if( ! BackgroundSubstraction( event_holder, m ) ) return false ; 
+	}
+	--m; 
+      }
+
+      return true ; 
+    }
+
+    // Background substraction of the events with multiplicity m only
+    // The lower multiplicity contributions are appended to event_holder. The rotated events are deleted and
+    // removed from event_holder[m], which keeps the events that are never reconstructed with multiplicity m
+    template <class T>
+      bool BackgroundSubstraction( std::map<int,std::vector<T*>> & event_holder, const unsigned int m ) { 
+      if( !ApplyFiducial()  ) return true ; 
+      if( !GetSubtractBkg() ) return true ;
+      if( event_holder.find(m) == event_holder.end() ) return true ; 
+
+      Tracer::Span span( "BackgroundSubstraction" ) ; 
+      span.AddArg( "multiplicity", std::to_string( m ) ) ; 
+      span.AddArg( "events", std::to_string( event_holder[m].size() ) ) ; 
+
+      // Rotated events have lower multiplicity, so the events with multiplicity m are not modified in the loop
+      // Each event is rotated in parallel. The results are stored per event and merged in event order
+      // The workers share the Fiducial instance. This is safe because its cut methods are const and do not use TF1 objects
+      std::vector<T*> events ; 
+      events.swap( event_holder[m] ) ; 
+      unsigned int n_events = events.size() ; 
+      std::vector<std::map<int,std::vector<T*>>> new_events( n_events ) ; 
+      std::vector<char> is_rotated( n_events, false ) ; 
+      utils::ParallelFor( n_events, GetNThreads(), [&]( unsigned int i ) { 
+	  is_rotated[i] = RotateBackgroundEvent( events[i], m, new_events[i] ) ; 
+	} ) ; 
+
+      for( unsigned int event_id = 0 ; event_id < n_events ; ++event_id ) { 
+	// Skip if denominator is 0
+	if( ! is_rotated[event_id] ) { 
+	  event_holder[m].push_back( events[event_id] ) ; 
+	  continue ; 
+	}
+
+	// Store event particles with correct weight and multiplicty
+	for( auto it = new_events[event_id].begin() ; it != new_events[event_id].end() ; ++it ) { 
+	  std::vector<T*> & temp = event_holder[it->first] ; 
+	  temp.insert( temp.end(), (it->second).begin(), (it->second).end() ) ; 
+	}
+	delete events[event_id];
+      } // Close event loop 
+
+      return true ; 
+    }
+
+    // Streaming version of the background substraction method
+    // The event (multiplicity m) is rotated and the lower multiplicity contributions are rotated recursively
+    // until signal multiplicity is reached. The signal multiplicity contributions are added to signal_events
+    // The original event is not deleted
+    template <class T>
+      bool StreamBackgroundSubstraction( T * event, const unsigned int m, std::vector<T*> & signal_events ) { 
+      if( !ApplyFiducial()  ) return true ; 
+      if( !GetSubtractBkg() ) return true ;
+
+      unsigned int min_mult = GetMinBkgMult(); // Signal multiplicity
+      if( m <= min_mult ) return true ; 
+
+      std::map<int,std::vector<T*>> new_events ; 
+      if( ! RotateBackgroundEvent( event, m, new_events ) ) return true ; 
+
+      for( auto it = new_events.begin() ; it != new_events.end() ; ++it ) { 
+	for( unsigned int k = 0 ; k < (it->second).size() ; ++k ) { 
+	  if( (unsigned int) it->first == min_mult ) { 
+	    signal_events.push_back( (it->second)[k] ) ; 
+	    continue ; 
+	  }
+	  // Cascade down to signal multiplicity
+	  StreamBackgroundSubstraction( (it->second)[k], it->first, signal_events ) ; 
+	  delete (it->second)[k] ;
+	}
+      }
+      return true ; 
+    }
+
+    // Rotation estimate for a single background event with multiplicity m
+    // It returns false if the event is never reconstructed with multiplicity m
+    // Otherwise, the weighted lower multiplicity contributions are stored in new_events, with multiplicity as key
+    // The rotation angles are drawn from the event stream, with the rotation number as counter
+    // The events created from the rotations get a new random key, derived from the event key and their position
+    // The containment of each particle is stored as a bit mask per rotation. The same masks give the acceptance
+    // of the new events, which is stored in the events and used by the acceptance correction
+    template <class T>
+      bool RotateBackgroundEvent( T * event, const unsigned int m, std::map<int,std::vector<T*>> & new_events ) { 
+      const Fiducial * fiducial = GetFiducialCut() ; 
+      if( !fiducial ) return false ; 
 
-	  for( unsigned int event_id = 0 ; event_id < event_holder[m].size() ; ++event_id ) { 
-	    // Add counter for same multiplicity 
-	    double N_all = 0 ; 
-	    std::map<std::map<std::vector<int>,std::vector<int>>, double> probability_count ; // size of pdg_vector is multiplicity
-	    // probability_counts is the number of events with that specific topology and id list 	
-	    // Start rotations
-	    for ( unsigned int rot_id = 0 ; rot_id < GetNRotations() ; ++rot_id ) { 
-	      // Set rotation around q3 vector
-	      TVector3 VectorRecoQ = event_holder[m][event_id]->GetRecoq3() ;	
-	      double rotation_angle = gRandom->Uniform(0,2*TMath::Pi());
-	  
-	      // Rotate all Hadrons
-	      std::map<int,std::vector<TLorentzVector>> rot_particles = event_holder[m][event_id]->GetFinalParticles4Mom() ;
-	      std::map<int,std::vector<TLorentzVector>> rot_particles_uncorr = event_holder[m][event_id]->GetFinalParticlesUnCorr4Mom() ;       
-	      unsigned int rot_event_mult = 0 ; // rotated event multiplicity
-	      std::vector<int> part_pdg_list, part_id_list ; 
-
-	      for( auto it = rot_particles.begin() ; it != rot_particles.end() ; ++it ) {
-		int part_pdg = it->first ; 
-		if( Topology.find( part_pdg ) == Topology.end() ) continue ; // Skip particles which are not in signal definition 
-
-		for ( unsigned int part_id = 0 ; part_id < (it->second).size() ; ++part_id ) {
-		  TVector3 part_vect = (it->second)[part_id].Vect() ;
-		  part_vect.Rotate(rotation_angle,VectorRecoQ);
-	      
-		  // Check which particles are in fiducial
-		  bool is_particle_contained = fiducial->FiducialCut( part_pdg, GetConfiguredEBeam(), part_vect, IsData() ) ; 
-	      
-		  // Calculate rotated event multiplicity
-		  if( is_particle_contained ) {
-		    ++rot_event_mult ; 
-		    part_pdg_list.push_back( part_pdg ) ; 
-		    part_id_list.push_back( part_id ) ; 
-		  } 
-		} // end loop over a specific pdg
-	      } // end pdg key loop
-
-	      // If multiplicity < minimum multiplicity, remove
-	      if( rot_event_mult < min_mult ) {
-		continue ; 
-	      }
-
-	      // Check if particle multiplicity is above signal particle multiplicity 
-	      bool is_signal_bkg = true ; 
-	      for( auto it = Topology.begin(); it!=Topology.end();++it){
-		if( it->first == conf::kPdgElectron ) continue ; 
-		if( it->second == 0 ) continue ; // If min mult is 0, continue
-		unsigned int count_p = 0 ; 
-		for( unsigned int idp = 0 ; idp < part_pdg_list.size() ; ++idp ){
-		  if( part_pdg_list[idp] == it->first ) ++count_p ;  
-		}
-		if( count_p < Topology[it->first] ) {
-		  is_signal_bkg =false ;
-		  break; 
-		}
-	      }
-
-	      if( ! is_signal_bkg ) {
-		continue ; 
-	      }
-
-	      // If multiplicity is the same as the original event multiplicity,
-	      if( rot_event_mult == m ) {
-		++N_all ; 
-		continue ; 
-	      }
-
-	      // For other case, store combination of particles which contribute
-	      // And add entry in corresponding map 
-	      std::map<std::vector<int>,std::vector<int>> new_topology ;
-	      new_topology[part_pdg_list] = part_id_list ; 
-	      probability_count[new_topology] += 1 ; 
-	 
-	    }// Close rotation loop
-
-	    // Skip if denominator is 0
-	    if( N_all == 0 ) continue ; 
-
-	    // Store event particles with correct weight and multiplicty
-	    for( auto it = probability_count.begin() ; it != probability_count.end() ; ++it ) { 
-	      for( auto it_key = it->first.begin() ; it_key != it->first.end() ; ++it_key ) { 
-		T * temp_event = new T() ; 
-		* temp_event = * event_holder[m][event_id] ;	    
-		double event_wgt = temp_event->GetEventWeight() ;
-		std::map<int,std::vector<TLorentzVector>> particles = temp_event->GetFinalParticles4Mom() ;
-		std::map<int,std::vector<TLorentzVector>> particles_uncorr = temp_event->GetFinalParticlesUnCorr4Mom() ;
-
-		std::map<int,std::vector<TLorentzVector>> temp_corr_mom ;
-		std::map<int,std::vector<TLorentzVector>> temp_uncorr_mom ;
-		int new_multiplicity = 0 ; 
-		for( unsigned int k = 0 ; k < (it_key->first).size() ; ++k ) { 
-		  int particle_pdg = (it_key->first)[k] ; 
-		  int particle_id = (it_key->second)[k] ; 
-	      
-		  temp_corr_mom[particle_pdg].push_back( particles[particle_pdg][particle_id] ) ; 
-		  temp_uncorr_mom[particle_pdg].push_back( particles_uncorr[particle_pdg][particle_id] ) ; 
-		  ++new_multiplicity ; 
-		}
-
-		temp_event->SetFinalParticlesKinematics( temp_corr_mom ) ; 
-		temp_event->SetFinalParticlesUnCorrKinematics( temp_uncorr_mom ) ; 
-
-		double probability = - (it->second) * event_wgt / N_all ; 
-		temp_event->SetEventWeight( probability ) ; 
+      unsigned int min_mult = GetMinBkgMult(); // Signal multiplicity
+      std::map<int,unsigned int> Topology = GetTopology();
+
+      CounterRNG rng( GetRandomSeed(), CounterRNG::CombineKeys( event->GetRandomKey(), m ), kRandomBkgRotation ) ; 
+
+      // Particles in the signal definition, in map order
+      std::map<int,std::vector<TLorentzVector>> particles = event->GetFinalParticles4Mom() ;
+      std::vector<int> pdgs, ids ; 
+      std::vector<TVector3> momenta ; 
+      std::map<int,unsigned long> pdg_masks ; // Bits of the particles with a given pdg
+      for( auto it = particles.begin() ; it != particles.end() ; ++it ) {
+	if( Topology.find( it->first ) == Topology.end() ) continue ; // Skip particles which are not in signal definition 
+	for ( unsigned int part_id = 0 ; part_id < (it->second).size() ; ++part_id ) {
+	  if( pdgs.size() < 64 ) pdg_masks[it->first] |= 1UL << pdgs.size() ; 
+	  pdgs.push_back( it->first ) ; 
+	  ids.push_back( part_id ) ; 
+	  momenta.push_back( (it->second)[part_id].Vect() ) ; 
+	}
+      }
+
+      // Detected particles which are compatible with the signal definition
+      auto is_signal_bkg = [&]( const unsigned long detected ) { 
+	if( (unsigned int) __builtin_popcountl( detected ) < min_mult ) return false ; 
+	for( auto it = Topology.begin(); it!=Topology.end();++it){
+	  if( it->first == conf::kPdgElectron ) continue ; 
+	  if( it->second == 0 ) continue ; // If min mult is 0, continue
+	  if( (unsigned int) __builtin_popcountl( detected & pdg_masks[it->first] ) < it->second ) return false ; 
+	}
+	return true ; 
+      } ; 
+
+      // Detected particles for each rotation around q3. The rotations are added in blocks until the estimate converges
+      std::vector<std::pair<unsigned long,double>> rotations ; 
+      std::vector<char> is_original_mult ; 
+      do { 
+	unsigned int first_rotation = rotations.size() ; 
+	if( ! GetRotatedDetection( pdgs, momenta, event->GetRecoq3(), rng, false, rotations ) ) return false ; 
+	is_original_mult.resize( rotations.size(), false ) ; 
+	for ( unsigned int rot_id = first_rotation ; rot_id < rotations.size() ; ++rot_id ) { 
+	  unsigned long detected = rotations[rot_id].first ; 
+	  is_original_mult[rot_id] = (unsigned int) __builtin_popcountl( detected ) == m && is_signal_bkg( detected ) ; 
+	}
+      } while( ! IsRotationConverged( rotations, is_original_mult ) ) ; 
+      AddRotationStats( m, rotations, is_original_mult ) ; 
+
+      // Total weight of each combination of detected particles
+      std::vector<std::pair<unsigned long,double>> mask_weights ; 
+      GetMaskWeights( rotations, pdgs.size(), mask_weights ) ; 
+
+      // Add counter for same multiplicity 
+      double N_all = 0 ; 
+      double N_total = 0 ; 
+      std::vector<std::pair<unsigned long,double>> probability_count ; // Combinations with lower multiplicity
+      for( unsigned int i = 0 ; i < mask_weights.size() ; ++i ) { 
+	unsigned long detected = mask_weights[i].first ; 
+	N_total += mask_weights[i].second ; 
+	if( ! is_signal_bkg( detected ) ) continue ; 
+	// If multiplicity is the same as the original event multiplicity,
+	if( (unsigned int) __builtin_popcountl( detected ) == m ) N_all += mask_weights[i].second ; 
+	else probability_count.push_back( mask_weights[i] ) ; 
+      }
+
+      // Skip if denominator is 0
+      if( N_all == 0 ) return false ; 
+
+      // Store event particles with correct weight and multiplicty
+      unsigned int n_new_events = 0 ; 
+      std::map<int,std::vector<TLorentzVector>> particles_uncorr = event->GetFinalParticlesUnCorr4Mom() ;
+      for( unsigned int i = 0 ; i < probability_count.size() ; ++i ) { 
+	unsigned long detected = probability_count[i].first ; 
+	T * temp_event = new T() ; 
+	* temp_event = * event ;	    
+	temp_event->SetRandomKey( CounterRNG::CombineKeys( CounterRNG::CombineKeys( event->GetRandomKey(), m ), n_new_events++ ) ) ; 
+	double event_wgt = temp_event->GetEventWeight() ;
+
+	std::map<int,std::vector<TLorentzVector>> temp_corr_mom ;
+	std::map<int,std::vector<TLorentzVector>> temp_uncorr_mom ;
+	int new_multiplicity = 0 ; 
+	for( unsigned int k = 0 ; k < pdgs.size() ; ++k ) { 
+	  if( ! ( detected & ( 1UL << k ) ) ) continue ; 
+	  temp_corr_mom[pdgs[k]].push_back( particles[pdgs[k]][ids[k]] ) ; 
+	  temp_uncorr_mom[pdgs[k]].push_back( particles_uncorr[pdgs[k]][ids[k]] ) ; 
+	  ++new_multiplicity ; 
+	}
+
+	temp_event->SetFinalParticlesKinematics( temp_corr_mom ) ; 
+	temp_event->SetFinalParticlesUnCorrKinematics( temp_uncorr_mom ) ; 
+
+	// Acceptance of the new event : rotations where all its particles are detected
+	double N_detected = 0 ; 
+	for( unsigned int j = 0 ; j < mask_weights.size() ; ++j ) { 
+	  if( ( mask_weights[j].first & detected ) == detected ) N_detected += mask_weights[j].second ; 
+	}
+	temp_event->SetRotationAcceptance( N_detected / N_total ) ; 
+
+	double probability = - probability_count[i].second * event_wgt / N_all ; 
+	temp_event->SetEventWeight( probability ) ; 
 	
-		// Store analysis record after background substraction (4) : 
-		temp_event->StoreAnalysisRecord(kid_bkgcorr+m); // Id is the bkg id (4) + original multiplicity.
-		                                                // For m = signal_multiplicity, id = 3+signal_mult
+	// Store analysis record after background substraction (4) : 
+	temp_event->StoreAnalysisRecord(kid_bkgcorr+m); // Id is the bkg id (4) + original multiplicity.
+	                                                // For m = signal_multiplicity, id = 3+signal_mult
 		
-		if ( event_holder.find(new_multiplicity) != event_holder.end() ) {
-		  event_holder[new_multiplicity].push_back( temp_event ) ; 
-		} else {
-		  std::vector<T*> temp = { temp_event } ;
-		  event_holder[new_multiplicity] = temp ; 
-		}
-	      }
-	    }
-	    delete event_holder[m][event_id];
-	  } // Close event loop 
-	}
-	--m; 
+	new_events[new_multiplicity].push_back( temp_event ) ; 
       }
 
       return true ; 
@@ -181,60 +261,24 @@ namespace e4nu {
       if( !ApplyFiducial()  ) return true ; 
       if( !GetSubtractBkg() ) return true ;
 
-      Fiducial * fiducial = GetFiducialCut() ; 
+      const Fiducial * fiducial = GetFiducialCut() ; 
       if( !fiducial ) return false ; 
       std::cout << " Applying Acceptance Correction to hadrons ... " << std::endl;
+      Tracer::Span span( "HadronsAcceptanceCorrection" ) ; 
 
       unsigned int min_mult = GetMinBkgMult(); // Signal multiplicity
-      std::map<int,unsigned int> Topology = GetTopology();
       std::vector<T*> signal_events = event_holder[min_mult] ; 
       unsigned int n_truesignal = signal_events.size() ;
 
-      for( unsigned int i = 0 ; i < n_truesignal ; ++i ) { 
+      // The events are corrected in parallel. The missing signal events are added in event order
+      std::vector<T*> corrected_events( n_truesignal, nullptr ) ; 
+      utils::ParallelFor( n_truesignal, GetNThreads(), [&]( unsigned int i ) { 
+	  corrected_events[i] = HadronsAcceptanceCorrectedEvent( signal_events[i] ) ; 
+	} ) ; 
 
-	long N_signal_detected = 0 ; 
-	long N_signal_undetected = 0 ; 
-    
-	// Start rotations
-	for ( unsigned int rot_id = 0 ; rot_id < GetNRotations() ; ++rot_id ) { 
-	  // Set rotation around q3 vector
-	  TVector3 VectorRecoQ = signal_events[i]->GetRecoq3() ;	
-	  double rotation_angle = gRandom->Uniform(0,2*TMath::Pi());
-	  
-	  std::map<int,std::vector<TLorentzVector>> rot_particles = signal_events[i]->GetFinalParticles4Mom() ;
-	  std::map<int,std::vector<TLorentzVector>> rot_particles_uncorr = signal_events[i]->GetFinalParticlesUnCorr4Mom() ;
-      
-	  // Rotate all particles 
-	  bool is_contained = true ; 
-	  for( auto it = rot_particles.begin() ; it != rot_particles.end() ; ++it ) {
-	    int part_pdg = it->first ; 
-	    if( Topology.find( part_pdg ) == Topology.end() ) continue ; // Skip particles which are not in signal definition 
-	
-	    for ( unsigned int part_id = 0 ; part_id < (it->second).size() ; ++part_id ) {
-	      TVector3 part_vect = (it->second)[part_id].Vect() ;
-	      part_vect.Rotate(rotation_angle,VectorRecoQ);
-	      
-	      // Check which particles are in fiducial	      
-	      is_contained = fiducial->FiducialCut( part_pdg, GetConfiguredEBeam(), part_vect, IsData() ) ;
-	      if( !is_contained ) break ; 
-	    }
-	    if( !is_contained ) break ; 
-	  }
-	  if( is_contained ) ++N_signal_detected ; 
-	  else ++N_signal_undetected ; 
-	}
-	if( N_signal_detected == 0 ) continue ; 
+      for( unsigned int i = 0 ; i < n_truesignal ; ++i ) { 
 	// Add missing signal events
-	T * temp_event = new T() ; 
-	* temp_event = * signal_events[i] ; 
-	
-	double event_wgt = temp_event->GetEventWeight() ;
-	temp_event->SetEventWeight( + event_wgt * N_signal_undetected / N_signal_detected ) ; 
-	signal_events.push_back(temp_event);
-	
-	// Store analysis record after acceptance correction (3) : 
-	temp_event->StoreAnalysisRecord(kid_acc);
-  
+	if( corrected_events[i] ) signal_events.push_back( corrected_events[i] ) ;
       }
       // Store correction
       event_holder[min_mult] = signal_events ; 
@@ -242,6 +286,70 @@ namespace e4nu {
       return true ; 
     }
 
+    // Acceptance correction for a single signal event
+    // It returns the missing signal event, or nullptr if the event is never detected
+    // The rotation angles are drawn from the event stream, with the rotation number as counter
+    template <class T>
+      T * HadronsAcceptanceCorrectedEvent( T * event ) { 
+      if( !ApplyFiducial()  ) return nullptr ; 
+      if( !GetSubtractBkg() ) return nullptr ;
+
+      const Fiducial * fiducial = GetFiducialCut() ; 
+      if( !fiducial ) return nullptr ; 
+
+      std::map<int,unsigned int> Topology = GetTopology();
+      CounterRNG rng( GetRandomSeed(), event->GetRandomKey(), kRandomHadronAcceptance ) ; 
+
+      double N_signal_total = 0 ; 
+      double N_signal_detected = 0 ; 
+      if( event->GetRotationAcceptance() >= 0 ) { 
+	// Events from the background subtraction have the acceptance of the parent event rotations
+	N_signal_total = 1 ; 
+	N_signal_detected = event->GetRotationAcceptance() ; 
+      } else { 
+	// Particles in the signal definition
+	std::map<int,std::vector<TLorentzVector>> particles = event->GetFinalParticles4Mom() ;
+	std::vector<int> pdgs ; 
+	std::vector<TVector3> momenta ; 
+	for( auto it = particles.begin() ; it != particles.end() ; ++it ) {
+	  if( Topology.find( it->first ) == Topology.end() ) continue ; // Skip particles which are not in signal definition 
+	  for ( unsigned int part_id = 0 ; part_id < (it->second).size() ; ++part_id ) {
+	    pdgs.push_back( it->first ) ; 
+	    momenta.push_back( (it->second)[part_id].Vect() ) ; 
+	  }
+	}
+
+	// Rotations around q3 where all particles are contained. The rotations are added in blocks until the estimate converges
+	unsigned long all_detected = pdgs.size() < 64 ? ( 1UL << pdgs.size() ) - 1 : ~0UL ; 
+	std::vector<std::pair<unsigned long,double>> rotations ; 
+	std::vector<char> is_detected ; 
+	do { 
+	  unsigned int first_rotation = rotations.size() ; 
+	  if( ! GetRotatedDetection( pdgs, momenta, event->GetRecoq3(), rng, true, rotations ) ) return nullptr ; 
+	  is_detected.resize( rotations.size(), false ) ; 
+	  for( unsigned int rot_id = first_rotation ; rot_id < rotations.size() ; ++rot_id ) { 
+	    N_signal_total += rotations[rot_id].second ; 
+	    if( rotations[rot_id].first != all_detected ) continue ; 
+	    N_signal_detected += rotations[rot_id].second ; 
+	    is_detected[rot_id] = true ; 
+	  }
+	} while( ! IsRotationConverged( rotations, is_detected ) ) ; 
+	AddRotationStats( GetMinBkgMult(), rotations, is_detected ) ;
+      }
+      double N_signal_undetected = N_signal_total - N_signal_detected ; 
+      if( N_signal_detected <= 0 ) return nullptr ; 
+
+      T * temp_event = new T() ; 
+      * temp_event = * event ; 
+	
+      double event_wgt = temp_event->GetEventWeight() ;
+      temp_event->SetEventWeight( + event_wgt * N_signal_undetected / N_signal_detected ) ; 
+	
+      // Store analysis record after acceptance correction (3) : 
+      temp_event->StoreAnalysisRecord(kid_acc);
+  
+      return temp_event ; 
+    }
 
     template <class T>
       bool ElectronAcceptanceCorrection( std::map<int,std::vector<T*>> & event_holder ) { 
@@ -249,48 +357,18 @@ namespace e4nu {
       // We need to correct for signal events that are reconstructed outside of the fiducial
       if( !ApplyFiducial()  ) return true ; 
       if( !GetSubtractBkg() ) return true ;
-
-      Fiducial * fiducial = GetFiducialCut() ; 
-      if( !fiducial ) return false ; 
+      if( !kElectronAcceptance ) return false ; 
       std::cout << " Applying Electron Acceptance Correction ... " << std::endl;
+      Tracer::Span span( "ElectronAcceptanceCorrection" ) ; 
 
       unsigned int min_mult = GetMinBkgMult(); // Signal multiplicity
-      std::map<int,unsigned int> Topology = GetTopology();
       std::vector<T*> signal_events = event_holder[min_mult] ; 
       unsigned int n_truesignal = signal_events.size() ;
 
       for( unsigned int i = 0 ; i < n_truesignal ; ++i ) { 
-
-	long N_signal_detected = 0 ; 
-	long N_signal_undetected = 0 ; 
-    
-	// Start rotations
-	for ( unsigned int rot_id = 0 ; rot_id < GetNRotations() ; ++rot_id ) { 
-	  // Set rotation around q3 vector
-	  TVector3 BeamVector (0,0,1);
-	  double rotation_angle = gRandom->Uniform(0,2*TMath::Pi());
-	  
-	  TVector3 emom = signal_events[i]->GetOutLepton4Mom().Vect() ;
-
-	  // Rotate all particles 
-	  emom.Rotate(rotation_angle, BeamVector);
-
-	  bool is_contained = fiducial->FiducialCut( conf::kPdgElectron, GetConfiguredEBeam(), emom, IsData() ) ;
-
-	  if( is_contained ) ++N_signal_detected ; 
-	  else ++N_signal_undetected ; 
-	}
-	if( N_signal_detected == 0 ) continue ; 
 	// Add missing signal events
-	T * temp_event = new T() ; 
-	* temp_event = * signal_events[i] ; 
-	
-	double event_wgt = temp_event->GetEventWeight() ;
-	temp_event->SetEventWeight( + event_wgt * N_signal_undetected / N_signal_detected ) ; 
-	signal_events.push_back(temp_event);
-	
-	// Store analysis record after acceptance correction (3) : 
-	temp_event->StoreAnalysisRecord(kid_acc);
+	T * temp_event = ElectronAcceptanceCorrectedEvent( signal_events[i] ) ; 
+	if( temp_event ) signal_events.push_back( temp_event ) ;
       }
       // Store correction
       event_holder[min_mult] = signal_events ; 
@@ -298,9 +376,80 @@ namespace e4nu {
       return true ; 
     }
 
+    // Electron acceptance correction for a single signal event
+    // It returns the missing signal event, or nullptr if the electron acceptance is below MinElectronAcceptance
+    // The accepted fraction of the electron rotations around the beam axis is read from the acceptance table
+    template <class T>
+      T * ElectronAcceptanceCorrectedEvent( T * event ) { 
+      if( !ApplyFiducial()  ) return nullptr ; 
+      if( !GetSubtractBkg() ) return nullptr ;
+      if( !kElectronAcceptance ) return nullptr ; 
+
+      double N_signal_detected = kElectronAcceptance->GetAcceptance( event->GetOutLepton4Mom().Vect() ) ; 
+      double N_signal_undetected = 1 - N_signal_detected ; 
+      // Very small acceptances give huge weights. These events are not corrected
+      if( N_signal_detected <= 0 || N_signal_detected < GetMinElectronAcceptance() ) return nullptr ; 
+
+      T * temp_event = new T() ; 
+      * temp_event = * event ; 
+	
+      double event_wgt = temp_event->GetEventWeight() ;
+      temp_event->SetEventWeight( + event_wgt * N_signal_undetected / N_signal_detected ) ; 
+	
+      // Store analysis record after acceptance correction (3) : 
+      temp_event->StoreAnalysisRecord(kid_acc);
+  
+      return temp_event ; 
+    }
+
   protected:
     virtual ~BackgroundI();
+
+    // Adds the detected particles for the next block of rotations of the momenta around axis. Each entry is ( detected particles mask, weight )
+    // Random rotations : one entry per rotation with weight 1. Analytic rotations : all the orbit segments, weight in radians
+    // If require_all is true, random rotations stop checking particles at the first undetected one
+    bool GetRotatedDetection( const std::vector<int> & pdgs, const std::vector<TVector3> & momenta, const TVector3 & axis,
+			      const CounterRNG & rng, const bool require_all, std::vector<std::pair<unsigned long,double>> & rotations ) const ;
+
+    // Adds the detection fraction of one event to the rotation statistics of multiplicity m
+    // is_detected flags the rotations which keep the event in the reference topology
+    // (original multiplicity for the background, all particles for the acceptance correction)
+    void AddRotationStats( const unsigned int m, const std::vector<std::pair<unsigned long,double>> & rotations, const std::vector<char> & is_detected ) ;
+
+    // Total weight of each combination of detected particles, in mask order
+    void GetMaskWeights( const std::vector<std::pair<unsigned long,double>> & rotations, const unsigned int n_particles,
+			 std::vector<std::pair<unsigned long,double>> & mask_weights ) const ;
+    static const unsigned int kMaxFlatMaskParticles = 16 ; // Above it, the masks are sorted instead of indexed
+
+    // Weighted fraction of detected rotations and its estimated variance
+    void GetDetectionFraction( const std::vector<std::pair<unsigned long,double>> & rotations, const std::vector<char> & is_detected,
+			       double & fraction, double & variance ) const ;
+
+    // True if the maximum number of rotations is reached or if the relative uncertainty of the detected fraction is below RotationPrecision
+    bool IsRotationConverged( const std::vector<std::pair<unsigned long,double>> & rotations, const std::vector<char> & is_detected ) const ;
+
+    // Number of rotations added at once. It is NRotations unless RotationPrecision is set
+    unsigned int GetRotationBlockSize(void) const ;
+    static const unsigned int kRotationBlock = 20 ;
+
+    // Maximum number of rotations per event. With RotationPrecision, NRotations is rounded down to a multiple of the block size
+    unsigned int GetMaxRotations(void) const ;
+
     Subtraction * kRotation = nullptr ;
+    OrbitAcceptance * kOrbitAcceptance = nullptr ;
+    ElectronAcceptanceTable * kElectronAcceptance = nullptr ;
+
+  private:
+    // Sums over the events of the detection fraction p, its estimated variance and p(1-p), the variance of a single uniform rotation
+    struct RotationStats {
+      unsigned long n_events = 0 ;
+      unsigned long n_rotations = 0 ;
+      double sum_fraction = 0 ;
+      double sum_variance = 0 ;
+      double sum_binomial = 0 ;
+    } ;
+    std::map<unsigned int,RotationStats> kRotationStats ; 
+    mutable std::mutex kRotationStatsMutex ; 
 
   };
 }
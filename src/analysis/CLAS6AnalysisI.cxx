@@ -53,7 +53,9 @@ EventI * CLAS6AnalysisI::GetEvent( const unsigned int event_id ) {
 
 EventI * CLAS6AnalysisI::GetValidEvent( const unsigned int event_id ) {
 
+  CutFlow::Timer read_timer( kCutFlow, kStageRead ) ; 
   CLAS6Event * event = (CLAS6Event*) fData -> GetEvent(event_id) ; 
+  read_timer.Stop() ; 
   if( !event ) {
     delete event ; 
     return nullptr ; 
@@ -88,17 +90,7 @@ bool CLAS6AnalysisI::Finalise( std::map<int,std::vector<e4nu::EventI*>> & event_
   // Store corrected background in event sample
   unsigned int min_mult = GetMinBkgMult() ; 
   for( unsigned int k = 0 ; k < event_holder[min_mult].size() ; ++k ) {
-    StoreTree( static_cast<CLAS6Event*>( event_holder[min_mult][k] ) );
-
-    double norm_weight = 1 ; 
-    if( ApplyCorrWeights() ) { 
-      norm_weight = event_holder[min_mult][k]->GetTotalWeight() ;
-    }
-
-    // Store in histogram(s)
-    for( unsigned int j = 0 ; j < kHistograms.size() ; ++j ) {
-      kHistograms[j]-> Fill( event_holder[min_mult][k]->GetObservable( GetObservablesTag()[j] ), norm_weight ) ; 
-    }
+    StoreEvent( event_holder[min_mult][k] ) ; 
   }
 
   // Normalize
@@ -112,6 +104,8 @@ bool CLAS6AnalysisI::Finalise( std::map<int,std::vector<e4nu::EventI*>> & event_
   double TargetDensity = conf::GetTargetDensity( tgt_pdg ) ;
 
   if ( NormalizeHist() ) {
+    // Prescaled runs only use a fraction of the integrated charge
+    double prescale_fraction = GetNEventsToRun() > 0 ? (double) GetNPrescaledEvents() / GetNEventsToRun() : 1 ; 
     for( unsigned int j = 0 ; j < kHistograms.size() ; ++j ) {
       double NBins = kHistograms[j]->GetNbinsX(); 
     
@@ -124,49 +118,67 @@ bool CLAS6AnalysisI::Finalise( std::map<int,std::vector<e4nu::EventI*>> & event_
 	kHistograms[j]->SetBinContent(k,newcontent);
 	kHistograms[j]->SetBinError(k,newerror);
       }
-      kHistograms[j]->Scale(  kConversionFactorCm2ToMicroBarn * MassNumber / ( IntegratedCharge * TargetLength * TargetDensity * kOverallUnitConversionFactor ) ) ;
+      kHistograms[j]->Scale(  kConversionFactorCm2ToMicroBarn * MassNumber / ( prescale_fraction * IntegratedCharge * TargetLength * TargetDensity * kOverallUnitConversionFactor ) ) ;
     }
   }
 
   return true ; 
 }
 
+bool CLAS6AnalysisI::StoreEvent( EventI * event ) {
+  // Store signal event in tree and histogram(s)
+  StoreTree( static_cast<CLAS6Event*>( event ) );
+
+  double norm_weight = 1 ; 
+  if( ApplyCorrWeights() ) { 
+    norm_weight = event->GetTotalWeight() ;
+  }
+
+  std::vector<double> observables ; 
+  event->GetObservables( GetObservablesID(), observables ) ; 
+  for( unsigned int j = 0 ; j < observables.size() ; ++j ) {
+    kHistograms[j]-> Fill( observables[j], norm_weight ) ; 
+  }
+
+  return true ; 
+}
+
 bool CLAS6AnalysisI::StoreTree(CLAS6Event * event){
-  static bool n = true ; 
-  int ID = event->GetEventID() ; 
-  int TargetPdg = event->GetTargetPdg() ;
-  int InLeptonPdg = event->GetInLeptPdg() ; 
-  int OutLeptonPdg = event->GetOutLeptPdg() ; 
-  double TotWeight = event->GetTotalWeight() ; 
-  double EventWght = event->GetEventWeight() ; 
-  double BeamE = event->GetInLepton4Mom().E() ; 
-
-  unsigned int RecoNProtons = event->GetRecoNProtons() ; 
-  unsigned int RecoNNeutrons = event->GetRecoNNeutrons();
-  unsigned int RecoNPiP = event->GetRecoNPiP();
-  unsigned int RecoNPiM = event->GetRecoNPiM();
-  unsigned int RecoNPi0 = event->GetRecoNPi0();
-  unsigned int RecoNKP = event->GetRecoNKP();
-  unsigned int RecoNKM = event->GetRecoNKM(); 
-  unsigned int RecoNK0 = event->GetRecoNK0();
-  unsigned int RecoNEM = event->GetRecoNEM();
+  TreeRecord & t = kTreeRecord ; 
+  t.ID = event->GetEventID() ; 
+  t.TargetPdg = event->GetTargetPdg() ;
+  t.InLeptonPdg = event->GetInLeptPdg() ; 
+  t.OutLeptonPdg = event->GetOutLeptPdg() ; 
+  t.TotWeight = event->GetTotalWeight() ; 
+  t.EventWght = event->GetEventWeight() ; 
+  t.BeamE = event->GetInLepton4Mom().E() ; 
+
+  t.RecoNProtons = event->GetRecoNProtons() ; 
+  t.RecoNNeutrons = event->GetRecoNNeutrons();
+  t.RecoNPiP = event->GetRecoNPiP();
+  t.RecoNPiM = event->GetRecoNPiM();
+  t.RecoNPi0 = event->GetRecoNPi0();
+  t.RecoNKP = event->GetRecoNKP();
+  t.RecoNKM = event->GetRecoNKM(); 
+  t.RecoNK0 = event->GetRecoNK0();
+  t.RecoNEM = event->GetRecoNEM();
 
   TLorentzVector out_mom = event->GetOutLepton4Mom();
-  double Efl = out_mom.E();
-  double pfl = out_mom.P();
-  double pflx = out_mom.Px();
-  double pfly = out_mom.Py();
-  double pflz = out_mom.Pz();
-  double pfl_theta = out_mom.Theta();
-  double pfl_phi = out_mom.Phi() ;
-  unsigned int ElectronSector = utils::GetSector( pfl_phi ) ; 
-
-  double RecoQELEnu = utils::GetQELRecoEnu( out_mom, TargetPdg ) ; 
-  double RecoEnergyTransfer = utils::GetEnergyTransfer( out_mom, TargetPdg ) ; 
-  double Recoq3 = utils::GetRecoq3( out_mom, BeamE ).Mag() ; 
-  double RecoQ2 = utils::GetRecoQ2( out_mom, BeamE ) ; 
-  double RecoXBJK = utils::GetRecoXBJK( out_mom, BeamE ) ; 
-  double RecoW = utils::GetRecoW(out_mom, BeamE ) ;
+  t.Efl = out_mom.E();
+  t.pfl = out_mom.P();
+  t.pflx = out_mom.Px();
+  t.pfly = out_mom.Py();
+  t.pflz = out_mom.Pz();
+  t.pfl_theta = out_mom.Theta();
+  t.pfl_phi = out_mom.Phi() ;
+  t.ElectronSector = utils::GetSector( t.pfl_phi ) ; 
+
+  t.RecoQELEnu = utils::GetQELRecoEnu( out_mom, t.TargetPdg ) ; 
+  t.RecoEnergyTransfer = utils::GetEnergyTransfer( out_mom, t.TargetPdg ) ; 
+  t.Recoq3 = utils::GetRecoq3( out_mom, t.BeamE ).Mag() ; 
+  t.RecoQ2 = utils::GetRecoQ2( out_mom, t.BeamE ) ; 
+  t.RecoXBJK = utils::GetRecoXBJK( out_mom, t.BeamE ) ; 
+  t.RecoW = utils::GetRecoW(out_mom, t.BeamE ) ;
 
   std::map<int,unsigned int> topology = GetTopology() ;
   static bool topology_has_protons = false ; 
@@ -183,7 +195,7 @@ bool CLAS6AnalysisI::StoreTree(CLAS6Event * event){
     if( topology[conf::kPdgPiM] != 0 ) topology_has_pim = true ; 
   }
 
-  unsigned int TopMult = GetNTopologyParticles();
+  t.TopMult = GetNTopologyParticles();
   std::map<int,std::vector<TLorentzVector>> hadron_map = event->GetFinalParticles4Mom();
   TLorentzVector p_max(0,0,0,0) ;
   if( topology_has_protons ) {
@@ -195,16 +207,16 @@ bool CLAS6AnalysisI::StoreTree(CLAS6Event * event){
       }
     }
   }
-  double proton_mom = p_max.P() ; 
-  double proton_momx = p_max.Px() ; 
-  double proton_momy = p_max.Py() ; 
-  double proton_momz = p_max.Pz() ; 
-  double proton_theta = p_max.Theta() ; 
-  double proton_phi = p_max.Phi(); 
-  double ECal = utils::GetECal( out_mom.E(), event->GetFinalParticles4Mom(), TargetPdg ) ; 
-  double AlphaT = utils::DeltaAlphaT( out_mom.Vect(), p_max.Vect() ) ; 
-  double DeltaPT = utils::DeltaPT( out_mom.Vect(), p_max.Vect() ).Mag() ; 
-  double DeltaPhiT = utils::DeltaPhiT( out_mom.Vect(), p_max.Vect() ) ; 
+  t.proton_mom = p_max.P() ; 
+  t.proton_momx = p_max.Px() ; 
+  t.proton_momy = p_max.Py() ; 
+  t.proton_momz = p_max.Pz() ; 
+  t.proton_theta = p_max.Theta() ; 
+  t.proton_phi = p_max.Phi(); 
+  t.ECal = utils::GetECal( out_mom.E(), event->GetFinalParticles4Mom(), t.TargetPdg ) ; 
+  t.AlphaT = utils::DeltaAlphaT( out_mom.Vect(), p_max.Vect() ) ; 
+  t.DeltaPT = utils::DeltaPT( out_mom.Vect(), p_max.Vect() ).Mag() ; 
+  t.DeltaPhiT = utils::DeltaPhiT( out_mom.Vect(), p_max.Vect() ) ; 
 
   TLorentzVector pip_max(0,0,0,0) ;
   if( topology_has_pip ) {
@@ -216,12 +228,12 @@ bool CLAS6AnalysisI::StoreTree(CLAS6Event * event){
       }
     }
   }
-  double pip_mom = pip_max.P() ;
-  double pip_momx = pip_max.Px() ;
-  double pip_momy = pip_max.Py() ;
-  double pip_momz = pip_max.Pz() ;
-  double pip_theta = pip_max.Theta() ;
-  double pip_phi = pip_max.Phi();
+  t.pip_mom = pip_max.P() ;
+  t.pip_momx = pip_max.Px() ;
+  t.pip_momy = pip_max.Py() ;
+  t.pip_momz = pip_max.Pz() ;
+  t.pip_theta = pip_max.Theta() ;
+  t.pip_phi = pip_max.Phi();
 
   TLorentzVector pim_max(0,0,0,0) ;
   if( topology_has_pim ) {
@@ -234,79 +246,79 @@ bool CLAS6AnalysisI::StoreTree(CLAS6Event * event){
     }
   }
 
-  double pim_mom = pim_max.P() ;
-  double pim_momx = pim_max.Px() ;
-  double pim_momy = pim_max.Py() ;
-  double pim_momz = pim_max.Pz() ;
-  double pim_theta = pim_max.Theta() ;
-  double pim_phi = pim_max.Phi() ;
-
-  bool IsBkg = event->IsBkg() ; 
-  if( n == true ) {
-    kAnalysisTree -> Branch( "ID", &ID, "ID/I"); 
-    kAnalysisTree -> Branch( "TargetPdg", &TargetPdg, "TargetPdg/I");
-    kAnalysisTree -> Branch( "InLeptonPdg", &InLeptonPdg, "InLeptonPdg/I");
-    kAnalysisTree -> Branch( "OutLeptonPdg", &OutLeptonPdg, "OutLeptonPdg/I");
-    kAnalysisTree -> Branch( "BeamE", &BeamE, "BeamE/D");
-    kAnalysisTree -> Branch( "TotWeight", &TotWeight, "TotWeight/D");
-    kAnalysisTree -> Branch( "EventWght", &EventWght, "EventWght/D");
-    kAnalysisTree -> Branch( "IsBkg", &IsBkg, "IsBkg/O");
-    kAnalysisTree -> Branch( "RecoNProtons", &RecoNProtons, "RecoNProtons/I");
-    kAnalysisTree -> Branch( "RecoNNeutrons", &RecoNNeutrons, "RecoNNeutrons/I");
-    kAnalysisTree -> Branch( "RecoNPiP", &RecoNPiP, "RecoNPiP/I");
-    kAnalysisTree -> Branch( "RecoNPiM", &RecoNPiM, "RecoNPiM/I");
-    kAnalysisTree -> Branch( "RecoNPi0", &RecoNPi0, "RecoNPi0/I");
-    kAnalysisTree -> Branch( "RecoNKP", &RecoNKP, "RecoNKP/I");
-    kAnalysisTree -> Branch( "RecoNKM", &RecoNKM, "RecoNKM/I");
-    kAnalysisTree -> Branch( "RecoNK0", &RecoNK0, "RecoNK0/I");
-    kAnalysisTree -> Branch( "RecoNEM", &RecoNEM, "RecoNEM/I");
-    kAnalysisTree -> Branch( "TopMult", &TopMult, "TopMult/I");
-    kAnalysisTree -> Branch( "Efl", &Efl, "Efl/D");
-    kAnalysisTree -> Branch( "pfl", &pfl, "pfl/D");
-    kAnalysisTree -> Branch( "pflx", &pflx, "pflx/D");
-    kAnalysisTree -> Branch( "pfly", &pfly, "pfly/D");
-    kAnalysisTree -> Branch( "pflz", &pflz, "pflz/D");
-    kAnalysisTree -> Branch( "pfl_theta", &pfl_theta, "pfl_theta/D");
-    kAnalysisTree -> Branch( "pfl_phi", &pfl_phi, "pfl_phi/D");
-    kAnalysisTree -> Branch( "RecoQELEnu", &RecoQELEnu, "RecoQELEnu/D");
-    kAnalysisTree -> Branch( "RecoEnergyTransfer", &RecoEnergyTransfer, "RecoEnergyTransfer/D");
-    kAnalysisTree -> Branch( "Recoq3", &Recoq3, "Recoq3/D");
-    kAnalysisTree -> Branch( "RecoQ2", &RecoQ2, "RecoQ2/D");
-    kAnalysisTree -> Branch( "RecoW", &RecoW, "RecoW/D");
-    kAnalysisTree -> Branch( "RecoXBJK", &RecoXBJK, "RecoXBJK/D");
-    kAnalysisTree -> Branch( "ElectronSector", &ElectronSector, "ElectronSector/I");
+  t.pim_mom = pim_max.P() ;
+  t.pim_momx = pim_max.Px() ;
+  t.pim_momy = pim_max.Py() ;
+  t.pim_momz = pim_max.Pz() ;
+  t.pim_theta = pim_max.Theta() ;
+  t.pim_phi = pim_max.Phi() ;
+
+  t.IsBkg = event->IsBkg() ; 
+  if( ! kTreeIsBooked ) {
+    kAnalysisTree -> Branch( "ID", &t.ID, "ID/I"); 
+    kAnalysisTree -> Branch( "TargetPdg", &t.TargetPdg, "TargetPdg/I");
+    kAnalysisTree -> Branch( "InLeptonPdg", &t.InLeptonPdg, "InLeptonPdg/I");
+    kAnalysisTree -> Branch( "OutLeptonPdg", &t.OutLeptonPdg, "OutLeptonPdg/I");
+    kAnalysisTree -> Branch( "BeamE", &t.BeamE, "BeamE/D");
+    kAnalysisTree -> Branch( "TotWeight", &t.TotWeight, "TotWeight/D");
+    kAnalysisTree -> Branch( "EventWght", &t.EventWght, "EventWght/D");
+    kAnalysisTree -> Branch( "IsBkg", &t.IsBkg, "IsBkg/O");
+    kAnalysisTree -> Branch( "RecoNProtons", &t.RecoNProtons, "RecoNProtons/I");
+    kAnalysisTree -> Branch( "RecoNNeutrons", &t.RecoNNeutrons, "RecoNNeutrons/I");
+    kAnalysisTree -> Branch( "RecoNPiP", &t.RecoNPiP, "RecoNPiP/I");
+    kAnalysisTree -> Branch( "RecoNPiM", &t.RecoNPiM, "RecoNPiM/I");
+    kAnalysisTree -> Branch( "RecoNPi0", &t.RecoNPi0, "RecoNPi0/I");
+    kAnalysisTree -> Branch( "RecoNKP", &t.RecoNKP, "RecoNKP/I");
+    kAnalysisTree -> Branch( "RecoNKM", &t.RecoNKM, "RecoNKM/I");
+    kAnalysisTree -> Branch( "RecoNK0", &t.RecoNK0, "RecoNK0/I");
+    kAnalysisTree -> Branch( "RecoNEM", &t.RecoNEM, "RecoNEM/I");
+    kAnalysisTree -> Branch( "TopMult", &t.TopMult, "TopMult/I");
+    kAnalysisTree -> Branch( "Efl", &t.Efl, "Efl/D");
+    kAnalysisTree -> Branch( "pfl", &t.pfl, "pfl/D");
+    kAnalysisTree -> Branch( "pflx", &t.pflx, "pflx/D");
+    kAnalysisTree -> Branch( "pfly", &t.pfly, "pfly/D");
+    kAnalysisTree -> Branch( "pflz", &t.pflz, "pflz/D");
+    kAnalysisTree -> Branch( "pfl_theta", &t.pfl_theta, "pfl_theta/D");
+    kAnalysisTree -> Branch( "pfl_phi", &t.pfl_phi, "pfl_phi/D");
+    kAnalysisTree -> Branch( "RecoQELEnu", &t.RecoQELEnu, "RecoQELEnu/D");
+    kAnalysisTree -> Branch( "RecoEnergyTransfer", &t.RecoEnergyTransfer, "RecoEnergyTransfer/D");
+    kAnalysisTree -> Branch( "Recoq3", &t.Recoq3, "Recoq3/D");
+    kAnalysisTree -> Branch( "RecoQ2", &t.RecoQ2, "RecoQ2/D");
+    kAnalysisTree -> Branch( "RecoW", &t.RecoW, "RecoW/D");
+    kAnalysisTree -> Branch( "RecoXBJK", &t.RecoXBJK, "RecoXBJK/D");
+    kAnalysisTree -> Branch( "ElectronSector", &t.ElectronSector, "ElectronSector/I");
     if( topology_has_protons ) {
-      kAnalysisTree -> Branch( "proton_mom", &proton_mom, "proton_mom/D");
-      kAnalysisTree -> Branch( "proton_momx", &proton_momx, "proton_momx/D");
-      kAnalysisTree -> Branch( "proton_momy", &proton_momy, "proton_momy/D");
-      kAnalysisTree -> Branch( "proton_momz", &proton_momz, "proton_momz/D");
-      kAnalysisTree -> Branch( "proton_theta", &proton_theta, "proton_theta/D");
-      kAnalysisTree -> Branch( "proton_phi", &proton_phi, "proton_phi/D");
-      kAnalysisTree -> Branch( "ECal", &ECal, "ECal/D");
-      kAnalysisTree -> Branch( "AlphaT", &AlphaT, "AlphaT/D");
-      kAnalysisTree -> Branch( "DeltaPT", &DeltaPT, "DeltaPT/D");
-      kAnalysisTree -> Branch( "DeltaPhiT", &DeltaPhiT, "DeltaPhiT/D");
+      kAnalysisTree -> Branch( "proton_mom", &t.proton_mom, "proton_mom/D");
+      kAnalysisTree -> Branch( "proton_momx", &t.proton_momx, "proton_momx/D");
+      kAnalysisTree -> Branch( "proton_momy", &t.proton_momy, "proton_momy/D");
+      kAnalysisTree -> Branch( "proton_momz", &t.proton_momz, "proton_momz/D");
+      kAnalysisTree -> Branch( "proton_theta", &t.proton_theta, "proton_theta/D");
+      kAnalysisTree -> Branch( "proton_phi", &t.proton_phi, "proton_phi/D");
+      kAnalysisTree -> Branch( "ECal", &t.ECal, "ECal/D");
+      kAnalysisTree -> Branch( "AlphaT", &t.AlphaT, "AlphaT/D");
+      kAnalysisTree -> Branch( "DeltaPT", &t.DeltaPT, "DeltaPT/D");
+      kAnalysisTree -> Branch( "DeltaPhiT", &t.DeltaPhiT, "DeltaPhiT/D");
     }
 
     if( topology_has_pip ) {
-      kAnalysisTree -> Branch( "pip_mom", &pip_mom, "pip_mom/D");
-      kAnalysisTree -> Branch( "pip_momx", &pip_momx, "pip_momx/D");
-      kAnalysisTree -> Branch( "pip_momy", &pip_momy, "pip_momy/D");
-      kAnalysisTree -> Branch( "pip_momz", &pip_momz, "pip_momz/D");
-      kAnalysisTree -> Branch( "pip_theta", &pip_theta, "pip_theta/D");
-      kAnalysisTree -> Branch( "pip_phi", &pip_phi, "pip_phi/D");
+      kAnalysisTree -> Branch( "pip_mom", &t.pip_mom, "pip_mom/D");
+      kAnalysisTree -> Branch( "pip_momx", &t.pip_momx, "pip_momx/D");
+      kAnalysisTree -> Branch( "pip_momy", &t.pip_momy, "pip_momy/D");
+      kAnalysisTree -> Branch( "pip_momz", &t.pip_momz, "pip_momz/D");
+      kAnalysisTree -> Branch( "pip_theta", &t.pip_theta, "pip_theta/D");
+      kAnalysisTree -> Branch( "pip_phi", &t.pip_phi, "pip_phi/D");
     }
 
     if( topology_has_pim ) {
-      kAnalysisTree -> Branch( "pim_mom", &pim_mom, "pim_mom/D");
-      kAnalysisTree -> Branch( "pim_momx", &pim_momx, "pim_momx/D");
-      kAnalysisTree -> Branch( "pim_momy", &pim_momy, "pim_momy/D");
-      kAnalysisTree -> Branch( "pim_momz", &pim_momz, "pim_momz/D");
-      kAnalysisTree -> Branch( "pim_theta", &pim_theta, "pim_theta/D");
-      kAnalysisTree -> Branch( "pim_phi", &pim_phi, "pim_phi/D");
+      kAnalysisTree -> Branch( "pim_mom", &t.pim_mom, "pim_mom/D");
+      kAnalysisTree -> Branch( "pim_momx", &t.pim_momx, "pim_momx/D");
+      kAnalysisTree -> Branch( "pim_momy", &t.pim_momy, "pim_momy/D");
+      kAnalysisTree -> Branch( "pim_momz", &t.pim_momz, "pim_momz/D");
+      kAnalysisTree -> Branch( "pim_theta", &t.pim_theta, "pim_theta/D");
+      kAnalysisTree -> Branch( "pim_phi", &t.pim_phi, "pim_phi/D");
     }
 
-    n = false ; 
+    kTreeIsBooked = true ; 
   }
   
   kAnalysisTree -> Fill();
@@ -26,10 +26,71 @@ namespace e4nu {
     EventI * GetValidEvent( const unsigned int event_id ) ;
     e4nu::EventI * GetEvent( const unsigned int event_id ) ;
     bool Finalise( std::map<int,std::vector<e4nu::EventI*>> & event_holder ) ; 
+    bool StoreEvent( EventI * event ) ;
     bool StoreTree(CLAS6Event * event);
 
   private :
 
+    // Branch buffers of the analysis tree. They are members, so the branch addresses stay valid for every StoreTree call
+    struct TreeRecord {
+      int ID = 0 ;
+      int TargetPdg = 0 ;
+      int InLeptonPdg = 0 ;
+      int OutLeptonPdg = 0 ;
+      double TotWeight = 0 ;
+      double EventWght = 0 ;
+      double BeamE = 0 ;
+      unsigned int RecoNProtons = 0 ;
+      unsigned int RecoNNeutrons = 0 ;
+      unsigned int RecoNPiP = 0 ;
+      unsigned int RecoNPiM = 0 ;
+      unsigned int RecoNPi0 = 0 ;
+      unsigned int RecoNKP = 0 ;
+      unsigned int RecoNKM = 0 ;
+      unsigned int RecoNK0 = 0 ;
+      unsigned int RecoNEM = 0 ;
+      double Efl = 0 ;
+      double pfl = 0 ;
+      double pflx = 0 ;
+      double pfly = 0 ;
+      double pflz = 0 ;
+      double pfl_theta = 0 ;
+      double pfl_phi = 0 ;
+      unsigned int ElectronSector = 0 ;
+      double RecoQELEnu = 0 ;
+      double RecoEnergyTransfer = 0 ;
+      double Recoq3 = 0 ;
+      double RecoQ2 = 0 ;
+      double RecoXBJK = 0 ;
+      double RecoW = 0 ;
+      unsigned int TopMult = 0 ;
+      double proton_mom = 0 ;
+      double proton_momx = 0 ;
+      double proton_momy = 0 ;
+      double proton_momz = 0 ;
+      double proton_theta = 0 ;
+      double proton_phi = 0 ;
+      double ECal = 0 ;
+      double AlphaT = 0 ;
+      double DeltaPT = 0 ;
+      double DeltaPhiT = 0 ;
+      double pip_mom = 0 ;
+      double pip_momx = 0 ;
+      double pip_momy = 0 ;
+      double pip_momz = 0 ;
+      double pip_theta = 0 ;
+      double pip_phi = 0 ;
+      double pim_mom = 0 ;
+      double pim_momx = 0 ;
+      double pim_momy = 0 ;
+      double pim_momz = 0 ;
+      double pim_theta = 0 ;
+      double pim_phi = 0 ;
+      bool IsBkg = false ;
+    } ;
+    TreeRecord kTreeRecord ;
+    bool kTreeIsBooked = false ; // Branches are created at the first StoreTree call
+
     CLAS6EventHolder * fData = nullptr ; 
 
     // Store Statistics after cuts
@@ -11,9 +11,12 @@
 #include "conf/AnalysisConstantsI.h"
 #include "conf/AccpetanceMapsI.h"
 #include "conf/AnalysisCutsI.h"
+#include "conf/ObservablesI.h"
 #include "utils/KinematicUtils.h"
 #include "utils/ParticleUtils.h"
 #include "utils/Utils.h"
+#include "utils/ParallelUtils.h"
+#include "TROOT.h"
 
 using namespace e4nu; 
 
@@ -33,6 +36,7 @@ ConfigureI::ConfigureI( const double EBeam, const unsigned int TargetPdg ) {
 ConfigureI::~ConfigureI() {
   kTopology_map.clear() ; 
   kObservables.clear();
+  kObservablesID.clear();
   kNBins.clear();
   kRanges.clear();
   delete kFiducialCut ;
@@ -69,6 +73,13 @@ ConfigureI::ConfigureI( const std::string input_file ) {
     } else if ( param[i] == "ApplyHadFiducial" ){
       if( value[i] == "false" ) kApplyHadFiducial = false ; 
       else kApplyHadFiducial = true ; 
+    } else if ( param[i] == "FiducialGrid" ){
+      if( value[i] == "true" ) kFiducialGrid = true ; 
+      else kFiducialGrid = false ; 
+    } else if ( param[i] == "FiducialGridCache" ){
+      kFiducialGridCache = value[i] ;
+    } else if ( param[i] == "FiducialGridCheck" ){
+      kFiducialGridCheck = (unsigned int) std::stoi( value[i] ) ;
     } else if ( param[i] == "ApplyAccWeights" ){
       if ( value[i] == "false" ) kApplyAccWeights = false ; 
       else kApplyAccWeights = true ; 
@@ -123,10 +134,20 @@ ConfigureI::ConfigureI( const std::string input_file ) {
     else if ( param[i] == "NoFSI") {
       if( value[i] == "true" ) kNoFSI = true ; 
       else kNoFSI = false ; 
+    } else if ( param[i] == "CutWarmUpEvents" ) { kNCutWarmUpEvents = (unsigned int) std::stoi( value[i] ) ;
+    } else if ( param[i] == "Trace" ) { 
+      if( value[i] == "true" ) kTrace = true ; 
+      else kTrace = false ; 
+    } else if ( param[i] == "TraceSampling" ) { kTraceSampling = (unsigned int) std::stoi( value[i] ) ;
+    } else if ( param[i] == "ProgressInterval" ) { kProgressInterval = (unsigned int) std::stoi( value[i] ) ;
+    } else if ( param[i] == "StatsInterval" ) { kStatsInterval = std::stod( value[i] ) ;
+    } else if ( param[i] == "CheckpointInterval" ) { kCheckpointInterval = (unsigned int) std::stoi( value[i] ) ;
+    } else if ( param[i] == "MemoryBudget" ) { kMemoryBudget = std::stod( value[i] ) ;
     } else if ( param[i] == "EBeam" ) kEBeam = std::stod( value[i] ) ; 
     else if ( param[i] == "TargetPdg" ) kTargetPdg = (unsigned int) std::stoi( value[i] ) ; 
     else if ( param[i] == "NEvents" ) kNEvents = (unsigned int) std::stoi( value[i] ) ;
     else if ( param[i] == "FirstEvent" ) kFirstEvent = (unsigned int) std::stoi( value[i] ) ;
+    else if ( param[i] == "Prescale" ) kPrescale = (unsigned int) std::stoi( value[i] ) ;
     else if ( param[i] == "Toplogy") {
       std::string element, m_element ;
       std::istringstream particle_list( value[i] ) ;
@@ -146,6 +167,22 @@ ConfigureI::ConfigureI( const std::string input_file ) {
       else kSubtractBkg = false ; 
     } else if ( param[i] == "MaxBackgroundMultiplicity" ) { kMaxBkgMult = (unsigned int) std::stoi( value[i] ) ;
     } else if ( param[i] == "NRotations" ) { kNRotations = (unsigned int) std::stoi( value[i] ) ;
+    } else if ( param[i] == "RotationPrecision" ) { kRotationPrecision = std::stod( value[i] ) ;
+    } else if ( param[i] == "RotationMethod" ) { 
+      if( value[i] == "Analytic" ) kRotationMethod = kAnalyticRotations ; 
+      else if( value[i] == "Random" ) kRotationMethod = kRandomRotations ; 
+      else if( value[i] == "Stratified" ) kRotationMethod = kStratifiedRotations ; 
+      else if( value[i] == "Lattice" ) kRotationMethod = kLatticeRotations ; 
+      else std::cout << " WARN : Unknown RotationMethod " << value[i] << ". Using random rotations" << std::endl;
+    } else if ( param[i] == "NThreads" ) { kNThreads = (unsigned int) std::stoi( value[i] ) ;
+    } else if ( param[i] == "RandomSeed" ) { kRandomSeed = (unsigned int) std::stoul( value[i] ) ;
+    } else if ( param[i] == "StreamBkgSubtraction" ) { 
+      if( value[i] == "true" ) kStreamBkg = true ; 
+      else kStreamBkg = false ; 
+    } else if ( param[i] == "ElectronAcceptanceCorrection" ) { 
+      if( value[i] == "true" ) kElectronAccCorrection = true ; 
+      else kElectronAccCorrection = false ; 
+    } else if ( param[i] == "MinElectronAcceptance" ) { kMinElectronAcceptance = std::stod( value[i] ) ;
     } else if ( param[i] == "ObservableList" ) {
       std::string obs ; 
       std::istringstream obs_list( value[i] ) ; 
@@ -200,6 +237,15 @@ ConfigureI::ConfigureI( const std::string input_file ) {
     kIsConfigured = false ; 
   }
 
+  for( unsigned int i = 0 ; i < kObservables.size() ; ++i ) { 
+    unsigned int id = conf::GetObservableID( kObservables[i] ) ; 
+    if( id == conf::kNObservables ) { 
+      std::cout << " ERROR : Observable " << kObservables[i] << " is not defined " << std::endl;
+      kIsConfigured = false ; 
+    }
+    kObservablesID.push_back( id ) ; 
+  }
+
   if( kInputFile == "" ) {
     std::cout << " ERROR : Input file not specified " << std::endl;
     kIsConfigured = false ; 
@@ -213,6 +259,21 @@ ConfigureI::ConfigureI( const std::string input_file ) {
     kIsConfigured = false ; 
   }
   
+  if( kStreamBkg && ( !kSubtractBkg || !kApplyFiducial ) ) {
+    std::cout << " WARN : StreamBkgSubtraction requires SubtractBkg and ApplyFiducial. Disabling streaming... " << std::endl;
+    kStreamBkg = false ;
+  }
+
+  if( kStreamBkg && kCheckpointInterval > 0 ) {
+    std::cout << " WARN : Checkpoints are not available with StreamBkgSubtraction. Disabling checkpoints... " << std::endl;
+    kCheckpointInterval = 0 ;
+  }
+
+  if( kMemoryBudget > 0 && kCheckpointInterval > 0 ) {
+    std::cout << " WARN : Checkpoints are not available with MemoryBudget. Disabling checkpoints... " << std::endl;
+    kCheckpointInterval = 0 ;
+  }
+
   if( !kIsCLAS6Analysis && !kIsCLAS6Analysis ) {
     std::cout << " WARN : Analysis type not configured. Using CLAS6... " << std::endl;
     kIsCLAS6Analysis = true ;
@@ -229,10 +290,14 @@ ConfigureI::ConfigureI( const std::string input_file ) {
 void ConfigureI::Initialize(void){
 
   gRandom = new TRandom3() ; 
-  gRandom->SetSeed(10);
+  gRandom->SetSeed(kRandomSeed);
+
+  kNThreads = utils::GetNThreads( kNThreads ) ; 
+  if( kNThreads > 1 ) ROOT::EnableThreadSafety() ; 
 
   if( ApplyFiducial() &&  kIsConfigured ) kIsConfigured = InitializeFiducial() ; 
 
+
   if( kIsConfigured ) PrintConfiguration() ;
   else std::cout << " CONFIGURATION FAILED..." << std::endl;
 
@@ -249,6 +314,12 @@ void ConfigureI::PrintConfiguration(void) const {
   std::cout << "ApplyFiducial:" << kApplyFiducial << std::endl;
   std::cout << "ApplyEFiducial:" << kApplyEFiducial << std::endl;
   std::cout << "ApplyHadFiducial:" << kApplyHadFiducial << std::endl;
+  if( kFiducialGrid ) { 
+    std::cout << "FiducialGrid: 1" ; 
+    if( kFiducialGridCache.size() ) std::cout << ", cached in " << kFiducialGridCache ; 
+    if( kFiducialGridCheck ) std::cout << ", checked on " << kFiducialGridCheck << "^3 points" ; 
+    std::cout << std::endl;
+  }
   std::cout << "ApplyAccWeights: " << kApplyAccWeights << std::endl;
   std::cout << "ApplyMottWeight: " << kApplyMottWeight << std::endl;
   std::cout << "ApplyReso:" << kApplyReso << std::endl;
@@ -258,7 +329,8 @@ void ConfigureI::PrintConfiguration(void) const {
   std::cout << "ApplyPhiOpeningAngle:" << kApplyPhiOpeningAngle << std::endl;
   std::cout << "UsePhiThetaBand:"<< kUsePhiThetaBand << std::endl;
   std::cout << "ApplyThetaSlice:"<< kApplyThetaSlice << std::endl;
-  std::cout << "ApplyGoodSectorPhiSlice:"<<kApplyGoodSectorPhiSlice << "\n"<<std::endl;
+  std::cout << "ApplyGoodSectorPhiSlice:"<<kApplyGoodSectorPhiSlice << std::endl;
+  std::cout << "CutWarmUpEvents: " << kNCutWarmUpEvents << "\n"<<std::endl;
   std::cout << "EBeam: " << kEBeam << " GeV " << std::endl;
   std::cout << "Target Pdg : " << kTargetPdg << "\n" <<std::endl;
   if ( kIsData ) std::cout << "\nIsData" << std::endl;
@@ -279,7 +351,18 @@ void ConfigureI::PrintConfiguration(void) const {
   if( kSubtractBkg ) {
     std::cout << "\nBackground Subtraction enabled : " << std::endl;
     std::cout << "Maximum Background Multiplicity: "<< kMaxBkgMult << std::endl;
-    std::cout << "Number of rotations: "<< kNRotations << "\n" << std::endl;
+    if( kRotationMethod == kAnalyticRotations ) std::cout << "Analytic rotations (fiducial orbit intervals)\n" << std::endl;
+    else {
+      std::cout << "Number of rotations: "<< kNRotations << std::endl;
+      if( kRotationPrecision > 0 ) std::cout << "Rotations stop when the relative uncertainty is below " << kRotationPrecision << std::endl;
+      if( kRotationMethod == kStratifiedRotations ) std::cout << "Stratified rotation angles" << std::endl;
+      else if( kRotationMethod == kLatticeRotations ) std::cout << "Shifted lattice rotation angles" << std::endl;
+      std::cout << std::endl;
+    }
+    if( kNThreads > 1 ) std::cout << "Background subtraction with " << kNThreads << " threads \n" << std::endl;
+    std::cout << "Random seed: " << kRandomSeed << "\n" << std::endl;
+    if( kStreamBkg ) std::cout << "Streaming background subtraction (event by event) \n" << std::endl;
+    if( kElectronAccCorrection ) std::cout << "Electron acceptance correction enabled, for acceptances above " << kMinElectronAcceptance << " \n" << std::endl;
   }
 
   for( unsigned int i = 0 ; i < kObservables.size(); ++i ) {
@@ -291,12 +374,31 @@ void ConfigureI::PrintConfiguration(void) const {
 
   std::cout << "\nXSecFile " << kXSecFile << std::endl;
   std::cout << "\nStoring output in " << kOutputFile << std::endl;
+  if( kTrace ) std::cout << "Storing trace in " << kOutputFile << "_trace.json, recording one in " << kTraceSampling << " event batches" << std::endl;
+  if( kStatsInterval > 0 ) std::cout << "Storing run statistics in " << kOutputFile << "_stats.jsonl every " << kStatsInterval << " s" << std::endl;
+  if( kCheckpointInterval > 0 ) std::cout << "Storing checkpoint in " << kOutputFile << "_checkpoint.bin every " << kCheckpointInterval << " events" << std::endl;
+  if( kMemoryBudget > 0 && !kStreamBkg ) std::cout << "Stored events above " << kMemoryBudget << " MB are moved to " << kOutputFile << "_spill_*.bin" << std::endl;
   std::cout << "Analizing " << kNEvents << " ... " <<std::endl;
   if( kFirstEvent != 0 ) std::cout << " startint from event " << kFirstEvent << std::endl;
+  if( kPrescale > 1 ) std::cout << " prescaled, analysing about one in " << kPrescale << " events " << std::endl;
   std::cout << "*********************************************************************" << std::endl;
 
 }
 
+bool ConfigureI::IsEntryInPrescale( const unsigned int event_id ) const { 
+  if( kPrescale <= 1 ) return true ; 
+  return utils::HashEntry( kFirstEvent + event_id ) % kPrescale == 0 ; 
+}
+
+unsigned int ConfigureI::GetNPrescaledEvents(void) const { 
+  if( kPrescale <= 1 ) return kNEvents ; 
+  unsigned int n_events = 0 ; 
+  for( unsigned int i = 0 ; i < kNEvents ; ++i ) { 
+    if( IsEntryInPrescale( i ) ) ++n_events ; 
+  }
+  return n_events ; 
+}
+
 unsigned int ConfigureI::GetNTopologyParticles(void) {
   unsigned int N_signal = 0 ;
   for( auto it = kTopology_map.begin() ; it != kTopology_map.end() ; ++it ) {
@@ -316,9 +418,10 @@ bool ConfigureI::InitializeFiducial(void) {
     kFiducialCut = new Fiducial() ; 
     kFiducialCut -> InitPiMinusFit( EBeam ) ; 
     kFiducialCut -> InitEClimits(); 
-    kFiducialCut -> up_lim1_ec -> Eval(60) ;
     kFiducialCut -> SetConstants( conf::GetTorusCurrent( EBeam ), Target , EBeam ) ;
     kFiducialCut -> SetFiducialCutParameters( EBeam ) ;
+    if( kFiducialGrid ) kFiducialCut -> EnableGrid( kFiducialGridCache ) ; 
+    if( kFiducialGrid && kFiducialGridCheck ) kFiducialCut -> fGrid -> Validate( kFiducialGridCheck ) ; 
     if( !kFiducialCut ) return false ; 
   } else { return true ; }
 
@@ -17,6 +17,7 @@
 #include "TTree.h"
 #include "conf/FiducialCutI.h"
 #include "utils/Fiducial.h"
+#include "utils/CounterRNG.h"
 #include <TRandom3.h>
 
 namespace e4nu { 
@@ -41,6 +42,11 @@ namespace e4nu {
     unsigned int GetAnalysisTypeID(void) const{ return kAnalysisTypeID ; }
     unsigned int GetNEventsToRun(void) const { return kNEvents ; } 
     unsigned int GetFirstEventToRun(void) const { return kFirstEvent ; } 
+    // Prescaled runs only analyse the entries with a hash multiple of kPrescale
+    // The selection is deterministic and it does not depend on the file order
+    unsigned int GetPrescale(void) const { return kPrescale ; }
+    bool IsEntryInPrescale( const unsigned int event_id ) const ; 
+    unsigned int GetNPrescaledEvents(void) const ; // Number of analysed entries, used for the normalization
     
     // Get physics information about the analysis      
     double GetConfiguredEBeam(void) const { return kEBeam ; }
@@ -53,6 +59,7 @@ namespace e4nu {
     bool ApplyFiducial(void) const { return kApplyFiducial ; }
     bool ApplyEFiducial(void) const { return kApplyEFiducial ; }
     bool ApplyHadFiducial(void) const { return kApplyHadFiducial ; }
+    bool UseFiducialGrid(void) const { return kFiducialGrid ; }
     bool ApplyCorrWeights(void) const { return kApplyCorrWeights ; }
     bool ApplyAccWeights(void) const { return kApplyAccWeights ; }
     bool ApplyMottScaling(void) const { return kApplyMottWeight ; }
@@ -67,6 +74,13 @@ namespace e4nu {
     bool ApplyMomCut(void) const { return kApplyMomCut ; } 
     bool ApplyOutElectronCut(void) const { return kOutEMomCut ; }      
     bool IsNoFSI(void) const { return kNoFSI ; }
+    unsigned int GetNCutWarmUpEvents(void) const { return kNCutWarmUpEvents ; }
+    bool IsTraceEnabled(void) const { return kTrace ; }
+    unsigned int GetTraceSampling(void) const { return kTraceSampling ; }
+    unsigned int GetProgressInterval(void) const { return kProgressInterval ; }
+    double GetStatsInterval(void) const { return kStatsInterval ; }
+    unsigned int GetCheckpointInterval(void) const { return kCheckpointInterval ; }
+    double GetMemoryBudget(void) const { return kMemoryBudget ; }
 
     Fiducial * GetFiducialCut(void) { return kFiducialCut ; } 
 
@@ -74,11 +88,19 @@ namespace e4nu {
     unsigned int GetMaxBkgMult(void) const { return kMaxBkgMult ; }
     unsigned int GetMinBkgMult(void) const { return kMult_signal ; }
     unsigned int GetNRotations(void) const { return kNRotations ; } 
+    RotationMethod GetRotationMethod(void) const { return kRotationMethod ; } 
+    double GetRotationPrecision(void) const { return kRotationPrecision ; } 
+    unsigned int GetNThreads(void) const { return kNThreads ; } 
+    unsigned int GetRandomSeed(void) const { return kRandomSeed ; } 
     bool GetSubtractBkg(void) const { return kSubtractBkg ; }
     bool GetDebugBkg(void) const { return kDebugBkg ; } 
+    bool StreamBkgSubtraction(void) const { return kStreamBkg ; }
+    bool ApplyElectronAccCorrection(void) const { return kElectronAccCorrection ; }
+    double GetMinElectronAcceptance(void) const { return kMinElectronAcceptance ; }
     
     // Histogram Configurables
     std::vector<std::string> GetObservablesTag(void) const { return kObservables ; }
+    const std::vector<unsigned int> & GetObservablesID(void) const { return kObservablesID ; } // conf::ObservableID
     std::vector<unsigned int> GetNBins(void) const { return kNBins ; }
     std::vector<std::vector<double>> GetRange(void) const { return kRanges ; } 
     bool NormalizeHist(void) { return kNormalize ; }
@@ -103,6 +125,9 @@ namespace e4nu {
     bool kApplyFiducial = true ; // Set to false to remove fiducial cuts
     bool kApplyEFiducial = true ; // Set to false to remove fiducial cuts
     bool kApplyHadFiducial = true ; // Set to false to remove fiducial cuts
+    bool kFiducialGrid = false ; // Use the precomputed fiducial acceptance grid (see FiducialGrid)
+    std::string kFiducialGridCache = "" ; // File with the classified grid cells. Empty to disable the cache
+    unsigned int kFiducialGridCheck = 0 ; // Points per axis of the scan comparing the grid with the exact cut. 0 to disable
     bool kApplyAccWeights = true ; // Set to false to ignore acceptance weights 
     bool kApplyMottWeight = true ; // Apply mott xsec convertion
     bool kApplyReso = true ; // Apply particle resolution
@@ -114,6 +139,13 @@ namespace e4nu {
     bool kQ2Cut = true ; // Apply Q2 cut
     bool kWCut = true ; // Apply W2 cut
     bool kOutEMomCut = true ; // Apply outgoing E cut
+    unsigned int kNCutWarmUpEvents = 10000 ; // Events used to measure the electron cut rates before reordering them
+    bool kTrace = false ; // Store trace-event JSON file with the analysis spans
+    unsigned int kTraceSampling = 1 ; // Record one in kTraceSampling event batches
+    unsigned int kProgressInterval = 100000 ; // Events between progress reports
+    double kStatsInterval = 60 ; // Seconds between run statistics entries. 0 to disable
+    unsigned int kCheckpointInterval = 0 ; // Events between checkpoints. 0 to disable
+    double kMemoryBudget = 0 ; // MB of stored events kept in memory. Above it, the events are moved to disk. 0 to disable
     bool kIsElectron = true ; // Is EM data  
     double koffset = 0 ;  // ofset for oscillation studies
     bool kSubtractBkg = false ; // Apply background correction
@@ -123,6 +155,7 @@ namespace e4nu {
     unsigned int kTargetPdg = 1000060120 ;
     unsigned int kNEvents = 0;
     unsigned int kFirstEvent = 0 ; 
+    unsigned int kPrescale = 1 ; // Analyse about one in kPrescale entries
     unsigned int kMult_signal = 0;
 
     Fiducial * kFiducialCut = nullptr ;
@@ -131,9 +164,17 @@ namespace e4nu {
     std::map<int,unsigned int> kTopology_map ; // Pdg, multiplicity
     unsigned int kMaxBkgMult = 2 ; 
     unsigned int kNRotations = 100; 
+    double kRotationPrecision = 0 ; // Target relative uncertainty of the rotation estimates. 0 to always use NRotations
+    RotationMethod kRotationMethod = kRandomRotations ; // Rotation angle sampler (see CounterRNG) or analytic orbit intervals (see OrbitAcceptance)
+    unsigned int kNThreads = 1 ; // Threads for the background subtraction. 0 to use all cores
+    unsigned int kRandomSeed = 10 ; // Seed of the event random streams (see CounterRNG)
+    bool kStreamBkg = false ; // Subtract background event by event instead of storing the full sample
+    bool kElectronAccCorrection = false ; // Correct the signal for the electron fiducial acceptance (see ElectronAcceptanceTable)
+    double kMinElectronAcceptance = 0.05 ; // Events with a lower electron acceptance are not corrected
 
     // Histogram configurables
     std::vector< std::string > kObservables ;
+    std::vector< unsigned int > kObservablesID ; // Resolved from kObservables at configuration
     std::vector< unsigned int > kNBins ;
     std::vector<std::vector<double>> kRanges ; 
     std::string kInputFile ;
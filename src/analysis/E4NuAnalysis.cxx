@@ -10,7 +10,19 @@
  * Add new id list here...
  */
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <set>
+#include <chrono>
+#include <iomanip>
+#include <cstdlib>
+#include <unistd.h>
+#include "TRandom3.h"
+#include "TMemFile.h"
 #include "analysis/E4NuAnalysis.h"
+#include "physics/MCEvent.h"
+#include "physics/CLAS6Event.h"
 #include "conf/ParticleI.h"
 #include "conf/AnalysisConstantsI.h"
 #include "conf/AccpetanceMapsI.h"
@@ -18,6 +30,9 @@
 #include "utils/KinematicUtils.h"
 #include "utils/ParticleUtils.h"
 #include "utils/Utils.h"
+#include "utils/Tracer.h"
+#include "utils/ProgressMonitor.h"
+#include "utils/Serialization.h"
 
 using namespace e4nu ; 
 
@@ -34,6 +49,9 @@ bool E4NuAnalysis::LoadData(void) {
     std::cout << "ERROR: Configuration failed" <<std::endl;
     return false ;
   }
+  // The output is opened here unless Estimate opened a scratch output
+  if( ! this->OpenOutput( false ) ) return false ; 
+  Tracer::Span span( "LoadData" ) ; 
   // Include new analysis classes with the corresponding analysis ID:
   if( IsCLAS6Analysis() ) { 
     if( IsData() ) {
@@ -75,11 +93,30 @@ unsigned int E4NuAnalysis::GetNEvents( void ) const {
 
 bool E4NuAnalysis::Analyse(void) {
   unsigned int total_nevents = GetNEvents() ;
-  // Loop over events
-  for( unsigned int i = 0 ; i < total_nevents ; ++i ) {
-    //Print percentage
-    if( i==0 || i % 100000 == 0 ) utils::PrintProgressBar(i, total_nevents);
+  // Events are traced in batches of kTraceBatchSize
+  Tracer & tracer = Tracer::Instance() ; 
+  bool trace_batch = false ; 
+  double batch_start = 0 ; 
+  unsigned int batch_first = 0 ; 
+  // Progress report and run statistics
+  ProgressMonitor monitor( total_nevents, GetProgressInterval(), GetOutputFile()+"_stats.jsonl", GetStatsInterval(), kNextEvent ) ; 
+  unsigned int n_selected = kNSelected ; 
+  unsigned int checkpoint_interval = GetCheckpointInterval() ; 
+  // Loop over events. It starts from kNextEvent if the run is resumed from a checkpoint
+  for( unsigned int i = kNextEvent ; i < total_nevents ; ++i ) {
+    if( monitor.IsReportDue( i ) ) monitor.Report( i, n_selected, GetAnalysedEventHolderSize() ) ; 
+    if( checkpoint_interval > 0 && i > kNextEvent && i % checkpoint_interval == 0 ) this->WriteCheckpoint( i, n_selected ) ; 
+
+    if( i % kTraceBatchSize == 0 || i == kNextEvent ) { 
+      if( trace_batch ) this->TraceBatch( batch_start, batch_first, i ) ; 
+      trace_batch = tracer.IsSampled( i / kTraceBatchSize ) ; 
+      batch_start = trace_batch ? tracer.Now() : 0 ; 
+      batch_first = i ; 
+    }
   
+    // Entries out of the prescale are skipped before reading them
+    if( ! IsEntryInPrescale( i ) ) continue ; 
+
     // Get valid event after analysis
     // It returns cooked event, with detector effects
     EventI * event = nullptr ;
@@ -96,14 +133,359 @@ bool E4NuAnalysis::Analyse(void) {
     if( ! event ) {
       continue ;
     }
+    ++n_selected ; 
 
     this->ClassifyEvent( event ) ; // Classify events as signal or Background
 
   }  
+  if( trace_batch ) this->TraceBatch( batch_start, batch_first, total_nevents ) ; 
+  monitor.Report( total_nevents, n_selected, GetAnalysedEventHolderSize(), true ) ; 
+  if( checkpoint_interval > 0 ) this->WriteCheckpoint( total_nevents, n_selected ) ; 
+  kNextEvent = total_nevents ; 
+  kNSelected = n_selected ; 
+  return true ; 
+}
+
+std::string E4NuAnalysis::GetCheckpointTag(void) const { 
+  // A checkpoint can only be used with the same input, event range and random seed
+  std::stringstream tag ; 
+  tag << GetInputFile() << ";" << GetConfiguredEBeam() << ";" << GetConfiguredTarget() << ";" << IsData() << ";" 
+      << GetAnalysisTypeID() << ";" << GetFirstEventToRun() << ";" << GetNEvents() << ";" << GetPrescale() << ";" << GetRandomSeed() ; 
+  return tag.str() ; 
+}
+
+bool E4NuAnalysis::WriteCheckpoint( const unsigned int next_event, const unsigned int n_selected ) { 
+  // The checkpoint is written to a temporary file first, so that an interrupted write does not corrupt the previous checkpoint
+  std::string file = GetCheckpointFile() ; 
+  std::ofstream out( (file+".tmp").c_str(), std::ios::binary ) ; 
+  if( ! out.is_open() ) { 
+    std::cout << " WARN : Cannot open checkpoint file " << file << ".tmp" << std::endl;
+    return false ; 
+  }
+
+  utils::WriteBinary( out, std::string( "E4NUCKPT" ) ) ; 
+  utils::WriteBinary( out, GetCheckpointTag() ) ; 
+  utils::WriteBinary( out, next_event ) ; 
+  utils::WriteBinary( out, n_selected ) ; 
+
+  AnalysisI::WriteCutState( out ) ; 
+
+  // Selected events
+  utils::WriteBinary( out, (unsigned long) kAnalysedEventHolder.size() ) ; 
+  for( auto it = kAnalysedEventHolder.begin() ; it != kAnalysedEventHolder.end() ; ++it ) { 
+    utils::WriteBinary( out, it->first ) ; 
+    utils::WriteBinary( out, (unsigned long) (it->second).size() ) ; 
+    for( unsigned int i = 0 ; i < (it->second).size() ; ++i ) (it->second)[i]->WriteState( out ) ; 
+  }
+  out.close() ; 
+
+  if( out.fail() || std::rename( (file+".tmp").c_str(), file.c_str() ) != 0 ) { 
+    std::cout << " WARN : Failed to write checkpoint file " << file << std::endl;
+    return false ; 
+  }
+  return true ; 
+}
+
+bool E4NuAnalysis::LoadCheckpoint(void) { 
+  std::string file = GetCheckpointFile() ; 
+  std::ifstream in( file.c_str(), std::ios::binary ) ; 
+  if( ! in.is_open() ) { 
+    std::cout << " WARN : Checkpoint file " << file << " not found. Starting from the first event... " << std::endl;
+    return true ; 
+  }
+
+  std::string magic, tag ; 
+  if( ! utils::ReadBinary( in, magic ) || magic != "E4NUCKPT" ) { 
+    std::cout << " ERROR : " << file << " is not a valid checkpoint file " << std::endl;
+    return false ; 
+  }
+  if( ! utils::ReadBinary( in, tag ) || tag != GetCheckpointTag() ) { 
+    std::cout << " ERROR : Checkpoint " << file << " was created with a different configuration " << std::endl;
+    return false ; 
+  }
+
+  unsigned int next_event = 0, n_selected = 0 ; 
+  bool is_ok = utils::ReadBinary( in, next_event ) && utils::ReadBinary( in, n_selected ) ; 
+  is_ok = is_ok && AnalysisI::ReadCutState( in ) ; 
+
+  unsigned long n_mult = 0 ; 
+  is_ok = is_ok && utils::ReadBinary( in, n_mult ) ; 
+  for( unsigned long j = 0 ; is_ok && j < n_mult ; ++j ) { 
+    int mult = 0 ; 
+    unsigned long n_events = 0 ; 
+    is_ok = utils::ReadBinary( in, mult ) && utils::ReadBinary( in, n_events ) ; 
+    std::vector<EventI*> & events = kAnalysedEventHolder[mult] ; 
+    for( unsigned long i = 0 ; is_ok && i < n_events ; ++i ) { 
+      EventI * event = nullptr ; 
+      if( IsData() ) event = new CLAS6Event() ; 
+      else event = new MCEvent() ; 
+      is_ok = event->ReadState( in ) ; 
+      events.push_back( event ) ; 
+    }
+  }
+
+  if( ! is_ok ) { 
+    std::cout << " ERROR : Checkpoint file " << file << " is corrupted " << std::endl;
+    return false ; 
+  }
+
+  kNextEvent = next_event ; 
+  kNSelected = n_selected ; 
+  std::cout << " Resuming from event " << kNextEvent << " with " << GetAnalysedEventHolderSize() << " stored events " << std::endl;
+  return true ; 
+}
+
+bool E4NuAnalysis::Estimate( const unsigned int sample_size ) { 
+  if( ! this->OpenOutput( true ) || ! this->LoadData() ) return false ; 
+  unsigned int total_nevents = GetNEvents() ;
+  if( total_nevents == 0 ) return false ; 
+
+  // Random sample of the prescaled entries, read in order
+  unsigned int analysed_nevents = GetNPrescaledEvents() ; 
+  if( analysed_nevents == 0 ) return false ; 
+  std::set<unsigned int> sample ; 
+  if( sample_size >= analysed_nevents ) { 
+    for( unsigned int i = 0 ; i < total_nevents ; ++i ) if( IsEntryInPrescale( i ) ) sample.insert( i ) ; 
+  } else { 
+    TRandom3 sampler( 1 ) ; 
+    while( sample.size() < sample_size ) { 
+      unsigned int entry = sampler.Integer( total_nevents ) ; 
+      if( IsEntryInPrescale( entry ) ) sample.insert( entry ) ; 
+    }
+  }
+  double scale = (double) analysed_nevents / sample.size() ; 
+
+  // Event selection
+  auto start = std::chrono::steady_clock::now() ; 
+  unsigned int n_selected = 0 ; 
+  for( auto it = sample.begin() ; it != sample.end() ; ++it ) { 
+    EventI * event = this->GetValidEvent( *it ) ; 
+    if( ! event ) continue ; 
+    ++n_selected ; 
+    this->ClassifyEvent( event ) ; 
+  }
+  auto end_selection = std::chrono::steady_clock::now() ; 
+
+  // Memory per stored event, measured on the selected sample
+  unsigned long n_stored = GetAnalysedEventHolderSize() ; 
+  unsigned long n_memory = 0 ; 
+  unsigned long event_memory = 0 ; 
+  std::map<int,unsigned long> n_stored_mult ; 
+  for( auto it = kAnalysedEventHolder.begin() ; it != kAnalysedEventHolder.end() ; ++it ) { 
+    n_stored_mult[it->first] = (it->second).size() ; 
+    n_memory += (it->second).size() ; 
+    for( unsigned int i = 0 ; i < (it->second).size() ; ++i ) event_memory += GetEventMemorySize( (it->second)[i] ) ; 
+  }
+  if( kEventSpill ) { 
+    for( auto it = n_stored_mult.begin() ; it != n_stored_mult.end() ; ++it ) it->second += kEventSpill->GetNEvents( it->first ) ; 
+  }
+  double memory_per_event = n_memory > 0 ? (double) event_memory / n_memory : 0 ; 
+
+  // Background subtraction and acceptance correction, with the configured number of rotations
+  // The number of stored events is checked after each step to find the peak
+  unsigned long peak_stored = n_stored ; 
+  this->SubtractBackground() ; 
+  peak_stored = std::max( peak_stored, GetAnalysedEventHolderSize() ) ; 
+  auto end_subtraction = std::chrono::steady_clock::now() ; 
+
+  // Output size from the compressed size of the sample tree
+  // In streaming mode, the tree is already filled during the event selection
+  // The spilled and in-memory events are stored through different calls. This relies on StoreTree binding the branches to member buffers
+  this->StoreSpilledEvents( GetMinBkgMult() ) ; 
+  if( kAnalysedEventHolder.find( GetMinBkgMult() ) != kAnalysedEventHolder.end() ) { 
+    std::vector<EventI*> & signal = kAnalysedEventHolder[GetMinBkgMult()] ; 
+    for( unsigned int i = 0 ; i < signal.size() ; ++i ) this->StoreEvent( signal[i] ) ; 
+  }
+  kAnalysisTree->FlushBaskets() ; 
+  unsigned long n_output = kAnalysisTree->GetEntries() ; 
+  double bytes_per_entry = n_output > 0 ? (double) kAnalysisTree->GetZipBytes() / n_output : 0 ; 
+  auto end_store = std::chrono::steady_clock::now() ; 
+
+  double time_selection = std::chrono::duration<double>( end_selection - start ).count() ; 
+  double time_subtraction = std::chrono::duration<double>( end_subtraction - end_selection ).count() ; 
+  double time_store = std::chrono::duration<double>( end_store - end_subtraction ).count() ; 
+
+  std::cout << "*********************************************************************" << std::endl;
+  std::cout << "*                        E4NU RUN ESTIMATE                         **" << std::endl;
+  std::cout << "*********************************************************************" << std::endl;
+  std::cout << std::fixed << std::setprecision(1) ; 
+  std::cout << " Sample : " << sample.size() << " of " << analysed_nevents << " events, " << n_selected << " selected " << std::endl;
+  std::cout << " Wall time : " << scale * ( time_selection + time_subtraction + time_store ) << " s " << std::endl;
+  std::cout << "    Event selection        " << scale * time_selection << " s " << std::endl;
+  std::cout << "    Background subtraction " << scale * time_subtraction << " s (" << GetNRotations() << " rotations) " << std::endl;
+  std::cout << "    Output                 " << scale * time_store << " s " << std::endl;
+  std::cout << " Stored events before subtraction : " << scale * n_stored << std::endl;
+  for( auto it = n_stored_mult.begin() ; it != n_stored_mult.end() ; ++it ) { 
+    std::cout << "    Multiplicity " << it->first << " : " << scale * it->second << std::endl;
+  }
+  std::cout << " Peak event holder memory : " << scale * peak_stored * memory_per_event / ( 1024. * 1024. ) << " MB (" 
+	    << memory_per_event << " bytes per event) " << std::endl;
+  std::cout << " Output tree : " << scale * n_output << " entries, " << scale * n_output * bytes_per_entry / ( 1024. * 1024. ) << " MB " << std::endl;
+  std::cout << std::defaultfloat ; 
+  std::cout << "*********************************************************************" << std::endl;
+  return true ; 
+}
+
+unsigned long E4NuAnalysis::GetEventMemorySize( EventI * event ) { 
+  // Approximated heap footprint of an event in the holder
+  // Each map node is counted as the key, the vector header and two pointers for the tree structure
+  unsigned long size = sizeof( *event ) + sizeof( EventI* ) ; 
+  const std::map<int,std::vector<TLorentzVector>> & particles = event->GetFinalParticles4MomRef() ; 
+  const std::map<int,std::vector<TLorentzVector>> & particles_uncorr = event->GetFinalParticlesUnCorr4MomRef() ; 
+  for( auto it = particles.begin() ; it != particles.end() ; ++it ) { 
+    size += 4 * sizeof( void* ) + sizeof( int ) + sizeof( std::vector<TLorentzVector> ) + (it->second).capacity() * sizeof( TLorentzVector ) ; 
+  }
+  for( auto it = particles_uncorr.begin() ; it != particles_uncorr.end() ; ++it ) { 
+    size += 4 * sizeof( void* ) + sizeof( int ) + sizeof( std::vector<TLorentzVector> ) + (it->second).capacity() * sizeof( TLorentzVector ) ; 
+  }
+  return size ; 
+}
+
+unsigned long E4NuAnalysis::GetAnalysedEventHolderSize(void) const { 
+  unsigned long size = 0 ; 
+  for( auto it = kAnalysedEventHolder.begin() ; it != kAnalysedEventHolder.end() ; ++it ) size += (it->second).size() ; 
+  if( kEventSpill ) size += kEventSpill->GetNEvents() ; 
+  return size ; 
+}
+
+void E4NuAnalysis::AddToHolder( EventI * event, const int mult ) { 
+  kAnalysedEventHolder[mult].push_back( event ) ; 
+  if( ! kEventSpill ) return ; 
+
+  kHolderMemory += GetEventMemorySize( event ) ; 
+  if( kHolderMemory <= GetMemoryBudget() * 1024 * 1024 ) return ; 
+  // All the multiplicities are moved to disk, so that the segments are large
+  for( auto it = kAnalysedEventHolder.begin() ; it != kAnalysedEventHolder.end() ; ++it ) this->SpillHolder( it->first ) ; 
+}
+
+bool E4NuAnalysis::SpillHolder( const int mult ) { 
+  auto it = kAnalysedEventHolder.find( mult ) ; 
+  if( ! kEventSpill || it == kAnalysedEventHolder.end() ) return true ; 
+
+  unsigned long memory = 0 ; 
+  for( unsigned int i = 0 ; i < (it->second).size() ; ++i ) memory += GetEventMemorySize( (it->second)[i] ) ; 
+  if( ! kEventSpill->Write( mult, it->second ) ) return false ; 
+  kHolderMemory = kHolderMemory > memory ? kHolderMemory - memory : 0 ; 
   return true ; 
 }
 
+bool E4NuAnalysis::HasHolderEvents( const int mult ) const { 
+  if( kEventSpill && kEventSpill->HasSegments( mult ) ) return true ; 
+  auto it = kAnalysedEventHolder.find( mult ) ; 
+  return it != kAnalysedEventHolder.end() && (it->second).size() > 0 ; 
+}
+
+bool E4NuAnalysis::GetNextChunk( const int mult, std::vector<EventI*> & chunk ) { 
+  chunk.clear() ; 
+  if( kEventSpill && kEventSpill->HasSegments( mult ) ) return kEventSpill->Read( mult, chunk ) ; 
+
+  auto it = kAnalysedEventHolder.find( mult ) ; 
+  if( it == kAnalysedEventHolder.end() ) return true ; 
+  unsigned long memory = 0 ; 
+  for( unsigned int i = 0 ; i < (it->second).size() ; ++i ) memory += GetEventMemorySize( (it->second)[i] ) ; 
+  kHolderMemory = kHolderMemory > memory ? kHolderMemory - memory : 0 ; 
+  chunk.swap( it->second ) ; 
+  kAnalysedEventHolder.erase( it ) ; 
+  return true ; 
+}
+
+bool E4NuAnalysis::SubtractBackgroundOutOfCore( void ) { 
+  if( !ApplyFiducial()  ) return true ; 
+  if( !GetSubtractBkg() ) return true ;
+
+  // Same order as BackgroundI::BackgroundSubstraction : each multiplicity is rotated chunk by chunk,
+  // and the lower multiplicity contributions are added to the holder in event order
+  unsigned int min_mult = GetMinBkgMult() ; 
+  std::vector<EventI*> chunk ; 
+  for( unsigned int m = GetMaxBkgMult() ; m > min_mult ; --m ) { 
+    if( ! HasHolderEvents( m ) ) continue ; 
+    unsigned long n_events = kEventSpill->GetNEvents( m ) ; 
+    if( kAnalysedEventHolder.find( m ) != kAnalysedEventHolder.end() ) n_events += kAnalysedEventHolder[m].size() ; 
+    std::cout<< " Substracting background events with with multiplicity " << m << ". The total number of bkg events is: " << n_events <<std::endl; 
+
+    while( HasHolderEvents( m ) ) { 
+      if( ! this->GetNextChunk( m, chunk ) ) return false ; 
+      std::map<int,std::vector<EventI*>> chunk_holder ; 
+      chunk_holder[m].swap( chunk ) ; 
+      if( ! BackgroundI::BackgroundSubstraction( chunk_holder, m ) ) return false ; 
+
+      for( auto it = chunk_holder.begin() ; it != chunk_holder.end() ; ++it ) { 
+	for( unsigned int i = 0 ; i < (it->second).size() ; ++i ) { 
+	  // Events never reconstructed with multiplicity m are not used
+	  if( it->first == (int) m ) delete (it->second)[i] ; 
+	  else this->AddToHolder( (it->second)[i], it->first ) ; 
+	}
+      }
+    }
+  }
+  return true ; 
+}
+
+bool E4NuAnalysis::AcceptanceCorrectionOutOfCore( const bool is_electron ) { 
+  if( !ApplyFiducial()  ) return true ; 
+  if( !GetSubtractBkg() ) return true ;
+  if( is_electron ) std::cout << " Applying Electron Acceptance Correction ... " << std::endl;
+  else std::cout << " Applying Acceptance Correction to hadrons ... " << std::endl;
+
+  // The corrected events are stored after all the signal events, as in the in-memory acceptance corrections
+  int min_mult = GetMinBkgMult() ; 
+  std::vector<EventI*> chunk ; 
+  while( HasHolderEvents( min_mult ) ) { 
+    if( ! this->GetNextChunk( min_mult, chunk ) ) return false ; 
+    std::vector<EventI*> corrected( chunk.size(), nullptr ) ; 
+    if( is_electron ) { 
+      for( unsigned int i = 0 ; i < chunk.size() ; ++i ) corrected[i] = BackgroundI::ElectronAcceptanceCorrectedEvent( chunk[i] ) ; 
+    } else { 
+      utils::ParallelFor( chunk.size(), GetNThreads(), [&]( unsigned int i ) { 
+	  corrected[i] = BackgroundI::HadronsAcceptanceCorrectedEvent( chunk[i] ) ; 
+	} ) ; 
+    }
+    for( unsigned int i = 0 ; i < chunk.size() ; ++i ) { 
+      this->AddToHolder( chunk[i], kProcessedKey ) ; 
+      if( corrected[i] ) this->AddToHolder( corrected[i], kCorrectedKey ) ; 
+    }
+  }
+
+  if( ! kEventSpill->HasSegments( kProcessedKey ) && ! kEventSpill->HasSegments( kCorrectedKey ) ) { 
+    // Everything fits in memory
+    std::vector<EventI*> & signal = kAnalysedEventHolder[min_mult] ; 
+    signal.swap( kAnalysedEventHolder[kProcessedKey] ) ; 
+    std::vector<EventI*> & corrected = kAnalysedEventHolder[kCorrectedKey] ; 
+    signal.insert( signal.end(), corrected.begin(), corrected.end() ) ; 
+    kAnalysedEventHolder.erase( kProcessedKey ) ; 
+    kAnalysedEventHolder.erase( kCorrectedKey ) ; 
+    return true ; 
+  }
+
+  if( ! ( this->SpillHolder( kProcessedKey ) && this->SpillHolder( kCorrectedKey ) ) ) return false ; 
+  kAnalysedEventHolder.erase( kProcessedKey ) ; 
+  kAnalysedEventHolder.erase( kCorrectedKey ) ; 
+  kEventSpill->Move( kProcessedKey, min_mult ) ; 
+  kEventSpill->Move( kCorrectedKey, min_mult ) ; 
+  return true ; 
+}
+
+bool E4NuAnalysis::StoreSpilledEvents( const int mult ) { 
+  if( ! kEventSpill ) return true ; 
+  std::vector<EventI*> chunk ; 
+  while( kEventSpill->HasSegments( mult ) ) { 
+    if( ! kEventSpill->Read( mult, chunk ) ) return false ; 
+    for( unsigned int i = 0 ; i < chunk.size() ; ++i ) { 
+      this->StoreEvent( chunk[i] ) ; 
+      delete chunk[i] ; 
+    }
+    chunk.clear() ; 
+  }
+  return true ; 
+}
+
+void E4NuAnalysis::TraceBatch( const double start, const unsigned int first_event, const unsigned int last_event ) { 
+  std::string args = "\"first_event\":\"" + std::to_string( first_event ) + "\",\"last_event\":\"" + std::to_string( last_event ) + "\"" ; 
+  Tracer::Instance().AddSpan( "Analyse", start, Tracer::Instance().Now(), args ) ; 
+}
+
 void E4NuAnalysis::ClassifyEvent( EventI * event ) { 
+  CutFlow::Timer timer( kCutFlow, kStageClassification ) ; 
   // Classify as signal or background based on topology
   bool is_signal = true ;
   std::map<int,std::vector<TLorentzVector>> part_map = event -> GetFinalParticles4Mom() ;
@@ -120,13 +502,13 @@ void E4NuAnalysis::ClassifyEvent( EventI * event ) {
   // Store in AnalysedEventHolder
   unsigned int signal_mult = GetMinBkgMult() ;  
   if( is_signal ) {
-    // Storing in background the signal events
-    if( kAnalysedEventHolder.find(signal_mult) == kAnalysedEventHolder.end() ) {
-      std::vector<EventI*> temp ( 1, event ) ;
-      kAnalysedEventHolder[signal_mult] = temp ; 
-    } else { 
-      kAnalysedEventHolder[signal_mult].push_back( event ) ; 
+    kCutFlow.FillStep( kStepSignal, event->GetTotalWeight() ) ; 
+    if( StreamBkgSubtraction() ) { 
+      this->StreamEvent( event, signal_mult ) ; 
+      return ; 
     }
+    // Storing in background the signal events
+    this->AddToHolder( event, signal_mult ) ; 
   } else { // BACKGROUND 
     event->SetIsBkg(true); 
 
@@ -149,39 +531,100 @@ void E4NuAnalysis::ClassifyEvent( EventI * event ) {
     // Only store background events with multiplicity > mult_signal
     // Also ignore background events above the maximum multiplicity
     if( mult_bkg > signal_mult && mult_bkg <= GetMaxBkgMult() ) {
-      if( kAnalysedEventHolder.find(mult_bkg) == kAnalysedEventHolder.end() ) {
-	std::vector<EventI*> temp ( 1, event ) ;
-	kAnalysedEventHolder[mult_bkg] = temp ; 
-      } else { 
-	kAnalysedEventHolder[mult_bkg].push_back( event ) ; 
+      kCutFlow.FillStep( kStepBackground, event->GetTotalWeight() ) ; 
+      if( StreamBkgSubtraction() ) { 
+	this->StreamEvent( event, mult_bkg ) ; 
+	return ; 
       }
+      this->AddToHolder( event, mult_bkg ) ; 
     }
   }
   return ; 
 }
 
+void E4NuAnalysis::StreamEvent( EventI * event, const unsigned int mult ) { 
+  // Background subtraction and acceptance correction are computed event by event
+  // The signal contributions are stored directly, without keeping the event in memory
+  CutFlow::Timer timer( kCutFlow, kStageSubtraction ) ; 
+  std::vector<EventI*> signal_events ; 
+  if( mult == GetMinBkgMult() ) signal_events.push_back( event ) ; 
+  else { 
+    BackgroundI::StreamBackgroundSubstraction( event, mult, signal_events ) ; 
+    delete event ; 
+  }
+
+  unsigned int n_signal = signal_events.size() ; 
+  for( unsigned int i = 0 ; i < n_signal ; ++i ) { 
+    EventI * acc_event = BackgroundI::HadronsAcceptanceCorrectedEvent( signal_events[i] ) ; 
+    if( acc_event ) signal_events.push_back( acc_event ) ; 
+  }
+
+  if( ApplyElectronAccCorrection() ) { 
+    n_signal = signal_events.size() ; 
+    for( unsigned int i = 0 ; i < n_signal ; ++i ) { 
+      EventI * acc_event = BackgroundI::ElectronAcceptanceCorrectedEvent( signal_events[i] ) ; 
+      if( acc_event ) signal_events.push_back( acc_event ) ; 
+    }
+  }
+
+  for( unsigned int i = 0 ; i < signal_events.size() ; ++i ) { 
+    this->StoreEvent( signal_events[i] ) ; 
+    delete signal_events[i] ; 
+  }
+  return ; 
+}
+
+bool E4NuAnalysis::StoreEvent( EventI * event ) { 
+  CutFlow::Timer timer( kCutFlow, kStageFinalise ) ; 
+  // Include new analysis classes with the corresponding analysis ID:
+  if( IsCLAS6Analysis() ) { 
+    if( IsData() ) {
+      if( GetAnalysisTypeID() == 0 ) return CLAS6StandardAnalysis::StoreEvent( event ) ; 
+    } else{ 
+      if( GetAnalysisTypeID() == 0 ) return MCCLAS6StandardAnalysis::StoreEvent( event ) ; 
+    }
+  } 
+  return false ; 
+}
+
 bool E4NuAnalysis::SubtractBackground() {
+  CutFlow::Timer timer( kCutFlow, kStageSubtraction ) ; 
+  // Already subtracted event by event
+  if( StreamBkgSubtraction() ) return true ; 
+
+  if( kEventSpill ) { 
+    if( ! this->SubtractBackgroundOutOfCore() ) return false ; 
+    if( ! this->AcceptanceCorrectionOutOfCore( false ) ) return false ; 
+    if( ApplyElectronAccCorrection() && ! this->AcceptanceCorrectionOutOfCore( true ) ) return false ; 
+    return true ; 
+  }
+
   
   if( ! BackgroundI::BackgroundSubstraction( kAnalysedEventHolder ) ) return false ;  
   if( ! BackgroundI::HadronsAcceptanceCorrection( kAnalysedEventHolder ) ) return false ; 
-  //  if( ! BackgroundI::ElectronAcceptanceCorrection( kAnalysedEventHolder ) ) return false ; 
+  if( ApplyElectronAccCorrection() && ! BackgroundI::ElectronAcceptanceCorrection( kAnalysedEventHolder ) ) return false ; 
 
   return true ; 
 } 
 
 bool E4NuAnalysis::Finalise( ) {
   
-  bool is_ok = true ; 
+  if( ! kOutFile ) return false ; 
+  CutFlow::Timer timer( kCutFlow, kStageFinalise ) ; 
+  Tracer::Span span( "Finalise" ) ; 
+  // Signal events on disk are stored first, the events in memory are stored by the analysis Finalise
+  bool is_ok = this->StoreSpilledEvents( GetMinBkgMult() ) ; 
   if( IsCLAS6Analysis() ) {
-    if( IsData() ) is_ok = CLAS6AnalysisI::Finalise(kAnalysedEventHolder) ; 
+    if( IsData() ) is_ok = CLAS6AnalysisI::Finalise(kAnalysedEventHolder) && is_ok ; 
     else {
-      if( GetAnalysisTypeID() == 0 ) is_ok = MCCLAS6StandardAnalysis::Finalise(kAnalysedEventHolder) ; 
+      if( GetAnalysisTypeID() == 0 ) is_ok = MCCLAS6StandardAnalysis::Finalise(kAnalysedEventHolder) && is_ok ; 
     }
   }
 
   unsigned int hist_size = GetObservablesTag().size() ; 
   if( GetDebugBkg() ) hist_size = kHistograms.size() ; 
 
+  kOutFile->cd() ; 
   if( is_ok ) { 
     for( unsigned int i = 0 ; i < hist_size ; ++i ) {
       if( !kHistograms[i] ) continue ; 
@@ -201,15 +644,49 @@ bool E4NuAnalysis::Finalise( ) {
   }
   kAnalysisTree->Write() ; 
 
+  // Store cut-flow and timing information
+  timer.Stop() ; 
+  kOutFile->cd() ; 
+  kCutFlow.Write() ; 
+  kCutFlow.Print() ; 
+  BackgroundI::PrintRotationStats() ; 
+
   kOutFile->Close() ;
+  // The checkpoint is not needed once the output is stored
+  if( is_ok && GetCheckpointInterval() > 0 ) std::remove( GetCheckpointFile().c_str() ) ; 
+  span.End() ; 
+  Tracer::Instance().Close() ; 
   std::string out_file = GetOutputFile()+".txt";
 
   return is_ok ; 
 }
 
-void E4NuAnalysis::Initialize(void) {
+bool E4NuAnalysis::OpenOutput( const bool is_estimate ) {
+  if( kOutFile ) return true ; 
+  bool use_spill = GetMemoryBudget() > 0 && !StreamBkgSubtraction() ; 
+
+  if( is_estimate ) { 
+    // Nothing is written next to the configured output : the sample tree is compressed in memory
+    // and the spill files go to the temporary directory
+    kOutFile = std::unique_ptr<TFile>( new TMemFile( "e4nu_estimate.root", "RECREATE" ) ) ; 
+    kAnalysisTree->SetDirectory( kOutFile.get() ) ; 
+    const char * tmp_dir = std::getenv( "TMPDIR" ) ; 
+    std::string scratch = std::string( tmp_dir ? tmp_dir : "/tmp" ) + "/e4nu_estimate_" + std::to_string( getpid() ) + "_spill_" ; 
+    if( use_spill ) kEventSpill = std::unique_ptr<EventSpill>( new EventSpill( scratch, IsData() ) ) ; 
+    return true ; 
+  }
+
   kOutFile = std::unique_ptr<TFile>( new TFile( (GetOutputFile()+".root").c_str(),"RECREATE") );
+  if( ! kOutFile->IsOpen() ) { 
+    std::cout << " ERROR : Cannot open output file " << GetOutputFile() << ".root" << std::endl;
+    return false ; 
+  }
+  if( use_spill ) kEventSpill = std::unique_ptr<EventSpill>( new EventSpill( GetOutputFile()+"_spill_", IsData() ) ) ; 
+  if( IsTraceEnabled() && ! Tracer::Instance().Open( GetOutputFile()+"_trace.json", GetTraceSampling() ) ) return false ; 
+  return true ; 
+}
 
+void E4NuAnalysis::Initialize(void) {
   unsigned int ECal_id = 0 ;
   for( unsigned int i = 0 ; i < GetObservablesTag().size() ; ++i ) {
     kHistograms.push_back( new TH1D( GetObservablesTag()[i].c_str(),GetObservablesTag()[i].c_str(), GetNBins()[i], GetRange()[i][0], GetRange()[i][1] ) ) ; 
@@ -13,6 +13,7 @@
 // Include here new analysis classes
 #include "analysis/MCCLAS6StandardAnalysis.h"
 #include "analysis/CLAS6StandardAnalysis.h"
+#include "physics/EventSpill.h"
 
 using namespace e4nu::conf ; 
 
@@ -32,16 +33,61 @@ namespace e4nu {
     bool SubtractBackground( void ) ;
     bool Finalise(void);
 
+    // Restores the event loop state from the checkpoint file. It must be called after LoadData
+    // It returns false if the checkpoint exists but can not be used
+    bool LoadCheckpoint(void) ; 
+
+    // Dry run : a random sample of sample_size events goes through the configured analysis
+    // (event selection, background subtraction and acceptance correction). It prints the extrapolated
+    // wall time, peak memory of the event holder and output size for the full run. No output is stored
+    // It loads the data itself, so LoadData must not be called before
+    bool Estimate( const unsigned int sample_size ) ; 
+
     virtual ~E4NuAnalysis();
 
   private : 
 
     e4nu::EventI * GetValidEvent( const unsigned int event_id ) ;
+    void StreamEvent( EventI * event, const unsigned int mult ) ; 
+    bool StoreEvent( EventI * event ) ; 
+    void TraceBatch( const double start, const unsigned int first_event, const unsigned int last_event ) ; 
     unsigned int GetNEvents( void ) const ;
+    unsigned long GetAnalysedEventHolderSize( void ) const ; 
+    bool WriteCheckpoint( const unsigned int next_event, const unsigned int n_selected ) ; 
+    std::string GetCheckpointFile( void ) const { return GetOutputFile()+"_checkpoint.bin" ; }
+    std::string GetCheckpointTag( void ) const ; 
+    static unsigned long GetEventMemorySize( EventI * event ) ; 
+
+    // Out-of-core event holder, used if MemoryBudget is set
+    // Each multiplicity is stored as its segments on disk followed by the events in memory
+    void AddToHolder( EventI * event, const int mult ) ; // Moves all the events to disk above the budget
+    bool SpillHolder( const int mult ) ; 
+    bool HasHolderEvents( const int mult ) const ; 
+    bool GetNextChunk( const int mult, std::vector<EventI*> & chunk ) ; // Oldest segment, or the events in memory
+    bool SubtractBackgroundOutOfCore( void ) ; 
+    bool AcceptanceCorrectionOutOfCore( const bool is_electron ) ; 
+    bool StoreSpilledEvents( const int mult ) ; 
 
     // Event Holder for signal and background
     std::map<int,std::vector<e4nu::EventI*>> kAnalysedEventHolder;
 
+    std::unique_ptr<EventSpill> kEventSpill ; 
+    unsigned long kHolderMemory = 0 ; // Bytes of the events in memory, only counted with kEventSpill
+    // Temporary keys of the acceptance correction : signal events already corrected, and the corrected events
+    static const int kProcessedKey = -1 ; 
+    static const int kCorrectedKey = -2 ; 
+
+    // Number of events in each traced Analyse span
+    static const unsigned int kTraceBatchSize = 10000 ; 
+
+    // Event loop state, restored from a checkpoint
+    unsigned int kNextEvent = 0 ; 
+    unsigned int kNSelected = 0 ; 
+
+    // Opens the output file, the event spill and the trace. They are opened once, by LoadData or Estimate
+    // In estimate mode, the output is a memory file and the spill files are in the temporary directory
+    bool OpenOutput( const bool is_estimate ) ; 
+
     void Initialize(void) ; 
     
   };
@@ -58,31 +58,34 @@ EventI * MCCLAS6AnalysisI::GetEvent( const unsigned int event_id ) {
 EventI * MCCLAS6AnalysisI::GetValidEvent( const unsigned int event_id ) {
 
   MCEvent * event ;
+  CutFlow::Timer read_timer( kCutFlow, kStageRead ) ; 
   if( IsNoFSI() ) {
     // This function will load the full event using pre FSI nucleon kinematics
     event = (MCEvent*) fData -> GetEventNoFSI(event_id) ; 
   } else event = (MCEvent*) fData -> GetEvent(event_id) ; 
+  read_timer.Stop() ; 
 
   if( !event ) {
     delete event ; 
     return nullptr ; 
   }
 
-  // Apply Generic analysis cuts (0-3)
-  if ( ! AnalysisI::Analyse( event ) ) {
+  // Apply Generic analysis cuts (0-1)
+  if ( ! AnalysisI::ApplyEventCuts( event ) ) {
     delete event ; 
     return nullptr ; 
   }
 
-  // Step 3 : smear particles momentum 
-  if( ApplyReso() ) {
-    this -> SmearParticles( event ) ; 
-  }
-
-  // Step 4: Apply fiducials
+  // Step 2 - 4 : momentum cut, cook event, smear particles momentum and apply fiducials
   // The detector has gaps where the particles cannot be detected
   // We need to account for these with fiducial cuts
-  if ( ! this->ApplyFiducialCut( event ) ) return nullptr ; 
+  // All steps are applied in a single pass over the particles
+  const Fiducial * fiducial = nullptr ; 
+  if( ApplyFiducial() ) fiducial = GetFiducialCut() ; 
+  if ( ! AnalysisI::ApplyParticleCuts( event, ApplyReso(), fiducial ) ) {
+    delete event ; 
+    return nullptr ; 
+  }
   
   // Step 5: Apply Acceptance Correction (Efficiency correction)
   // This takes into account the efficiency detection of each particle in theta and phi
@@ -94,55 +97,23 @@ EventI * MCCLAS6AnalysisI::GetValidEvent( const unsigned int event_id ) {
   return event ; 
 }
 
-bool MCCLAS6AnalysisI::ApplyFiducialCut( MCEvent * event ) { 
-  // First, we apply it to the electron
-  // Apply fiducial cut to electron
-  if( ! ApplyFiducial() ) return true ; 
-  Fiducial * fiducial = GetFiducialCut() ; 
-  if( ! fiducial ) return true ; 
-
-  TLorentzVector out_mom = event -> GetOutLepton4Mom() ;
-  if (! fiducial -> FiducialCut(conf::kPdgElectron, GetConfiguredEBeam(), out_mom.Vect(), IsData() ) ) { delete event ; return false ; }
-
-  // Apply Fiducial cut for hadrons and photons
-  std::map<int,std::vector<TLorentzVector>> part_map = event -> GetFinalParticles4Mom() ;
-  std::map<int,std::vector<TLorentzVector>> part_map_uncorr = event -> GetFinalParticlesUnCorr4Mom() ;
-  std::map<int,std::vector<TLorentzVector>> contained_part_map, contained_part_map_uncorr ; 
-  for( auto it = part_map.begin() ; it != part_map.end() ; ++it ) {
-    std::vector<TLorentzVector> visible_part ; 
-    std::vector<TLorentzVector> visible_part_uncorr ; 
-    for( unsigned int i = 0 ; i < part_map[it->first].size() ; ++i ) {
-      if( ! fiducial -> FiducialCut(it->first, GetConfiguredEBeam(), part_map[it->first][i].Vect(), IsData() ) ) continue ; 
-      visible_part.push_back( part_map[it->first][i] ) ; 
-      visible_part_uncorr.push_back( part_map_uncorr[it->first][i] ) ; 
-    }
-    if( visible_part.size() == 0 ) continue ; 
-    contained_part_map[it->first] = visible_part ; 
-    contained_part_map_uncorr[it->first] = visible_part_uncorr ; 
-  }
-  
-  // Store changes in event after fiducial cut
-  event -> SetFinalParticlesKinematics( contained_part_map ) ; 
-  event -> SetFinalParticlesUnCorrKinematics( contained_part_map_uncorr ) ; 
-
-  return true ; 
-}
-
 void MCCLAS6AnalysisI::ApplyAcceptanceCorrection( MCEvent * event ) { 
+  CutFlow::Timer timer( kCutFlow, kStageAcceptance ) ; 
   double acc_wght = 1 ;
   if( ApplyAccWeights() ) {
     TLorentzVector out_mom = event -> GetOutLepton4Mom() ;
-    std::map<int,std::vector<TLorentzVector>> part_map = event -> GetFinalParticles4Mom() ;
+    const std::map<int,std::vector<TLorentzVector>> & part_map = event -> GetFinalParticles4MomRef() ;
     std::map<int,unsigned int> Topology = GetTopology();
     // Electron acceptance
     if( kAccMap[conf::kPdgElectron] && kGenMap[conf::kPdgElectron] ) acc_wght *= utils::GetAcceptanceMapWeight( *kAccMap[conf::kPdgElectron], *kGenMap[conf::kPdgElectron], out_mom ) ; 
     // Others
     for( auto it = Topology.begin() ; it != Topology.end() ; ++it ) {
-      if ( part_map.find(it->first) == part_map.end()) continue ;
+      auto part = part_map.find(it->first) ; 
+      if ( part == part_map.end()) continue ;
       if ( it->first == conf::kPdgElectron ) continue ; 
       else { 
-	for( unsigned int i = 0 ; i < part_map[it->first].size() ; ++i ) {
-	  if( kAccMap[it->first] && kGenMap[it->first] ) acc_wght *= utils::GetAcceptanceMapWeight( *kAccMap[it->first], *kGenMap[it->first], part_map[it->first][i] ) ;
+	for( unsigned int i = 0 ; i < (part->second).size() ; ++i ) {
+	  if( kAccMap[it->first] && kGenMap[it->first] ) acc_wght *= utils::GetAcceptanceMapWeight( *kAccMap[it->first], *kGenMap[it->first], (part->second)[i] ) ;
 	}
       }
     }
@@ -151,28 +122,6 @@ void MCCLAS6AnalysisI::ApplyAcceptanceCorrection( MCEvent * event ) {
   return ; 
 }
 
-void MCCLAS6AnalysisI::SmearParticles( MCEvent * event ) {
-  double EBeam = GetConfiguredEBeam() ; 
-  TLorentzVector out_mom = event -> GetOutLepton4Mom() ; 
-
-  utils::ApplyResolution( conf::kPdgElectron, out_mom, EBeam ) ; 
-  event -> EventI::SetOutLeptonKinematics( out_mom ) ; 
-  
-  // Apply for other particles
-  std::map<int,std::vector<TLorentzVector>> part_map = event -> GetFinalParticles4Mom() ;
-  for( std::map<int,std::vector<TLorentzVector>>::iterator it = part_map.begin() ; it != part_map.end() ; ++it ) {
-    std::vector<TLorentzVector> vtemp ; 
-    for( unsigned int i = 0 ; i < (it->second).size() ; ++i ) { 
-      TLorentzVector temp = (it->second)[i] ; 
-      utils::ApplyResolution( it->first, temp, EBeam ) ;
-      vtemp.push_back(temp) ; 
-    }
-    part_map[it->first] = vtemp ; 
-  }
-  event -> EventI::SetFinalParticlesKinematics( part_map ) ; 
-  
-} 
-
 unsigned int MCCLAS6AnalysisI::GetNEvents( void ) const {
   return (unsigned int) fData ->GetNEvents() ; 
 }
@@ -247,21 +196,12 @@ bool MCCLAS6AnalysisI::Finalise( std::map<int,std::vector<e4nu::EventI*>> & even
   // Store corrected background in event sample
   unsigned int min_mult = GetMinBkgMult() ; 
   for( unsigned int k = 0 ; k < event_holder[min_mult].size() ; ++k ) {
-    StoreTree( static_cast<MCEvent*>( event_holder[min_mult][k] ) );
-
-    double norm_weight = event_holder[min_mult][k]->GetTotalWeight() ;
-
-    // Store in histogram(s)
-    for( unsigned int j = 0 ; j < GetObservablesTag().size() ; ++j ) {
-      kHistograms[j]-> Fill( event_holder[min_mult][k]->GetObservable( GetObservablesTag()[j] ), norm_weight ) ; 
-    }
-
-    PlotBkgInformation( event_holder[min_mult][k] ) ; 
-
+    StoreEvent( event_holder[min_mult][k] ) ; 
   }
 
-  // Normalize
+  // Normalize to the number of analysed events. It differs from NEvents for prescaled runs
   if ( NormalizeHist() ) {
+    unsigned int n_events = GetNPrescaledEvents() ; 
     for( unsigned int j = 0 ; j < GetObservablesTag().size() ; ++j ) {
       double NBins = kHistograms[j]->GetNbinsX(); 
     
@@ -275,79 +215,96 @@ bool MCCLAS6AnalysisI::Finalise( std::map<int,std::vector<e4nu::EventI*>> & even
 	kHistograms[j]->SetBinError(k,newerror);
       }
 
-      kHistograms[j]->Scale( kXSec * kConversionFactorCm2ToMicroBarn  * TMath::Power(10.,-38.) / GetNEventsToRun() );
+      kHistograms[j]->Scale( kXSec * kConversionFactorCm2ToMicroBarn  * TMath::Power(10.,-38.) / n_events );
     }
   }
 
   return true ; 
 }
 
+bool MCCLAS6AnalysisI::StoreEvent( EventI * event ) {
+  // Store signal event in tree and histogram(s)
+  StoreTree( static_cast<MCEvent*>( event ) );
+
+  double norm_weight = event->GetTotalWeight() ;
+
+  std::vector<double> observables ; 
+  event->GetObservables( GetObservablesID(), observables ) ; 
+  for( unsigned int j = 0 ; j < observables.size() ; ++j ) {
+    kHistograms[j]-> Fill( observables[j], norm_weight ) ; 
+  }
+
+  PlotBkgInformation( event ) ; 
+
+  return true ; 
+}
+
 bool MCCLAS6AnalysisI::StoreTree(MCEvent * event){
-  static bool n = true ; 
-  int ID = event->GetEventID() ; 
-  int TargetPdg = event->GetTargetPdg() ;
-  int InLeptonPdg = event->GetInLeptPdg() ; 
-  int OutLeptonPdg = event->GetOutLeptPdg() ; 
-  double TotWeight = event->GetTotalWeight() ; 
-  double AccWght = event->GetAccWght() ; 
-  double EventWght = event->GetEventWeight() ; 
-  double BeamE = event->GetInLepton4Mom().E() ; 
-
-  bool CC = event->IsCC();
-  bool NC = event->IsNC();
-  bool EM = event->IsEM();
-  bool QEL = event->IsQEL();
-  bool RES = event->IsRES();
-  bool MEC = event->IsMEC();
-  bool DIS = event->IsDIS();
-
-  unsigned int TrueNProtons = event->GetTrueNProtons() ; 
-  unsigned int TrueNNeutrons = event->GetTrueNNeutrons();
-  unsigned int TrueNPiP = event->GetTrueNPiP();
-  unsigned int TrueNPiM = event->GetTrueNPiM();
-  unsigned int TrueNPi0 = event->GetTrueNPi0();
-  unsigned int TrueNKP = event->GetTrueNKP();
-  unsigned int TrueNKM = event->GetTrueNKM(); 
-  unsigned int TrueNK0 = event->GetTrueNK0();
-  unsigned int TrueNEM = event->GetTrueNEM();
-  unsigned int TrueNOther = event->GetTrueNOther();
-
-  unsigned int RecoNProtons = event->GetRecoNProtons() ; 
-  unsigned int RecoNNeutrons = event->GetRecoNNeutrons();
-  unsigned int RecoNPiP = event->GetRecoNPiP();
-  unsigned int RecoNPiM = event->GetRecoNPiM();
-  unsigned int RecoNPi0 = event->GetRecoNPi0();
-  unsigned int RecoNKP = event->GetRecoNKP();
-  unsigned int RecoNKM = event->GetRecoNKM(); 
-  unsigned int RecoNK0 = event->GetRecoNK0();
-  unsigned int RecoNEM = event->GetRecoNEM();
-
-  double TrueQ2s = event->GetTrueQ2s();
-  double TrueWs = event->GetTrueWs();
-  double Truexs = event->GetTruexs();
-  double Trueys = event->GetTrueys();
-  double TrueQ2 = event->GetTrueQ2();
-  double TrueW = event->GetTrueW();
-  double Truex = event->GetTruex();
-  double Truey = event->GetTruey();
+  TreeRecord & t = kTreeRecord ; 
+  t.ID = event->GetEventID() ; 
+  t.TargetPdg = event->GetTargetPdg() ;
+  t.InLeptonPdg = event->GetInLeptPdg() ; 
+  t.OutLeptonPdg = event->GetOutLeptPdg() ; 
+  t.TotWeight = event->GetTotalWeight() ; 
+  t.AccWght = event->GetAccWght() ; 
+  t.EventWght = event->GetEventWeight() ; 
+  t.BeamE = event->GetInLepton4Mom().E() ; 
+
+  t.CC = event->IsCC();
+  t.NC = event->IsNC();
+  t.EM = event->IsEM();
+  t.QEL = event->IsQEL();
+  t.RES = event->IsRES();
+  t.MEC = event->IsMEC();
+  t.DIS = event->IsDIS();
+
+  t.TrueNProtons = event->GetTrueNProtons() ; 
+  t.TrueNNeutrons = event->GetTrueNNeutrons();
+  t.TrueNPiP = event->GetTrueNPiP();
+  t.TrueNPiM = event->GetTrueNPiM();
+  t.TrueNPi0 = event->GetTrueNPi0();
+  t.TrueNKP = event->GetTrueNKP();
+  t.TrueNKM = event->GetTrueNKM(); 
+  t.TrueNK0 = event->GetTrueNK0();
+  t.TrueNEM = event->GetTrueNEM();
+  t.TrueNOther = event->GetTrueNOther();
+
+  t.RecoNProtons = event->GetRecoNProtons() ; 
+  t.RecoNNeutrons = event->GetRecoNNeutrons();
+  t.RecoNPiP = event->GetRecoNPiP();
+  t.RecoNPiM = event->GetRecoNPiM();
+  t.RecoNPi0 = event->GetRecoNPi0();
+  t.RecoNKP = event->GetRecoNKP();
+  t.RecoNKM = event->GetRecoNKM(); 
+  t.RecoNK0 = event->GetRecoNK0();
+  t.RecoNEM = event->GetRecoNEM();
+
+  t.TrueQ2s = event->GetTrueQ2s();
+  t.TrueWs = event->GetTrueWs();
+  t.Truexs = event->GetTruexs();
+  t.Trueys = event->GetTrueys();
+  t.TrueQ2 = event->GetTrueQ2();
+  t.TrueW = event->GetTrueW();
+  t.Truex = event->GetTruex();
+  t.Truey = event->GetTruey();
 
   TLorentzVector out_mom = event->GetOutLepton4Mom();
-  double Efl = out_mom.E();
-  double pfl = out_mom.P();
-  double pflx = out_mom.Px();
-  double pfly = out_mom.Py();
-  double pflz = out_mom.Pz();
-  double pfl_theta = out_mom.Theta();
-  double pfl_phi = out_mom.Phi() + TMath::Pi();
-  unsigned int ElectronSector = utils::GetSector( pfl_phi ) ; 
-
-  double RecoQELEnu = utils::GetQELRecoEnu( out_mom, TargetPdg ) ; 
-  double RecoEnergyTransfer = utils::GetEnergyTransfer( out_mom, TargetPdg ) ; 
-  double Recoq3 = utils::GetRecoq3( out_mom, BeamE ).Mag() ; 
-  double RecoQ2 = utils::GetRecoQ2( out_mom, BeamE ) ; 
-  double RecoXBJK = utils::GetRecoXBJK( out_mom, BeamE ) ; 
-  double RecoW = utils::GetRecoW(out_mom, BeamE ) ;
-  double MottXSecScale = event->GetMottXSecWeight();
+  t.Efl = out_mom.E();
+  t.pfl = out_mom.P();
+  t.pflx = out_mom.Px();
+  t.pfly = out_mom.Py();
+  t.pflz = out_mom.Pz();
+  t.pfl_theta = out_mom.Theta();
+  t.pfl_phi = out_mom.Phi() + TMath::Pi();
+  t.ElectronSector = utils::GetSector( t.pfl_phi ) ; 
+
+  t.RecoQELEnu = utils::GetQELRecoEnu( out_mom, t.TargetPdg ) ; 
+  t.RecoEnergyTransfer = utils::GetEnergyTransfer( out_mom, t.TargetPdg ) ; 
+  t.Recoq3 = utils::GetRecoq3( out_mom, t.BeamE ).Mag() ; 
+  t.RecoQ2 = utils::GetRecoQ2( out_mom, t.BeamE ) ; 
+  t.RecoXBJK = utils::GetRecoXBJK( out_mom, t.BeamE ) ; 
+  t.RecoW = utils::GetRecoW(out_mom, t.BeamE ) ;
+  t.MottXSecScale = event->GetMottXSecWeight();
 
   std::map<int,unsigned int> topology = GetTopology() ;
   static bool topology_has_protons = false ; 
@@ -364,7 +321,7 @@ bool MCCLAS6AnalysisI::StoreTree(MCEvent * event){
     if( topology[conf::kPdgPiM] != 0 ) topology_has_pim = true ; 
   }
 
-  unsigned int TopMult = GetNTopologyParticles();
+  t.TopMult = GetNTopologyParticles();
   std::map<int,std::vector<TLorentzVector>> hadron_map = event->GetFinalParticles4Mom();
   TLorentzVector p_max(0,0,0,0) ;
   if( topology_has_protons ) {
@@ -376,19 +333,19 @@ bool MCCLAS6AnalysisI::StoreTree(MCEvent * event){
       }
     }
   }
-  double proton_mom = p_max.P() ; 
-  double proton_momx = p_max.Px() ; 
-  double proton_momy = p_max.Py() ; 
-  double proton_momz = p_max.Pz() ; 
-  double proton_theta = p_max.Theta() ; 
-  double proton_phi = p_max.Phi() + TMath::Pi() ; 
-  double ECal = utils::GetECal( out_mom.E(), event->GetFinalParticles4Mom(), TargetPdg ) ; 
-  double AlphaT = utils::DeltaAlphaT( out_mom.Vect(), p_max.Vect() ) ; 
-  double DeltaPT = utils::DeltaPT( out_mom.Vect(), p_max.Vect() ).Mag() ; 
-  double DeltaPhiT = utils::DeltaPhiT( out_mom.Vect(), p_max.Vect() ) ; 
-  double HadAlphaT = utils::DeltaAlphaT( out_mom, hadron_map ) ; 
-  double HadDeltaPT = utils::DeltaPT( out_mom, hadron_map ).Mag() ; 
-  double HadDeltaPhiT = utils::DeltaPhiT( out_mom, hadron_map ) ; 
+  t.proton_mom = p_max.P() ; 
+  t.proton_momx = p_max.Px() ; 
+  t.proton_momy = p_max.Py() ; 
+  t.proton_momz = p_max.Pz() ; 
+  t.proton_theta = p_max.Theta() ; 
+  t.proton_phi = p_max.Phi() + TMath::Pi() ; 
+  t.ECal = utils::GetECal( out_mom.E(), event->GetFinalParticles4Mom(), t.TargetPdg ) ; 
+  t.AlphaT = utils::DeltaAlphaT( out_mom.Vect(), p_max.Vect() ) ; 
+  t.DeltaPT = utils::DeltaPT( out_mom.Vect(), p_max.Vect() ).Mag() ; 
+  t.DeltaPhiT = utils::DeltaPhiT( out_mom.Vect(), p_max.Vect() ) ; 
+  t.HadAlphaT = utils::DeltaAlphaT( out_mom, hadron_map ) ; 
+  t.HadDeltaPT = utils::DeltaPT( out_mom, hadron_map ).Mag() ; 
+  t.HadDeltaPhiT = utils::DeltaPhiT( out_mom, hadron_map ) ; 
 
   //const TLorentzVector out_electron , const std::map<int,std::vector<TLorentzVector>> hadrons 
   TLorentzVector pip_max(0,0,0,0) ;
@@ -401,12 +358,12 @@ bool MCCLAS6AnalysisI::StoreTree(MCEvent * event){
       }
     }
   }
-  double pip_mom = pip_max.P() ;
-  double pip_momx = pip_max.Px() ;
-  double pip_momy = pip_max.Py() ;
-  double pip_momz = pip_max.Pz() ;
-  double pip_theta = pip_max.Theta() ;
-  double pip_phi = pip_max.Phi() + TMath::Pi();
+  t.pip_mom = pip_max.P() ;
+  t.pip_momx = pip_max.Px() ;
+  t.pip_momy = pip_max.Py() ;
+  t.pip_momz = pip_max.Pz() ;
+  t.pip_theta = pip_max.Theta() ;
+  t.pip_phi = pip_max.Phi() + TMath::Pi();
 
   TLorentzVector pim_max(0,0,0,0) ;
   if( topology_has_pim ) {
@@ -419,110 +376,110 @@ bool MCCLAS6AnalysisI::StoreTree(MCEvent * event){
     }
   }
 
-  double pim_mom = pim_max.P() ;
-  double pim_momx = pim_max.Px() ;
-  double pim_momy = pim_max.Py() ;
-  double pim_momz = pim_max.Pz() ;
-  double pim_theta = pim_max.Theta() ;
-  double pim_phi = pim_max.Phi() + TMath::Pi() ;
-
-  bool IsBkg = event->IsBkg() ; 
-
-  if( n == true ) {
-    kAnalysisTree -> Branch( "ID", &ID, "ID/I"); 
-    kAnalysisTree -> Branch( "TargetPdg", &TargetPdg, "TargetPdg/I");
-    kAnalysisTree -> Branch( "InLeptonPdg", &InLeptonPdg, "InLeptonPdg/I");
-    kAnalysisTree -> Branch( "OutLeptonPdg", &OutLeptonPdg, "OutLeptonPdg/I");
-    kAnalysisTree -> Branch( "BeamE", &BeamE, "BeamE/D");
-    kAnalysisTree -> Branch( "CC", &CC, "CC/O");
-    kAnalysisTree -> Branch( "NC", &NC, "NC/O");
-    kAnalysisTree -> Branch( "EM", &EM, "EC/O");
-    kAnalysisTree -> Branch( "QEL", &QEL, "QEL/O");
-    kAnalysisTree -> Branch( "RES", &RES, "RES/O");
-    kAnalysisTree -> Branch( "MEC", &MEC, "MEC/O");
-    kAnalysisTree -> Branch( "DIS", &DIS, "DIS/O");
-    kAnalysisTree -> Branch( "TrueQ2s", &TrueQ2s, "TrueQ2s/D");
-    kAnalysisTree -> Branch( "TrueWs", &TrueWs, "TrueWs/D");
-    kAnalysisTree -> Branch( "Truexs", &Truexs, "Truexs/D");
-    kAnalysisTree -> Branch( "Trueys", &Trueys, "Trueys/D");
-    kAnalysisTree -> Branch( "TrueQ2", &TrueQ2, "TrueQ2/D");
-    kAnalysisTree -> Branch( "TrueW", &TrueW, "TrueW/D");
-    kAnalysisTree -> Branch( "Truex", &Truex, "Truex/D");
-    kAnalysisTree -> Branch( "Truey", &Truey, "Truey/D");
-    kAnalysisTree -> Branch( "TotWeight", &TotWeight, "TotWeight/D");
-    kAnalysisTree -> Branch( "EventWght", &EventWght, "EventWght/D");
-    kAnalysisTree -> Branch( "AccWght", &AccWght, "AccWght/D");
-    kAnalysisTree -> Branch( "MottXSecScale", &MottXSecScale, "MottXSecScale/D");
-    kAnalysisTree -> Branch( "IsBkg", &IsBkg, "IsBkg/O");
-    kAnalysisTree -> Branch( "TrueNProtons", &TrueNProtons, "TrueNProtons/I");
-    kAnalysisTree -> Branch( "TrueNNeutrons", &TrueNNeutrons, "TrueNNeutrons/I");
-    kAnalysisTree -> Branch( "TrueNPiP", &TrueNPiP, "TrueNPiP/I");
-    kAnalysisTree -> Branch( "TrueNPiM", &TrueNPiM, "TrueNPiM/I");
-    kAnalysisTree -> Branch( "TrueNPi0", &TrueNPi0, "TrueNPi0/I");
-    kAnalysisTree -> Branch( "TrueNKP", &TrueNKP, "TrueNKP/I");
-    kAnalysisTree -> Branch( "TrueNKM", &TrueNKM, "TrueNKM/I");
-    kAnalysisTree -> Branch( "TrueNK0", &TrueNK0, "TrueNK0/I");
-    kAnalysisTree -> Branch( "TrueNEM", &TrueNEM, "TrueNEM/I");
-    kAnalysisTree -> Branch( "TrueNOther", &TrueNOther, "TrueNOther/I"); 
-    kAnalysisTree -> Branch( "RecoNProtons", &RecoNProtons, "RecoNProtons/I");
-    kAnalysisTree -> Branch( "RecoNNeutrons", &RecoNNeutrons, "RecoNNeutrons/I");
-    kAnalysisTree -> Branch( "RecoNPiP", &RecoNPiP, "RecoNPiP/I");
-    kAnalysisTree -> Branch( "RecoNPiM", &RecoNPiM, "RecoNPiM/I");
-    kAnalysisTree -> Branch( "RecoNPi0", &RecoNPi0, "RecoNPi0/I");
-    kAnalysisTree -> Branch( "RecoNKP", &RecoNKP, "RecoNKP/I");
-    kAnalysisTree -> Branch( "RecoNKM", &RecoNKM, "RecoNKM/I");
-    kAnalysisTree -> Branch( "RecoNK0", &RecoNK0, "RecoNK0/I");
-    kAnalysisTree -> Branch( "RecoNEM", &RecoNEM, "RecoNEM/I");
-    kAnalysisTree -> Branch( "TopMult", &TopMult, "TopMult/I");
-    kAnalysisTree -> Branch( "Efl", &Efl, "Efl/D");
-    kAnalysisTree -> Branch( "pfl", &pfl, "pfl/D");
-    kAnalysisTree -> Branch( "pflx", &pflx, "pflx/D");
-    kAnalysisTree -> Branch( "pfly", &pfly, "pfly/D");
-    kAnalysisTree -> Branch( "pflz", &pflz, "pflz/D");
-    kAnalysisTree -> Branch( "pfl_theta", &pfl_theta, "pfl_theta/D");
-    kAnalysisTree -> Branch( "pfl_phi", &pfl_phi, "pfl_phi/D");
-    kAnalysisTree -> Branch( "RecoQELEnu", &RecoQELEnu, "RecoQELEnu/D");
-    kAnalysisTree -> Branch( "RecoEnergyTransfer", &RecoEnergyTransfer, "RecoEnergyTransfer/D");
-    kAnalysisTree -> Branch( "Recoq3", &Recoq3, "Recoq3/D");
-    kAnalysisTree -> Branch( "RecoQ2", &RecoQ2, "RecoQ2/D");
-    kAnalysisTree -> Branch( "RecoW", &RecoW, "RecoW/D");
-    kAnalysisTree -> Branch( "RecoXBJK", &RecoXBJK, "RecoXBJK/D");
-    kAnalysisTree -> Branch( "ElectronSector", &ElectronSector, "ElectronSector/I");
+  t.pim_mom = pim_max.P() ;
+  t.pim_momx = pim_max.Px() ;
+  t.pim_momy = pim_max.Py() ;
+  t.pim_momz = pim_max.Pz() ;
+  t.pim_theta = pim_max.Theta() ;
+  t.pim_phi = pim_max.Phi() + TMath::Pi() ;
+
+  t.IsBkg = event->IsBkg() ; 
+
+  if( ! kTreeIsBooked ) {
+    kAnalysisTree -> Branch( "ID", &t.ID, "ID/I"); 
+    kAnalysisTree -> Branch( "TargetPdg", &t.TargetPdg, "TargetPdg/I");
+    kAnalysisTree -> Branch( "InLeptonPdg", &t.InLeptonPdg, "InLeptonPdg/I");
+    kAnalysisTree -> Branch( "OutLeptonPdg", &t.OutLeptonPdg, "OutLeptonPdg/I");
+    kAnalysisTree -> Branch( "BeamE", &t.BeamE, "BeamE/D");
+    kAnalysisTree -> Branch( "CC", &t.CC, "CC/O");
+    kAnalysisTree -> Branch( "NC", &t.NC, "NC/O");
+    kAnalysisTree -> Branch( "EM", &t.EM, "EC/O");
+    kAnalysisTree -> Branch( "QEL", &t.QEL, "QEL/O");
+    kAnalysisTree -> Branch( "RES", &t.RES, "RES/O");
+    kAnalysisTree -> Branch( "MEC", &t.MEC, "MEC/O");
+    kAnalysisTree -> Branch( "DIS", &t.DIS, "DIS/O");
+    kAnalysisTree -> Branch( "TrueQ2s", &t.TrueQ2s, "TrueQ2s/D");
+    kAnalysisTree -> Branch( "TrueWs", &t.TrueWs, "TrueWs/D");
+    kAnalysisTree -> Branch( "Truexs", &t.Truexs, "Truexs/D");
+    kAnalysisTree -> Branch( "Trueys", &t.Trueys, "Trueys/D");
+    kAnalysisTree -> Branch( "TrueQ2", &t.TrueQ2, "TrueQ2/D");
+    kAnalysisTree -> Branch( "TrueW", &t.TrueW, "TrueW/D");
+    kAnalysisTree -> Branch( "Truex", &t.Truex, "Truex/D");
+    kAnalysisTree -> Branch( "Truey", &t.Truey, "Truey/D");
+    kAnalysisTree -> Branch( "TotWeight", &t.TotWeight, "TotWeight/D");
+    kAnalysisTree -> Branch( "EventWght", &t.EventWght, "EventWght/D");
+    kAnalysisTree -> Branch( "AccWght", &t.AccWght, "AccWght/D");
+    kAnalysisTree -> Branch( "MottXSecScale", &t.MottXSecScale, "MottXSecScale/D");
+    kAnalysisTree -> Branch( "IsBkg", &t.IsBkg, "IsBkg/O");
+    kAnalysisTree -> Branch( "TrueNProtons", &t.TrueNProtons, "TrueNProtons/I");
+    kAnalysisTree -> Branch( "TrueNNeutrons", &t.TrueNNeutrons, "TrueNNeutrons/I");
+    kAnalysisTree -> Branch( "TrueNPiP", &t.TrueNPiP, "TrueNPiP/I");
+    kAnalysisTree -> Branch( "TrueNPiM", &t.TrueNPiM, "TrueNPiM/I");
+    kAnalysisTree -> Branch( "TrueNPi0", &t.TrueNPi0, "TrueNPi0/I");
+    kAnalysisTree -> Branch( "TrueNKP", &t.TrueNKP, "TrueNKP/I");
+    kAnalysisTree -> Branch( "TrueNKM", &t.TrueNKM, "TrueNKM/I");
+    kAnalysisTree -> Branch( "TrueNK0", &t.TrueNK0, "TrueNK0/I");
+    kAnalysisTree -> Branch( "TrueNEM", &t.TrueNEM, "TrueNEM/I");
+    kAnalysisTree -> Branch( "TrueNOther", &t.TrueNOther, "TrueNOther/I"); 
+    kAnalysisTree -> Branch( "RecoNProtons", &t.RecoNProtons, "RecoNProtons/I");
+    kAnalysisTree -> Branch( "RecoNNeutrons", &t.RecoNNeutrons, "RecoNNeutrons/I");
+    kAnalysisTree -> Branch( "RecoNPiP", &t.RecoNPiP, "RecoNPiP/I");
+    kAnalysisTree -> Branch( "RecoNPiM", &t.RecoNPiM, "RecoNPiM/I");
+    kAnalysisTree -> Branch( "RecoNPi0", &t.RecoNPi0, "RecoNPi0/I");
+    kAnalysisTree -> Branch( "RecoNKP", &t.RecoNKP, "RecoNKP/I");
+    kAnalysisTree -> Branch( "RecoNKM", &t.RecoNKM, "RecoNKM/I");
+    kAnalysisTree -> Branch( "RecoNK0", &t.RecoNK0, "RecoNK0/I");
+    kAnalysisTree -> Branch( "RecoNEM", &t.RecoNEM, "RecoNEM/I");
+    kAnalysisTree -> Branch( "TopMult", &t.TopMult, "TopMult/I");
+    kAnalysisTree -> Branch( "Efl", &t.Efl, "Efl/D");
+    kAnalysisTree -> Branch( "pfl", &t.pfl, "pfl/D");
+    kAnalysisTree -> Branch( "pflx", &t.pflx, "pflx/D");
+    kAnalysisTree -> Branch( "pfly", &t.pfly, "pfly/D");
+    kAnalysisTree -> Branch( "pflz", &t.pflz, "pflz/D");
+    kAnalysisTree -> Branch( "pfl_theta", &t.pfl_theta, "pfl_theta/D");
+    kAnalysisTree -> Branch( "pfl_phi", &t.pfl_phi, "pfl_phi/D");
+    kAnalysisTree -> Branch( "RecoQELEnu", &t.RecoQELEnu, "RecoQELEnu/D");
+    kAnalysisTree -> Branch( "RecoEnergyTransfer", &t.RecoEnergyTransfer, "RecoEnergyTransfer/D");
+    kAnalysisTree -> Branch( "Recoq3", &t.Recoq3, "Recoq3/D");
+    kAnalysisTree -> Branch( "RecoQ2", &t.RecoQ2, "RecoQ2/D");
+    kAnalysisTree -> Branch( "RecoW", &t.RecoW, "RecoW/D");
+    kAnalysisTree -> Branch( "RecoXBJK", &t.RecoXBJK, "RecoXBJK/D");
+    kAnalysisTree -> Branch( "ElectronSector", &t.ElectronSector, "ElectronSector/I");
    
     if( topology_has_protons ) {
-      kAnalysisTree -> Branch( "proton_mom", &proton_mom, "proton_mom/D");
-      kAnalysisTree -> Branch( "proton_momx", &proton_momx, "proton_momx/D");
-      kAnalysisTree -> Branch( "proton_momy", &proton_momy, "proton_momy/D");
-      kAnalysisTree -> Branch( "proton_momz", &proton_momz, "proton_momz/D");
-      kAnalysisTree -> Branch( "proton_theta", &proton_theta, "proton_theta/D");
-      kAnalysisTree -> Branch( "proton_phi", &proton_phi, "proton_phi/D");
-      kAnalysisTree -> Branch( "ECal", &ECal, "ECal/D");
-      kAnalysisTree -> Branch( "AlphaT", &AlphaT, "AlphaT/D");
-      kAnalysisTree -> Branch( "DeltaPT", &DeltaPT, "DeltaPT/D");
-      kAnalysisTree -> Branch( "DeltaPhiT", &DeltaPhiT, "DeltaPhiT/D");
+      kAnalysisTree -> Branch( "proton_mom", &t.proton_mom, "proton_mom/D");
+      kAnalysisTree -> Branch( "proton_momx", &t.proton_momx, "proton_momx/D");
+      kAnalysisTree -> Branch( "proton_momy", &t.proton_momy, "proton_momy/D");
+      kAnalysisTree -> Branch( "proton_momz", &t.proton_momz, "proton_momz/D");
+      kAnalysisTree -> Branch( "proton_theta", &t.proton_theta, "proton_theta/D");
+      kAnalysisTree -> Branch( "proton_phi", &t.proton_phi, "proton_phi/D");
+      kAnalysisTree -> Branch( "ECal", &t.ECal, "ECal/D");
+      kAnalysisTree -> Branch( "AlphaT", &t.AlphaT, "AlphaT/D");
+      kAnalysisTree -> Branch( "DeltaPT", &t.DeltaPT, "DeltaPT/D");
+      kAnalysisTree -> Branch( "DeltaPhiT", &t.DeltaPhiT, "DeltaPhiT/D");
     }
 
     if( topology_has_pip ) {
-      kAnalysisTree -> Branch( "pip_mom", &pip_mom, "pip_mom/D");
-      kAnalysisTree -> Branch( "pip_momx", &pip_momx, "pip_momx/D");
-      kAnalysisTree -> Branch( "pip_momy", &pip_momy, "pip_momy/D");
-      kAnalysisTree -> Branch( "pip_momz", &pip_momz, "pip_momz/D");
-      kAnalysisTree -> Branch( "pip_theta", &pip_theta, "pip_theta/D");
-      kAnalysisTree -> Branch( "pip_phi", &pip_phi, "pip_phi/D");
+      kAnalysisTree -> Branch( "pip_mom", &t.pip_mom, "pip_mom/D");
+      kAnalysisTree -> Branch( "pip_momx", &t.pip_momx, "pip_momx/D");
+      kAnalysisTree -> Branch( "pip_momy", &t.pip_momy, "pip_momy/D");
+      kAnalysisTree -> Branch( "pip_momz", &t.pip_momz, "pip_momz/D");
+      kAnalysisTree -> Branch( "pip_theta", &t.pip_theta, "pip_theta/D");
+      kAnalysisTree -> Branch( "pip_phi", &t.pip_phi, "pip_phi/D");
     }
 
     if( topology_has_pim ) {
-      kAnalysisTree -> Branch( "pim_mom", &pim_mom, "pim_mom/D");
-      kAnalysisTree -> Branch( "pim_momx", &pim_momx, "pim_momx/D");
-      kAnalysisTree -> Branch( "pim_momy", &pim_momy, "pim_momy/D");
-      kAnalysisTree -> Branch( "pim_momz", &pim_momz, "pim_momz/D");
-      kAnalysisTree -> Branch( "pim_theta", &pim_theta, "pim_theta/D");
-      kAnalysisTree -> Branch( "pim_phi", &pim_phi, "pim_phi/D");
+      kAnalysisTree -> Branch( "pim_mom", &t.pim_mom, "pim_mom/D");
+      kAnalysisTree -> Branch( "pim_momx", &t.pim_momx, "pim_momx/D");
+      kAnalysisTree -> Branch( "pim_momy", &t.pim_momy, "pim_momy/D");
+      kAnalysisTree -> Branch( "pim_momz", &t.pim_momz, "pim_momz/D");
+      kAnalysisTree -> Branch( "pim_theta", &t.pim_theta, "pim_theta/D");
+      kAnalysisTree -> Branch( "pim_phi", &t.pim_phi, "pim_phi/D");
     }
-    kAnalysisTree -> Branch( "HadAlphaT", &HadAlphaT, "HadAlphaT/D");
-    kAnalysisTree -> Branch( "HadDeltaPT", &HadDeltaPT, "HadDeltaPT/D");
-    kAnalysisTree -> Branch( "HadDeltaPhiT", &HadDeltaPhiT, "HadDeltaPhiT/D");
-    n = false ; 
+    kAnalysisTree -> Branch( "HadAlphaT", &t.HadAlphaT, "HadAlphaT/D");
+    kAnalysisTree -> Branch( "HadDeltaPT", &t.HadDeltaPT, "HadDeltaPT/D");
+    kAnalysisTree -> Branch( "HadDeltaPhiT", &t.HadDeltaPhiT, "HadDeltaPhiT/D");
+    kTreeIsBooked = true ; 
   }
   
   kAnalysisTree -> Fill();
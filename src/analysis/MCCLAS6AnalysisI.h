@@ -32,12 +32,101 @@ namespace e4nu {
     unsigned int GetNEvents( void ) const ;
     EventI * GetValidEvent( const unsigned int event_id ) ;
     bool Finalise( std::map<int,std::vector<e4nu::EventI*>> & event_holder ) ; 
+    bool StoreEvent( EventI * event ) ;
     bool StoreTree(MCEvent * event);
 
   private :
 
-    void SmearParticles( MCEvent * event ) ;
-    bool ApplyFiducialCut( MCEvent * event ) ; 
+    // Branch buffers of the analysis tree. They are members, so the branch addresses stay valid for every StoreTree call
+    struct TreeRecord {
+      int ID = 0 ;
+      int TargetPdg = 0 ;
+      int InLeptonPdg = 0 ;
+      int OutLeptonPdg = 0 ;
+      double TotWeight = 0 ;
+      double AccWght = 0 ;
+      double EventWght = 0 ;
+      double BeamE = 0 ;
+      bool CC = false ;
+      bool NC = false ;
+      bool EM = false ;
+      bool QEL = false ;
+      bool RES = false ;
+      bool MEC = false ;
+      bool DIS = false ;
+      unsigned int TrueNProtons = 0 ;
+      unsigned int TrueNNeutrons = 0 ;
+      unsigned int TrueNPiP = 0 ;
+      unsigned int TrueNPiM = 0 ;
+      unsigned int TrueNPi0 = 0 ;
+      unsigned int TrueNKP = 0 ;
+      unsigned int TrueNKM = 0 ;
+      unsigned int TrueNK0 = 0 ;
+      unsigned int TrueNEM = 0 ;
+      unsigned int TrueNOther = 0 ;
+      unsigned int RecoNProtons = 0 ;
+      unsigned int RecoNNeutrons = 0 ;
+      unsigned int RecoNPiP = 0 ;
+      unsigned int RecoNPiM = 0 ;
+      unsigned int RecoNPi0 = 0 ;
+      unsigned int RecoNKP = 0 ;
+      unsigned int RecoNKM = 0 ;
+      unsigned int RecoNK0 = 0 ;
+      unsigned int RecoNEM = 0 ;
+      double TrueQ2s = 0 ;
+      double TrueWs = 0 ;
+      double Truexs = 0 ;
+      double Trueys = 0 ;
+      double TrueQ2 = 0 ;
+      double TrueW = 0 ;
+      double Truex = 0 ;
+      double Truey = 0 ;
+      double Efl = 0 ;
+      double pfl = 0 ;
+      double pflx = 0 ;
+      double pfly = 0 ;
+      double pflz = 0 ;
+      double pfl_theta = 0 ;
+      double pfl_phi = 0 ;
+      unsigned int ElectronSector = 0 ;
+      double RecoQELEnu = 0 ;
+      double RecoEnergyTransfer = 0 ;
+      double Recoq3 = 0 ;
+      double RecoQ2 = 0 ;
+      double RecoXBJK = 0 ;
+      double RecoW = 0 ;
+      double MottXSecScale = 0 ;
+      unsigned int TopMult = 0 ;
+      double proton_mom = 0 ;
+      double proton_momx = 0 ;
+      double proton_momy = 0 ;
+      double proton_momz = 0 ;
+      double proton_theta = 0 ;
+      double proton_phi = 0 ;
+      double ECal = 0 ;
+      double AlphaT = 0 ;
+      double DeltaPT = 0 ;
+      double DeltaPhiT = 0 ;
+      double HadAlphaT = 0 ;
+      double HadDeltaPT = 0 ;
+      double HadDeltaPhiT = 0 ;
+      double pip_mom = 0 ;
+      double pip_momx = 0 ;
+      double pip_momy = 0 ;
+      double pip_momz = 0 ;
+      double pip_theta = 0 ;
+      double pip_phi = 0 ;
+      double pim_mom = 0 ;
+      double pim_momx = 0 ;
+      double pim_momy = 0 ;
+      double pim_momz = 0 ;
+      double pim_theta = 0 ;
+      double pim_phi = 0 ;
+      bool IsBkg = false ;
+    } ;
+    TreeRecord kTreeRecord ;
+    bool kTreeIsBooked = false ; // Branches are created at the first StoreTree call
+
     void ApplyAcceptanceCorrection( MCEvent * event ) ;
     EventI * GetEvent( const unsigned int event_id ) ;
     
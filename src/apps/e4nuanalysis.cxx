@@ -8,15 +8,30 @@
 #include <sstream>
 #include <iomanip>
 #include <cstdlib>
+#include <cctype>
 #include "TH1D.h"
 #include "analysis/E4NuAnalysis.h"
 
 using namespace std; 
 using namespace e4nu;
 
-int main( void ) {
+int main( int argc, char* argv[] ) {
   std::cout << "E4Nu analysis ongoing..." << std::endl;
 
+  // --resume : continue from the last checkpoint (see CheckpointInterval)
+  // --estimate [N] : dry run with N sampled events (5000 by default). It prints the expected cost of the full run
+  bool resume = false ; 
+  bool estimate = false ; 
+  unsigned int sample_size = 5000 ; 
+  for( int i = 1 ; i < argc ; ++i ) { 
+    std::string arg( argv[i] ) ; 
+    if( arg == "--resume" ) resume = true ; 
+    else if( arg == "--estimate" ) { 
+      estimate = true ; 
+      if( i+1 < argc && std::isdigit( argv[i+1][0] ) ) sample_size = (unsigned int) std::stoi( argv[++i] ) ; 
+    }
+  }
+
   // This object can be initialized with a configuration file which contains information on the event run, 
   // cuts and analysis requirements, and output file location
   char * env = std::getenv("E4NUANALYSIS") ; 
@@ -25,7 +40,13 @@ int main( void ) {
   E4NuAnalysis * analysis = new E4NuAnalysis((path+"example_configuration.txt").c_str()) ;
   if( ! analysis ) return 0 ; 
   
+  if( estimate ) { 
+    analysis -> Estimate( sample_size ) ; 
+    delete analysis ; 
+    return 0 ; 
+  }
   if( ! analysis -> LoadData() ) return 0 ;  
+  if( resume && ! analysis -> LoadCheckpoint() ) return 0 ; 
 
   // This first steps deals with smearing effects, acceptance weights, fiducial cuts, etc. 
   // It also classifies events as signal or background
@@ -82,3 +82,10 @@ bool conf::ApplyPhotRadCut( const TLorentzVector emom, const TLorentzVector phot
   if(photmom.Angle(emom.Vect())*TMath::RadToDeg() < conf::kPhotonRadCut && fabs(neut_phi_mod-el_phi_mod) < conf::kPhotonEPhiDiffCut ) return true ; 
   return false ;
 }
+
+conf::BeamPeriod conf::GetBeamPeriod( const double EBeam ) {
+  if( EBeam == 1.161 ) return k1161Period ; 
+  else if( EBeam == 2.261 ) return k2261Period ; 
+  else if( EBeam == 4.461 ) return k4461Period ; 
+  return kGenericPeriod ; 
+}
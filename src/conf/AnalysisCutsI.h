@@ -18,6 +18,34 @@ namespace e4nu {
     bool GetQ2Cut( double & Q2cut, const double Ebeam ) ; 
     bool GetWCut( double & WCut, const double Ebeam ) ;
     bool ApplyPhotRadCut( const TLorentzVector emom, const TLorentzVector photmom ) ;
+
+    // Beam periods with compile-time cut values. 
+    // The values must match GetMinMomentumCut, GetQ2Cut and GetWCut
+    enum BeamPeriod { kGenericPeriod = 0, k1161Period, k2261Period, k4461Period } ; 
+    BeamPeriod GetBeamPeriod( const double EBeam ) ; 
+
+    template<BeamPeriod period> struct BeamPeriodCuts ; 
+    template<> struct BeamPeriodCuts<k1161Period> { 
+      static constexpr double kMinEMom = 0.4 ; 
+      static constexpr bool kApplyQ2Cut = true ; 
+      static constexpr double kQ2Cut = 0.1 ; 
+      static constexpr bool kApplyWCut = true ; 
+      static constexpr double kWCut = 2 ; 
+    } ; 
+    template<> struct BeamPeriodCuts<k2261Period> { 
+      static constexpr double kMinEMom = 0.55 ; 
+      static constexpr bool kApplyQ2Cut = true ; 
+      static constexpr double kQ2Cut = 0.4 ; 
+      static constexpr bool kApplyWCut = false ; 
+      static constexpr double kWCut = 0 ; 
+    } ; 
+    template<> struct BeamPeriodCuts<k4461Period> { 
+      static constexpr double kMinEMom = 1.1 ; 
+      static constexpr bool kApplyQ2Cut = true ; 
+      static constexpr double kQ2Cut = 0.8 ; 
+      static constexpr bool kApplyWCut = false ; 
+      static constexpr double kWCut = 0 ; 
+    } ; 
   }
 }
 
@@ -0,0 +1,30 @@
+/**
+ * \info This file contains the list of observables available for analysis
+ **/
+
+#include <iostream>
+#include "conf/ObservablesI.h"
+
+using namespace e4nu ;
+
+namespace {
+  // Same order as conf::ObservableID
+  const std::string kObservableNames[conf::kNObservables] = { 
+    "ECal", "RecoEnu", "QELRecoEnu", "EnergyTransfer", "RecoQ2", "RecoXBJK", "RecoW", 
+    "DeltaPT", "DeltaAlphaT", "DeltaPhiT", "LeadingPMom", "OutEMom", "OutEPhi", "Sector", "Weight", 
+    "LeadingPiPMom", "LeadingPiMMom", "LeadingPiPTheta", "LeadingPiMTheta", 
+    "HadSystemDeltaAlphaT", "HadSystemDeltaPhiT", "HadSystemDeltaPT" 
+  } ;
+}
+
+unsigned int conf::GetObservableID( const std::string observable ) {
+  for( unsigned int i = 0 ; i < conf::kNObservables ; ++i ) { 
+    if( observable == kObservableNames[i] ) return i ; 
+  }
+  return conf::kNObservables ; 
+}
+
+std::string conf::GetObservableName( const unsigned int id ) {
+  if( id >= conf::kNObservables ) return "" ; 
+  return kObservableNames[id] ; 
+}
@@ -0,0 +1,47 @@
+/**
+ * \info This file contains the list of observables available for analysis
+ * The observable names in the configuration file are resolved to an id once, 
+ * so that the event loop does not deal with strings
+ **/
+
+#ifndef _OBSERVABLES_I_H_
+#define _OBSERVABLES_I_H_
+
+#include <string>
+
+namespace e4nu {
+  namespace conf {
+
+    enum ObservableID { 
+      kObsECal = 0,
+      kObsRecoEnu,
+      kObsQELRecoEnu,
+      kObsEnergyTransfer,
+      kObsRecoQ2,
+      kObsRecoXBJK,
+      kObsRecoW,
+      kObsDeltaPT,
+      kObsDeltaAlphaT,
+      kObsDeltaPhiT,
+      kObsLeadingPMom,
+      kObsOutEMom,
+      kObsOutEPhi,
+      kObsSector,
+      kObsWeight,
+      kObsLeadingPiPMom,
+      kObsLeadingPiMMom,
+      kObsLeadingPiPTheta,
+      kObsLeadingPiMTheta,
+      kObsHadSystemDeltaAlphaT,
+      kObsHadSystemDeltaPhiT,
+      kObsHadSystemDeltaPT,
+      kNObservables // Keep last. Used for undefined observables
+    } ;
+
+    // Returns kNObservables if the observable is not defined
+    unsigned int GetObservableID( const std::string observable ) ; 
+    std::string GetObservableName( const unsigned int id ) ; 
+  }
+}
+
+#endif
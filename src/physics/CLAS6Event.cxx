@@ -7,6 +7,7 @@
 #include "physics/CLAS6Event.h"
 #include "utils/ParticleUtils.h"
 #include "conf/ParticleI.h"
+#include "utils/Serialization.h"
 
 using namespace e4nu ; 
 
@@ -15,3 +16,13 @@ CLAS6Event::CLAS6Event(): EventI() {
 }
 
 CLAS6Event::~CLAS6Event() {;}
+
+void CLAS6Event::WriteState( std::ostream & out ) const { 
+  EventI::WriteState( out ) ; 
+  utils::WriteBinary( out, fVertex ) ; 
+}
+
+bool CLAS6Event::ReadState( std::istream & in ) { 
+  if( ! EventI::ReadState( in ) ) return false ; 
+  return utils::ReadBinary( in, fVertex ) ; 
+}
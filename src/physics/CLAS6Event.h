@@ -19,6 +19,9 @@ namespace e4nu {
 
     TLorentzVector GetVertex(void) const { return fVertex ; }
 
+    void WriteState( std::ostream & out ) const ; 
+    bool ReadState( std::istream & in ) ; 
+
     friend class CLAS6EventHolder ; 
 
   protected : 
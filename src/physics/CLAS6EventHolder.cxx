@@ -5,6 +5,7 @@
 
 #include "physics/CLAS6EventHolder.h"
 #include "physics/CLAS6Event.h"
+#include "utils/Tracer.h"
 
 using namespace e4nu ; 
 
@@ -71,9 +72,13 @@ EventI * CLAS6EventHolder::GetEvent(const unsigned int event_id) {
   //  static 
   CLAS6Event * event = new CLAS6Event() ; 
   if ( event_id > (unsigned int) fMaxEvents ) return nullptr ; 
-  fEventHolderChain -> GetEntry( event_id ) ; 
+  double start = Tracer::Instance().IsEnabled() ? Tracer::Instance().Now() : 0 ; 
+  fEventHolderChain -> GetEntry( fFirstEvent + event_id ) ; 
+  this->TraceFileSwitch( start ) ; 
 
   event -> SetEventID( iev ) ;
+  // iev restarts in each file of the chain. The random streams use the chain entry read above, as the prescale
+  event -> SetRandomKey( fFirstEvent + event_id ) ;
   event -> SetEventWeight( 1. ) ;
   event -> SetTargetPdg( tgt ) ; 
   event -> SetInLeptPdg( 11 ) ;
@@ -4,7 +4,9 @@
  * 
  */
 #include <iostream>
+#include <algorithm>
 #include "physics/EventHolderI.h"
+#include "utils/Tracer.h"
 
 using namespace e4nu ; 
 
@@ -23,6 +25,10 @@ EventHolderI::EventHolderI( const std::string file, const unsigned int first_eve
     if( nmaxevents > fEventHolderChain -> GetEntries() || nmaxevents == 0 ) fMaxEvents = fEventHolderChain ->GetEntries() ;
     else fMaxEvents = nmaxevents ; 
     fFirstEvent = first_event ;
+    // Events are read from fFirstEvent, so only the entries after it are available
+    unsigned int n_entries = fEventHolderChain -> GetEntries() ; 
+    if( fFirstEvent >= n_entries ) fMaxEvents = 0 ; 
+    else fMaxEvents = std::min( fMaxEvents, n_entries - fFirstEvent ) ; 
     std::cout<< "Loading "<< fMaxEvents << " from " << file ;
     if( fFirstEvent != 0 ) std::cout << " Starting from event " << fFirstEvent ;
     std::cout << " ... \n" ;
@@ -45,6 +51,18 @@ bool EventHolderI::LoadMembers( const std::string file ) {
   return true ; 
 } 
 
+void EventHolderI::TraceFileSwitch( const double start ) { 
+  int tree_number = fEventHolderChain -> GetTreeNumber() ; 
+  if( tree_number == fTreeNumber ) return ; 
+  fTreeNumber = tree_number ; 
+
+  Tracer & tracer = Tracer::Instance() ; 
+  if( ! tracer.IsEnabled() ) return ; 
+  std::string args = "\"tree\":\"" + std::to_string( tree_number ) + "\"" ; 
+  if( fEventHolderChain -> GetCurrentFile() ) args += ",\"file\":\"" + Tracer::Escape( fEventHolderChain -> GetCurrentFile() -> GetName() ) + "\"" ; 
+  tracer.AddSpan( "FileSwitch", start, tracer.Now(), args ) ; 
+}
+
 void EventHolderI::Initialize() { 
   fEventHolderChain = std::unique_ptr<TChain>( new TChain("gst","e4nu_analysis") ); 
   fIsConfigured = true ; 
@@ -28,6 +28,7 @@ namespace e4nu {
     EventHolderI( const std::vector<std::string> root_file_list ) ; 
     
     bool LoadMembers( const std::string file ) ; // returns tree number in TChain
+    void TraceFileSwitch( const double start ) ; // Records a span if GetEntry opened a new file in the TChain
 
     virtual bool LoadBranch(void) = 0 ; 
     virtual e4nu::EventI * GetEvent(const unsigned int event_id) = 0 ;
@@ -39,6 +40,7 @@ namespace e4nu {
     bool fIsConfigured ; 
     unsigned int fMaxEvents ; 
     unsigned int fFirstEvent ; 
+    int fTreeNumber = -1 ; // Current tree in TChain
 
   private :
 
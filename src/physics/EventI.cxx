@@ -6,9 +6,11 @@
 #include <iostream>
 #include "physics/EventI.h"
 #include "conf/ParticleI.h"
+#include "conf/ObservablesI.h"
 #include "utils/DetectorUtils.h"
 #include "utils/ParticleUtils.h"
 #include "utils/KinematicUtils.h"
+#include "utils/Serialization.h"
 
 using namespace e4nu ; 
 
@@ -65,12 +67,16 @@ void EventI::SetFinalParticleUnCorr( const int pdg, const double E, const double
 }
 
 void EventI::StoreAnalysisRecord( unsigned int analysis_step ) {
-  double weight = this->GetTotalWeight() ; 
-  std::map<int,std::vector<TLorentzVector>> part_map = this->GetFinalParticles4Mom() ; 
   std::vector<int> pdg_list ; 
-  for( auto it = part_map.begin() ; it != part_map.end() ; ++it ) { 
-    for( unsigned int i = 0 ; i < part_map[it->first].size() ; ++i ) pdg_list.push_back( it->first ) ; 
+  for( auto it = fFinalParticles.begin() ; it != fFinalParticles.end() ; ++it ) { 
+    for( unsigned int i = 0 ; i < (it->second).size() ; ++i ) pdg_list.push_back( it->first ) ; 
   }
+  StoreAnalysisRecord( analysis_step, pdg_list ) ; 
+  return ; 
+}
+
+void EventI::StoreAnalysisRecord( unsigned int analysis_step, const std::vector<int> & pdg_list ) {
+  double weight = this->GetTotalWeight() ; 
   std::pair<std::vector<int>,double> pair ( pdg_list, weight ) ; 
   fAnalysisRecord[analysis_step] = pair ; 
   return ; 
@@ -107,108 +113,128 @@ int EventI::GetEventTotalVisibleCharge( const std::map<int,std::vector<TLorentzV
 }
 
 double EventI::GetObservable( const std::string observable ) {
+  unsigned int id = conf::GetObservableID( observable ) ; 
+  if( id == conf::kNObservables ) { 
+    std::cout << observable << " is NOT defined " << std::endl;
+    return 0 ; 
+  }
+  return GetObservable( id ) ; 
+}
+
+double EventI::GetObservable( const unsigned int id ) {
+  std::vector<unsigned int> ids ( 1, id ) ; 
+  std::vector<double> values ; 
+  GetObservables( ids, values ) ; 
+  return values[0] ; 
+}
+
+void EventI::GetObservables( const std::vector<unsigned int> & ids, std::vector<double> & values ) {
+  // Compute all requested observables for this event
+  // The leading particles are only computed once
   unsigned int target = fTargetPdg ; 
   double EBeam = GetInLepton4Mom().E();
   TLorentzVector ef4mom = GetOutLepton4Mom() ;
   TLorentzVector p4mom, pip4mom, pim4mom ; 
-  bool event_wproton = false, event_wpip = false, event_wpim = false ; 
-  
-  if( fFinalParticles.find( conf::kPdgProton ) != fFinalParticles.end() ) { 
-    event_wproton = true ;
-    double max_mom = 0 ; 
-    for ( unsigned int i = 0 ; i < fFinalParticles[conf::kPdgProton].size() ; ++i ) {
-      if( fFinalParticles[conf::kPdgProton][i].P() > max_mom ) {
-	max_mom = fFinalParticles[conf::kPdgProton][i].P() ; 
-	p4mom = fFinalParticles[conf::kPdgProton][i] ;
-      }
-    }
-  }
+  bool event_wproton = GetLeadingParticle( conf::kPdgProton, p4mom ) ; 
+  bool event_wpip = GetLeadingParticle( conf::kPdgPiP, pip4mom ) ; 
+  bool event_wpim = GetLeadingParticle( conf::kPdgPiM, pim4mom ) ; 
 
-  if( fFinalParticles.find( conf::kPdgPiP ) != fFinalParticles.end() ) { 
-    event_wpip = true ;
-    double max_mom = 0 ; 
-    for ( unsigned int i = 0 ; i < fFinalParticles[conf::kPdgPiP].size() ; ++i ) {
-      if( fFinalParticles[conf::kPdgPiP][i].P() > max_mom ) {
-	max_mom = fFinalParticles[conf::kPdgPiP][i].P() ; 
-	pip4mom = fFinalParticles[conf::kPdgPiP][i] ;
-      }
+  values.resize( ids.size() ) ; 
+  for( unsigned int i = 0 ; i < ids.size() ; ++i ) { 
+    double value = 0 ; 
+    switch( ids[i] ) { 
+    case conf::kObsECal : 
+      if ( event_wproton ) value = utils::GetECal( ef4mom.E(), fFinalParticles, target ) ; 
+      break ; 
+    case conf::kObsRecoEnu : 
+      value = utils::GetRecoEnu( ef4mom, target ) ;
+      break ; 
+    case conf::kObsQELRecoEnu : 
+      value = utils::GetQELRecoEnu( ef4mom, target ) ;
+      break ; 
+    case conf::kObsEnergyTransfer : 
+      value = utils::GetEnergyTransfer( ef4mom, EBeam ) ; 
+      break ; 
+    case conf::kObsRecoQ2 : 
+      value = utils::GetRecoQ2( ef4mom, EBeam ) ; 
+      break ; 
+    case conf::kObsRecoXBJK : 
+      value = utils::GetRecoXBJK( ef4mom, EBeam ) ;
+      break ; 
+    case conf::kObsRecoW : 
+      value = utils::GetRecoW( ef4mom, EBeam ) ; 
+      break ; 
+    case conf::kObsDeltaPT : 
+      if ( event_wproton ) value = utils::DeltaPT( ef4mom.Vect(), p4mom.Vect() ).Mag() ;
+      break ; 
+    case conf::kObsDeltaAlphaT : 
+      if ( event_wproton ) value = utils::DeltaAlphaT( ef4mom.Vect(), p4mom.Vect() ) ; 
+      break ; 
+    case conf::kObsDeltaPhiT : 
+      if ( event_wproton ) value = utils::DeltaPhiT( ef4mom.Vect(), p4mom.Vect() ) ;
+      break ; 
+    case conf::kObsLeadingPMom : 
+      value = p4mom.P() ; 
+      break ; 
+    case conf::kObsOutEMom : 
+      value = ef4mom.P() ; 
+      break ; 
+    case conf::kObsOutEPhi : {
+      TLorentzVector ephi4mom = ef4mom ; 
+      ephi4mom.SetPhi( ephi4mom.Phi()+TMath::Pi() ) ;
+      value = ephi4mom.Phi()* 180 / TMath::Pi();
+      break ; 
     }
-  }
-
-  if( fFinalParticles.find( conf::kPdgPiM ) != fFinalParticles.end() ) { 
-    event_wpim = true ;
-    double max_mom = 0 ; 
-    for ( unsigned int i = 0 ; i < fFinalParticles[conf::kPdgPiM].size() ; ++i ) {
-      if( fFinalParticles[conf::kPdgPiM][i].P() > max_mom ) {
-	max_mom = fFinalParticles[conf::kPdgPiM][i].P() ; 
-	pim4mom = fFinalParticles[conf::kPdgPiM][i] ;
-      }
+    case conf::kObsSector : { 
+      TLorentzVector ephi4mom = ef4mom ; 
+      ephi4mom.SetPhi( ephi4mom.Phi()+TMath::Pi() ) ;
+      value = utils::GetSector( ephi4mom.Phi() ) ; 
+      break ; 
+    }
+    case conf::kObsWeight : 
+      value = this->GetEventWeight() ;
+      break ; 
+    case conf::kObsLeadingPiPMom : 
+      if( event_wpip ) value = pip4mom.P() ; 
+      break ; 
+    case conf::kObsLeadingPiMMom : 
+      if( event_wpim ) value = pim4mom.P() ; 
+      break ; 
+    case conf::kObsLeadingPiPTheta : 
+      if( event_wpip ) value = pip4mom.Theta() * 180 / TMath::Pi() ; 
+      break ; 
+    case conf::kObsLeadingPiMTheta : 
+      if( event_wpim ) value = pim4mom.Theta() * 180 / TMath::Pi() ; 
+      break ; 
+    case conf::kObsHadSystemDeltaAlphaT : 
+      value = utils::DeltaAlphaT( ef4mom, fFinalParticles ) ;
+      break ; 
+    case conf::kObsHadSystemDeltaPhiT : 
+      value = utils::DeltaPhiT( ef4mom, fFinalParticles ) ;
+      break ; 
+    case conf::kObsHadSystemDeltaPT : 
+      value = utils::DeltaPT( ef4mom, fFinalParticles ).Mag() ;
+      break ; 
+    default : 
+      std::cout << "Observable id " << ids[i] << " is NOT defined " << std::endl;
     }
+    values[i] = value ; 
   }
+}
 
-  if( observable == "ECal" ) {
-    if ( event_wproton == false ) return 0 ; 
-    return utils::GetECal( ef4mom.E(), GetFinalParticles4Mom(), target ) ; 
-  } else if ( observable == "RecoEnu" ) {
-    return utils::GetRecoEnu( ef4mom, target ) ;
-  } else if ( observable == "QELRecoEnu" ) {
-    return utils::GetQELRecoEnu( ef4mom, target ) ;
-  } else if ( observable == "EnergyTransfer" ) {
-    return utils::GetEnergyTransfer( ef4mom, EBeam ) ; 
-  } else if ( observable == "RecoQ2" ) {
-    return utils::GetRecoQ2( ef4mom, EBeam ) ; 
-  } else if ( observable == "RecoXBJK" ) {
-    return utils::GetRecoXBJK( ef4mom, EBeam ) ;
-  } else if ( observable == "RecoW" ) {
-    return utils::GetRecoW(ef4mom,EBeam ); 
-  } else if ( observable == "DeltaPT" ) {
-    if ( event_wproton == false ) return 0; 
-    return utils::DeltaPT( ef4mom.Vect(), p4mom.Vect() ).Mag() ;
-  } else if ( observable == "DeltaAlphaT" ) {
-    if ( event_wproton == false ) return 0; 
-    return utils::DeltaAlphaT( ef4mom.Vect(), p4mom.Vect() ) ; 
-  } else if ( observable == "DeltaPhiT" ) {
-    if ( event_wproton == false ) return 0; 
-    return utils::DeltaPhiT( ef4mom.Vect(), p4mom.Vect() ) ;
-  } else if ( observable == "LeadingPMom" ) {
-    return p4mom.P() ; 
-  } else if ( observable == "OutEMom" ) {
-    return ef4mom.P() ; 
-  } else if ( observable == "OutEPhi" ) {
-    ef4mom = GetOutLepton4Mom() ;
-    ef4mom.SetPhi( ef4mom.Phi()+TMath::Pi() ) ;
-    return ef4mom.Phi()* 180 / TMath::Pi();
-  } else if ( observable == "Sector" ) {
-    ef4mom = GetOutLepton4Mom() ;
-    ef4mom.SetPhi( ef4mom.Phi()+TMath::Pi() ) ;
-    return utils::GetSector( ef4mom.Phi() ) ; 
-  } else if ( observable == "Weight" ) { 
-    return this->GetEventWeight() ;
-  } else if ( observable == "LeadingPiPMom" ) {
-    if( !event_wpip ) return 0 ; 
-    return pip4mom.P() ; 
-  } else if ( observable == "LeadingPiMMom" ) {
-    if( !event_wpim ) return 0 ; 
-    return pim4mom.P() ; 
-  } else if ( observable == "LeadingPiPTheta" ) {
-    if( !event_wpip ) return 0 ; 
-    return pip4mom.Theta() * 180 / TMath::Pi() ; 
-  } else if ( observable == "LeadingPiMTheta" ) {
-    if( !event_wpim ) return 0 ; 
-    return pim4mom.Theta() * 180 / TMath::Pi() ; 
-  } else if ( observable == "HadSystemDeltaAlphaT" ) {
-    return utils::DeltaAlphaT( ef4mom, GetFinalParticles4Mom() ) ;
-  } else if ( observable == "HadSystemDeltaPhiT" ) {
-    return utils::DeltaPhiT( ef4mom, GetFinalParticles4Mom() ) ;
-  } else if ( observable == "HadSystemDeltaPT" ) {
-    return utils::DeltaPT( ef4mom, GetFinalParticles4Mom() ).Mag() ;
+bool EventI::GetLeadingParticle( const int pdg, TLorentzVector & leading ) const {
+  auto it = fFinalParticles.find( pdg ) ; 
+  if( it == fFinalParticles.end() ) return false ; 
+  double max_mom = 0 ; 
+  for ( unsigned int i = 0 ; i < (it->second).size() ; ++i ) {
+    if( (it->second)[i].P() > max_mom ) {
+      max_mom = (it->second)[i].P() ; 
+      leading = (it->second)[i] ;
+    }
   }
-
-  std::cout << observable << " is NOT defined " << std::endl;
-  return 0 ; 
+  return true ; 
 }
 
-
 void EventI::SetMottXSecWeight(void) { 
   // Set Mott XSec
   double reco_Q2 = utils::GetRecoQ2( this->GetOutLepton4Mom(), this->GetInLepton4Mom().E() ) ;
@@ -219,6 +245,57 @@ TVector3 EventI::GetRecoq3() const {
   return utils::GetRecoq3( fOutLepton, fInLepton.E() ) ; 
 }
 
+void EventI::WriteState( std::ostream & out ) const { 
+  utils::WriteBinary( out, fIsMC ) ; 
+  utils::WriteBinary( out, fInLepton ) ; 
+  utils::WriteBinary( out, fOutLepton ) ; 
+  utils::WriteBinary( out, fFinalParticles ) ; 
+  utils::WriteBinary( out, fInLeptonUnCorr ) ; 
+  utils::WriteBinary( out, fOutLeptonUnCorr ) ; 
+  utils::WriteBinary( out, fFinalParticlesUnCorr ) ; 
+  unsigned int n_particles[10] = { fNP, fNN, fNPiP, fNPiM, fNPi0, fNKP, fNKM, fNK0, fNEM, fNOther } ; 
+  utils::WriteBinary( out, n_particles ) ; 
+  utils::WriteBinary( out, fWeight ) ; 
+  utils::WriteBinary( out, fAccWght ) ; 
+  utils::WriteBinary( out, fMottXSecWght ) ; 
+  utils::WriteBinary( out, fEventID ) ; 
+  utils::WriteBinary( out, fRandomKey ) ; 
+  utils::WriteBinary( out, fRotationAcceptance ) ; 
+  utils::WriteBinary( out, fTargetPdg ) ; 
+  utils::WriteBinary( out, fInLeptPdg ) ; 
+  utils::WriteBinary( out, fOutLeptPdg ) ; 
+  utils::WriteBinary( out, fIsBkg ) ; 
+  utils::WriteBinary( out, fAnalysisRecord ) ; 
+}
+
+bool EventI::ReadState( std::istream & in ) { 
+  unsigned int n_particles[10] ; 
+  bool is_ok = utils::ReadBinary( in, fIsMC ) 
+    && utils::ReadBinary( in, fInLepton ) 
+    && utils::ReadBinary( in, fOutLepton ) 
+    && utils::ReadBinary( in, fFinalParticles ) 
+    && utils::ReadBinary( in, fInLeptonUnCorr ) 
+    && utils::ReadBinary( in, fOutLeptonUnCorr ) 
+    && utils::ReadBinary( in, fFinalParticlesUnCorr ) 
+    && utils::ReadBinary( in, n_particles ) 
+    && utils::ReadBinary( in, fWeight ) 
+    && utils::ReadBinary( in, fAccWght ) 
+    && utils::ReadBinary( in, fMottXSecWght ) 
+    && utils::ReadBinary( in, fEventID ) 
+    && utils::ReadBinary( in, fRandomKey ) 
+    && utils::ReadBinary( in, fRotationAcceptance ) 
+    && utils::ReadBinary( in, fTargetPdg ) 
+    && utils::ReadBinary( in, fInLeptPdg ) 
+    && utils::ReadBinary( in, fOutLeptPdg ) 
+    && utils::ReadBinary( in, fIsBkg ) 
+    && utils::ReadBinary( in, fAnalysisRecord ) ; 
+  if( ! is_ok ) return false ; 
+
+  fNP = n_particles[0] ; fNN = n_particles[1] ; fNPiP = n_particles[2] ; fNPiM = n_particles[3] ; fNPi0 = n_particles[4] ; 
+  fNKP = n_particles[5] ; fNKM = n_particles[6] ; fNK0 = n_particles[7] ; fNEM = n_particles[8] ; fNOther = n_particles[9] ; 
+  return true ; 
+}
+
 void EventI::Initialize() { 
   fFinalParticles.clear() ; 
   fFinalParticlesUnCorr.clear() ; 
@@ -226,6 +303,8 @@ void EventI::Initialize() {
   fEventID = 0 ; 
   fWeight = 0 ; 
   fEventID = 0 ; 
+  fRandomKey = 0 ; 
+  fRotationAcceptance = -1 ; 
   fTargetPdg = 0 ; 
   fInLeptPdg = 11 ; 
   fOutLeptPdg = 11 ; 
@@ -20,12 +20,21 @@ namespace e4nu {
 
     bool IsMC(void) { return fIsMC ;}
     unsigned int GetEventID(void) const { return fEventID ; } 
+    // Key of the event random streams (see CounterRNG). It is the event ID, unless the event is derived from another event
+    unsigned long GetRandomKey(void) const { return fRandomKey ; } 
+    void SetRandomKey( const unsigned long key ) { fRandomKey = key ; }
+    // Fraction of the rotations around q3 with all the particles detected, when it is known from the rotations of the parent event. Otherwise -1
+    double GetRotationAcceptance(void) const { return fRotationAcceptance ; } 
+    void SetRotationAcceptance( const double acceptance ) { fRotationAcceptance = acceptance ; }
     TLorentzVector GetInLepton4Mom(void) const { return fInLepton ; }
     TLorentzVector GetOutLepton4Mom(void) const { return fOutLepton ; }
     std::map<int,std::vector<TLorentzVector>> GetFinalParticles4Mom(void) const { return fFinalParticles ; }
     TLorentzVector GetInLeptonUnCorr4Mom(void) const { return fInLeptonUnCorr ; }
     TLorentzVector GetOutLeptonUnCorr4Mom(void) const { return fOutLeptonUnCorr ; }
     std::map<int,std::vector<TLorentzVector>> GetFinalParticlesUnCorr4Mom(void) const { return fFinalParticlesUnCorr ; }
+    // Used to modify the particle maps in place
+    std::map<int,std::vector<TLorentzVector>> & GetFinalParticles4MomRef(void) { return fFinalParticles ; }
+    std::map<int,std::vector<TLorentzVector>> & GetFinalParticlesUnCorr4MomRef(void) { return fFinalParticlesUnCorr ; }
  
     int GetTargetPdg(void) const { return fTargetPdg ; }
     int GetInLeptPdg(void) const { return fInLeptPdg ; }
@@ -58,6 +67,9 @@ namespace e4nu {
     void SetFinalParticlesUnCorrKinematics( const std::map<int,std::vector<TLorentzVector>> part_map ) { fFinalParticlesUnCorr = part_map ; }
     
     double GetObservable( const std::string observable ) ;
+    double GetObservable( const unsigned int id ) ;
+    // Compute all requested observables (conf::ObservableID) for this event
+    void GetObservables( const std::vector<unsigned int> & ids, std::vector<double> & values ) ; 
     unsigned int GetEventMultiplicity( const std::map<int,std::vector<TLorentzVector>> hadronic_system ) ;
     unsigned int GetNSignalParticles( std::map<int,std::vector<TLorentzVector>> hadronic_system, const std::map<int,unsigned int> topology ) ;
     int GetEventTotalVisibleCharge( const std::map<int,std::vector<TLorentzVector>> hadronic_system ) ;
@@ -67,6 +79,11 @@ namespace e4nu {
     // This method returns the pdg of the visible particles before and after fiducial cuts
     std::map<unsigned int,std::pair<std::vector<int>,double>> GetAnalysisRecord(void) { return fAnalysisRecord; }
     void StoreAnalysisRecord( unsigned int analysis_step ) ; 
+    void StoreAnalysisRecord( unsigned int analysis_step, const std::vector<int> & pdg_list ) ; 
+
+    // Binary serialization of the event, used for analysis checkpoints
+    virtual void WriteState( std::ostream & out ) const ; 
+    virtual bool ReadState( std::istream & in ) ; 
 
   protected : 
 
@@ -115,6 +132,8 @@ namespace e4nu {
   private :
 
     unsigned int fEventID ; 
+    unsigned long fRandomKey = 0 ; 
+    double fRotationAcceptance = -1 ; 
     int fTargetPdg ; 
     int fInLeptPdg ; 
     int fOutLeptPdg ; 
@@ -123,6 +142,8 @@ namespace e4nu {
     
     std::map<unsigned int,std::pair<std::vector<int>,double>> fAnalysisRecord; 
 
+    bool GetLeadingParticle( const int pdg, TLorentzVector & leading ) const ; 
+
     void Initialize(void) ;
     void Clear(void); 
 
@@ -0,0 +1,100 @@
+// _______________________________________________
+/*
+ * Disk storage for analysed events
+ * 
+ */
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include "physics/EventSpill.h"
+#include "physics/MCEvent.h"
+#include "physics/CLAS6Event.h"
+
+using namespace e4nu ; 
+
+EventSpill::EventSpill( const std::string prefix, const bool is_data ) : kPrefix( prefix ), kIsData( is_data ) {;}
+
+EventSpill::~EventSpill() { 
+  for( auto it = kSegments.begin() ; it != kSegments.end() ; ++it ) { 
+    for( unsigned int i = 0 ; i < (it->second).size() ; ++i ) std::remove( (it->second)[i].file.c_str() ) ; 
+  }
+}
+
+bool EventSpill::Write( const int mult, std::vector<EventI*> & events ) { 
+  if( events.size() == 0 ) return true ; 
+
+  Segment segment ; 
+  segment.file = kPrefix + std::to_string( kNFiles++ ) + ".bin" ; 
+  segment.n_events = events.size() ; 
+
+  std::ofstream out( segment.file.c_str(), std::ios::binary ) ; 
+  if( ! out.is_open() ) { 
+    std::cout << " ERROR : Cannot open spill file " << segment.file << std::endl;
+    return false ; 
+  }
+  for( unsigned int i = 0 ; i < events.size() ; ++i ) events[i]->WriteState( out ) ; 
+  out.close() ; 
+  if( out.fail() ) { 
+    std::cout << " ERROR : Failed to write spill file " << segment.file << std::endl;
+    std::remove( segment.file.c_str() ) ; 
+    return false ; 
+  }
+
+  for( unsigned int i = 0 ; i < events.size() ; ++i ) delete events[i] ; 
+  events.clear() ; 
+  kSegments[mult].push_back( segment ) ; 
+  return true ; 
+}
+
+bool EventSpill::Read( const int mult, std::vector<EventI*> & events ) { 
+  if( ! HasSegments( mult ) ) return false ; 
+
+  Segment segment = kSegments[mult].front() ; 
+  kSegments[mult].pop_front() ; 
+
+  std::ifstream in( segment.file.c_str(), std::ios::binary ) ; 
+  bool is_ok = in.is_open() ; 
+  events.reserve( events.size() + segment.n_events ) ; 
+  for( unsigned long i = 0 ; is_ok && i < segment.n_events ; ++i ) { 
+    EventI * event = nullptr ; 
+    if( kIsData ) event = new CLAS6Event() ; 
+    else event = new MCEvent() ; 
+    is_ok = event->ReadState( in ) ; 
+    if( is_ok ) events.push_back( event ) ; 
+    else delete event ; 
+  }
+  in.close() ; 
+  std::remove( segment.file.c_str() ) ; 
+
+  if( ! is_ok ) { 
+    std::cout << " ERROR : Spill file " << segment.file << " is corrupted " << std::endl;
+    return false ; 
+  }
+  return true ; 
+}
+
+void EventSpill::Move( const int from, const int to ) { 
+  if( from == to || ! HasSegments( from ) ) return ; 
+  std::deque<Segment> & segments = kSegments[to] ; 
+  segments.insert( segments.end(), kSegments[from].begin(), kSegments[from].end() ) ; 
+  kSegments.erase( from ) ; 
+}
+
+bool EventSpill::HasSegments( const int mult ) const { 
+  auto it = kSegments.find( mult ) ; 
+  return it != kSegments.end() && (it->second).size() > 0 ; 
+}
+
+unsigned long EventSpill::GetNEvents( const int mult ) const { 
+  auto it = kSegments.find( mult ) ; 
+  if( it == kSegments.end() ) return 0 ; 
+  unsigned long n_events = 0 ; 
+  for( unsigned int i = 0 ; i < (it->second).size() ; ++i ) n_events += (it->second)[i].n_events ; 
+  return n_events ; 
+}
+
+unsigned long EventSpill::GetNEvents( void ) const { 
+  unsigned long n_events = 0 ; 
+  for( auto it = kSegments.begin() ; it != kSegments.end() ; ++it ) n_events += GetNEvents( it->first ) ; 
+  return n_events ; 
+}
@@ -0,0 +1,51 @@
+/**
+ * This class stores analysed events on disk, in segments of events with the same key (multiplicity)
+ * It is used to keep the analysed event holder below the configured memory budget (see MemoryBudget)
+ * Each segment is a binary file with the events written with EventI::WriteState
+ * The segments of a key are read back in the order they were written
+ * The segment files are removed once they are read, or when the object is deleted
+ **/
+
+#ifndef _EVENT_SPILL_H_
+#define _EVENT_SPILL_H_
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include "physics/EventI.h"
+
+namespace e4nu {
+  class EventSpill {
+  public : 
+    EventSpill( const std::string prefix, const bool is_data ) ; 
+    virtual ~EventSpill() ;
+
+    // Writes the events in a new segment with key mult. The events are deleted and the vector is cleared
+    bool Write( const int mult, std::vector<EventI*> & events ) ; 
+
+    // Reads the oldest segment with key mult and removes it. The events are appended to events
+    // It returns false if there is no segment or if the segment can not be read
+    bool Read( const int mult, std::vector<EventI*> & events ) ; 
+
+    // Moves the segments with key from after the segments with key to
+    void Move( const int from, const int to ) ; 
+
+    bool HasSegments( const int mult ) const ; 
+    unsigned long GetNEvents( const int mult ) const ; 
+    unsigned long GetNEvents( void ) const ; 
+
+  private : 
+    struct Segment { 
+      std::string file ; 
+      unsigned long n_events = 0 ; 
+    } ;
+
+    std::map<int,std::deque<Segment>> kSegments ; 
+    std::string kPrefix ; 
+    bool kIsData = false ; 
+    unsigned int kNFiles = 0 ; 
+  };
+}
+
+#endif
@@ -7,6 +7,7 @@
 #include "physics/MCEvent.h"
 #include "utils/ParticleUtils.h"
 #include "conf/ParticleI.h"
+#include "utils/Serialization.h"
 
 using namespace e4nu ; 
 
@@ -32,3 +33,24 @@ MCEvent::MCEvent(): EventI() {
 
 MCEvent::~MCEvent() {;}
 
+void MCEvent::WriteState( std::ostream & out ) const { 
+  EventI::WriteState( out ) ; 
+  bool flags[7] = { fIsEM, fIsCC, fIsNC, fIsQEL, fIsRES, fIsMEC, fIsDIS } ; 
+  double kinematics[8] = { fTrueQ2s, fTrueWs, fTruexs, fTrueys, fTrueQ2, fTrueW, fTruex, fTruey } ; 
+  utils::WriteBinary( out, flags ) ; 
+  utils::WriteBinary( out, kinematics ) ; 
+  utils::WriteBinary( out, fVertex ) ; 
+}
+
+bool MCEvent::ReadState( std::istream & in ) { 
+  bool flags[7] ; 
+  double kinematics[8] ; 
+  if( ! EventI::ReadState( in ) ) return false ; 
+  if( ! ( utils::ReadBinary( in, flags ) && utils::ReadBinary( in, kinematics ) && utils::ReadBinary( in, fVertex ) ) ) return false ; 
+
+  fIsEM = flags[0] ; fIsCC = flags[1] ; fIsNC = flags[2] ; fIsQEL = flags[3] ; fIsRES = flags[4] ; fIsMEC = flags[5] ; fIsDIS = flags[6] ; 
+  fTrueQ2s = kinematics[0] ; fTrueWs = kinematics[1] ; fTruexs = kinematics[2] ; fTrueys = kinematics[3] ; 
+  fTrueQ2 = kinematics[4] ; fTrueW = kinematics[5] ; fTruex = kinematics[6] ; fTruey = kinematics[7] ; 
+  return true ; 
+}
+
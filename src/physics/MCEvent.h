@@ -48,6 +48,9 @@ namespace e4nu {
 
     void SetAccWght( const double wght ) { fAccWght = wght ; }
 
+    void WriteState( std::ostream & out ) const ; 
+    bool ReadState( std::istream & in ) ; 
+
     friend class MCEventHolder ; 
 
   protected : 
@@ -5,6 +5,7 @@
 
 #include "physics/MCEventHolder.h"
 #include "physics/MCEvent.h"
+#include "utils/Tracer.h"
 
 using namespace e4nu ; 
 
@@ -98,9 +99,13 @@ EventI * MCEventHolder::GetEvent(const unsigned int event_id) {
   if ( event_id > (unsigned int) fMaxEvents ) return nullptr ; 
 
   MCEvent * event = new MCEvent() ; 
-  fEventHolderChain->GetEntry( event_id ) ; 
+  double start = Tracer::Instance().IsEnabled() ? Tracer::Instance().Now() : 0 ; 
+  fEventHolderChain->GetEntry( fFirstEvent + event_id ) ; 
+  this->TraceFileSwitch( start ) ; 
 
   event -> SetEventID( iev ) ;
+  // iev restarts in each file of the chain. The random streams use the chain entry read above, as the prescale
+  event -> SetRandomKey( fFirstEvent + event_id ) ;
   event -> SetEventWeight( wght ) ;
   event -> SetIsEM( em ) ;   
   event -> SetIsCC( cc ) ; 
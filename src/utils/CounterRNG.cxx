@@ -0,0 +1,36 @@
+/**
+ * Counter-based random number generator
+ **/
+#include <cmath>
+#include "TMath.h"
+#include "utils/CounterRNG.h"
+#include "utils/Utils.h"
+
+using namespace e4nu ;
+
+CounterRNG::CounterRNG( const unsigned long seed, const unsigned long entry, const unsigned int stage ) {
+  kKey = CombineKeys( CombineKeys( utils::HashEntry( seed ), entry ), stage ) ;
+}
+
+double CounterRNG::Uniform( const unsigned long counter ) const {
+  // 53 most significant bits as mantissa
+  return ( utils::HashEntry( kKey + counter ) >> 11 ) * ( 1. / 9007199254740992. ) ;
+}
+
+double CounterRNG::Gaus( const unsigned long counter, const double mean, const double sigma ) const {
+  double u1 = 1. - Uniform( 2 * counter ) ; // (0,1]
+  double u2 = Uniform( 2 * counter + 1 ) ;
+  return mean + sigma * std::sqrt( -2. * std::log( u1 ) ) * std::cos( 2. * TMath::Pi() * u2 ) ;
+}
+
+double CounterRNG::RotationAngle( const RotationMethod method, const unsigned long counter, const unsigned int n_rotations ) const {
+  if( n_rotations == 0 || ( method != kStratifiedRotations && method != kLatticeRotations ) ) return Uniform( counter, 0, 2*TMath::Pi() ) ;
+  unsigned long rot_id = counter % n_rotations ;
+  // Stratified : independent offset in each bin. Lattice : same offset for all the angles of the set
+  double offset = method == kStratifiedRotations ? Uniform( counter ) : Uniform( counter - rot_id ) ;
+  return 2*TMath::Pi() * ( rot_id + offset ) / n_rotations ;
+}
+
+unsigned long CounterRNG::CombineKeys( const unsigned long key, const unsigned long value ) {
+  return utils::HashEntry( key ^ utils::HashEntry( value ) ) ;
+}
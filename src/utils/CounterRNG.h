@@ -0,0 +1,47 @@
+/**
+ * Counter-based random number generator
+ * The random numbers are a hash of (seed, entry, stage, counter). There is no internal state,
+ * so the numbers for a given event do not depend on the event order or on the number of threads
+ *
+ * The entry is the event random key (see EventI::GetRandomKey), the stage identifies the analysis
+ * step which uses the numbers and the counter is the index of the number within that step
+ * (i.e. rotation number or particle index)
+ *
+ * The rotation angles can be drawn uniformly, stratified (one angle in each of the n_rotations bins)
+ * or from a randomly shifted lattice (equally spaced angles with a random offset)
+ **/
+
+#ifndef _COUNTER_RNG_H_
+#define _COUNTER_RNG_H_
+
+namespace e4nu {
+
+  // Analysis steps with independent random streams
+  enum RandomStage { kRandomSmearing = 0, kRandomBkgRotation, kRandomHadronAcceptance, kRandomElectronAcceptance, kRandomSubtraction } ;
+
+  // Method used to compute the acceptance of rotated events. Analytic rotations do not use random angles (see OrbitAcceptance)
+  enum RotationMethod { kRandomRotations = 0, kAnalyticRotations, kStratifiedRotations, kLatticeRotations } ;
+
+  class CounterRNG {
+  public :
+    CounterRNG( const unsigned long seed, const unsigned long entry, const unsigned int stage ) ;
+
+    // Uniform in [0,1)
+    double Uniform( const unsigned long counter ) const ;
+    double Uniform( const unsigned long counter, const double min, const double max ) const { return min + ( max - min ) * Uniform( counter ) ; }
+    // Gaussian, from the uniforms with counters 2*counter and 2*counter+1 (Box-Muller)
+    double Gaus( const unsigned long counter, const double mean, const double sigma ) const ;
+
+    // Rotation angle in [0,2pi). Consecutive blocks of n_rotations counters form one set of angles
+    // The rotation number within the set is counter % n_rotations
+    double RotationAngle( const RotationMethod method, const unsigned long counter, const unsigned int n_rotations ) const ;
+
+    // Key for a derived stream, i.e. for the events created from a parent event
+    static unsigned long CombineKeys( const unsigned long key, const unsigned long value ) ;
+
+  private :
+    unsigned long kKey = 0 ;
+  };
+}
+
+#endif
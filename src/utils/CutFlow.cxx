@@ -0,0 +1,132 @@
+/**
+ * This class keeps track of the analysis cut-flow and of the time spent in each analysis stage
+ **/
+#include <iostream>
+#include <iomanip>
+#include "TH1D.h"
+#include "utils/CutFlow.h"
+#include "utils/Serialization.h"
+
+using namespace e4nu ;
+
+CutFlow::CutFlow() {
+  kSteps.resize( kNCutFlowSteps ) ;
+  kSteps[kStepRead].name = "Read" ;
+  kSteps[kStepElectronCuts].name = "ElectronCuts" ;
+  kSteps[kStepParticleCuts].name = "ParticleCuts" ;
+  kSteps[kStepSignal].name = "Signal" ;
+  kSteps[kStepBackground].name = "Background" ;
+
+  kStages.resize( kNAnalysisStages ) ;
+  kStages[kStageRead].name = "Read" ;
+  kStages[kStageEventCuts].name = "EventCuts" ;
+  kStages[kStageParticleCuts].name = "ParticleCuts" ;
+  kStages[kStageAcceptance].name = "Acceptance" ;
+  kStages[kStageClassification].name = "Classification" ;
+  kStages[kStageSubtraction].name = "Subtraction" ;
+  kStages[kStageFinalise].name = "Finalise" ;
+}
+
+CutFlow::~CutFlow() {;}
+
+unsigned int CutFlow::AddRejection( const std::string name ) {
+  Counter counter ;
+  counter.name = name ;
+  kRejections.push_back( counter ) ;
+  return kRejections.size() - 1 ;
+}
+
+void CutFlow::Print(void) const {
+  std::cout << "*********************************************************************" << std::endl;
+  std::cout << "*                         E4NU CUT-FLOW                            **" << std::endl;
+  std::cout << "*********************************************************************" << std::endl;
+  PrintTable( "Cut-flow", kSteps, "weighted" ) ;
+  PrintTable( "Events rejected by electron cuts", kRejections, "weighted" ) ;
+  PrintTable( "Time per stage", kStages, "seconds" ) ;
+  std::cout << "*********************************************************************" << std::endl;
+}
+
+void CutFlow::PrintTable( const std::string title, const std::vector<Counter> & table, const std::string sum_tag ) const {
+  std::cout << title << " : " << std::endl;
+  for( unsigned int i = 0 ; i < table.size() ; ++i ) {
+    std::cout << "    " << std::left << std::setw(22) << table[i].name << std::right
+	      << std::setw(12) << table[i].n << " " << std::setw(14) << table[i].sum << " " << sum_tag << std::endl;
+  }
+  std::cout << std::endl;
+}
+
+void CutFlow::Write(void) const {
+  WriteTable( "CutFlow", kSteps, false ) ;
+  WriteTable( "CutFlowWeighted", kSteps, true ) ;
+  WriteTable( "ElectronCutRejections", kRejections, false ) ;
+  WriteTable( "ElectronCutRejectionsWeighted", kRejections, true ) ;
+  WriteTable( "StageTime", kStages, true ) ;
+}
+
+void CutFlow::WriteTable( const std::string name, const std::vector<Counter> & table, const bool use_sum ) const {
+  if( table.size() == 0 ) return ;
+  TH1D * hist = new TH1D( name.c_str(), name.c_str(), table.size(), 0, table.size() ) ;
+  for( unsigned int i = 0 ; i < table.size() ; ++i ) {
+    hist->GetXaxis()->SetBinLabel( i+1, table[i].name.c_str() ) ;
+    if( use_sum ) hist->SetBinContent( i+1, table[i].sum ) ;
+    else hist->SetBinContent( i+1, table[i].n ) ;
+  }
+  hist->SetStats(false) ;
+  hist->Write() ;
+  delete hist ;
+}
+
+void CutFlow::WriteState( std::ostream & out ) const {
+  WriteCounters( out, kSteps ) ;
+  WriteCounters( out, kRejections ) ;
+  WriteCounters( out, kStages ) ;
+}
+
+bool CutFlow::ReadState( std::istream & in ) {
+  return ReadCounters( in, kSteps ) && ReadCounters( in, kRejections ) && ReadCounters( in, kStages ) ;
+}
+
+void CutFlow::WriteCounters( std::ostream & out, const std::vector<Counter> & table ) {
+  utils::WriteBinary( out, (unsigned long) table.size() ) ;
+  for( unsigned int i = 0 ; i < table.size() ; ++i ) {
+    utils::WriteBinary( out, table[i].name ) ;
+    utils::WriteBinary( out, table[i].n ) ;
+    utils::WriteBinary( out, table[i].sum ) ;
+  }
+}
+
+bool CutFlow::ReadCounters( std::istream & in, std::vector<Counter> & table ) {
+  // The tables are matched by name, so that a checkpoint from a different configuration is rejected
+  unsigned long size = 0 ;
+  if( ! utils::ReadBinary( in, size ) || size != table.size() ) return false ;
+  for( unsigned int i = 0 ; i < table.size() ; ++i ) {
+    std::string name ;
+    if( ! utils::ReadBinary( in, name ) || name != table[i].name ) return false ;
+    if( ! ( utils::ReadBinary( in, table[i].n ) && utils::ReadBinary( in, table[i].sum ) ) ) return false ;
+  }
+  return true ;
+}
+
+CutFlow::Timer::Timer( CutFlow & cut_flow, const unsigned int stage ) : kCutFlow( cut_flow ) {
+  auto now = std::chrono::steady_clock::now() ;
+  // Pause the running stage
+  kPreviousStage = kCutFlow.kActiveStage ;
+  if( kPreviousStage >= 0 ) kCutFlow.kStages[kPreviousStage].sum += std::chrono::duration<double>( now - kCutFlow.kActiveStart ).count() ;
+  ++kCutFlow.kStages[stage].n ;
+  kCutFlow.kActiveStage = stage ;
+  kCutFlow.kActiveStart = now ;
+}
+
+CutFlow::Timer::~Timer() {
+  Stop() ;
+}
+
+void CutFlow::Timer::Stop(void) {
+  if( ! kIsRunning ) return ;
+  auto now = std::chrono::steady_clock::now() ;
+  kCutFlow.kStages[kCutFlow.kActiveStage].sum += std::chrono::duration<double>( now - kCutFlow.kActiveStart ).count() ;
+  // Resume the previous stage
+  kCutFlow.kActiveStage = kPreviousStage ;
+  kCutFlow.kActiveStart = now ;
+  kIsRunning = false ;
+}
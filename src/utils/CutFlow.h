@@ -0,0 +1,83 @@
+/**
+ * This class keeps track of the analysis cut-flow and of the time spent in each analysis stage
+ * The counters are updated with a few additions per event, so it can be left on in production
+ *
+ * Tables :
+ * - Cut-flow : number of events (and weighted sum) after each analysis step
+ * - Rejections : number of events (and weighted sum) rejected by each electron cut
+ *   Each event is assigned to the first cut that rejects it, in the order the cuts were added
+ * - Stages : exclusive time spent in each stage. Nested timers pause the enclosing stage
+ **/
+
+#ifndef _CUTFLOW_H_
+#define _CUTFLOW_H_
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <iostream>
+
+namespace e4nu {
+
+  // Analysis steps for the cut-flow table
+  enum CutFlowStep { kStepRead = 0, kStepElectronCuts, kStepParticleCuts, kStepSignal, kStepBackground, kNCutFlowSteps } ;
+
+  // Analysis stages for the timing table
+  enum AnalysisStage { kStageRead = 0, kStageEventCuts, kStageParticleCuts, kStageAcceptance,
+		       kStageClassification, kStageSubtraction, kStageFinalise, kNAnalysisStages } ;
+
+  class CutFlow {
+  public :
+    CutFlow() ;
+    virtual ~CutFlow() ;
+
+    // Returns the id of the new rejection counter
+    unsigned int AddRejection( const std::string name ) ;
+
+    void FillStep( const unsigned int step, const double weight ) { ++kSteps[step].n ; kSteps[step].sum += weight ; }
+    void FillRejection( const unsigned int id, const double weight ) { ++kRejections[id].n ; kRejections[id].sum += weight ; }
+
+    // Prints the tables in stdout
+    void Print(void) const ;
+    // Stores the tables as labeled histograms in the current directory
+    void Write(void) const ;
+
+    // Counters for the analysis checkpoints. The rejection counters must be created before ReadState
+    void WriteState( std::ostream & out ) const ;
+    bool ReadState( std::istream & in ) ;
+
+    // Timer for a given stage. The time is added when the timer is stopped or destroyed
+    class Timer {
+    public :
+      Timer( CutFlow & cut_flow, const unsigned int stage ) ;
+      ~Timer() ;
+      void Stop(void) ;
+    private :
+      CutFlow & kCutFlow ;
+      int kPreviousStage = -1 ;
+      bool kIsRunning = true ;
+    } ;
+
+  private :
+    struct Counter {
+      std::string name ;
+      unsigned long n = 0 ;
+      double sum = 0 ; // weighted sum or time in seconds
+    } ;
+
+    void PrintTable( const std::string title, const std::vector<Counter> & table, const std::string sum_tag ) const ;
+    void WriteTable( const std::string name, const std::vector<Counter> & table, const bool use_sum ) const ;
+    static void WriteCounters( std::ostream & out, const std::vector<Counter> & table ) ;
+    static bool ReadCounters( std::istream & in, std::vector<Counter> & table ) ;
+
+    std::vector<Counter> kSteps ;
+    std::vector<Counter> kRejections ;
+    std::vector<Counter> kStages ;
+
+    // Running stage
+    int kActiveStage = -1 ;
+    std::chrono::steady_clock::time_point kActiveStart ;
+  };
+}
+
+#endif
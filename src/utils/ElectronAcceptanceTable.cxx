@@ -0,0 +1,69 @@
+/**
+ * This class stores the fraction of the azimuthal orbit of an electron accepted by the electron fiducial cut
+ **/
+#include <algorithm>
+#include <cmath>
+#include "TMath.h"
+#include "utils/ElectronAcceptanceTable.h"
+#include "conf/ParticleI.h"
+
+using namespace e4nu ;
+
+ElectronAcceptanceTable::ElectronAcceptanceTable( const Fiducial * fiducial, const double EBeam, const bool is_data ) :
+  kFiducial( fiducial ), kEBeam( EBeam ), kIsData( is_data ) {
+  kTable.resize( kMomentumNodes * kThetaNodes, -1 ) ;
+}
+
+double ElectronAcceptanceTable::ComputeAcceptance( const double momentum, const double theta ) const {
+  // Middle of each phi bin, so that no point lies on a sector edge. Same components as TVector3::SetMagThetaPhi
+  double px[kPhiPoints], py[kPhiPoints], pz[kPhiPoints] ; 
+  bool is_detected[kPhiPoints] ; 
+  double perp = std::abs( momentum ) * std::sin( theta ) ; 
+  double z = std::abs( momentum ) * std::cos( theta ) ; 
+  for( unsigned int i = 0 ; i < kPhiPoints ; ++i ) { 
+    double phi = 2 * TMath::Pi() * ( i + 0.5 ) / kPhiPoints ; 
+    px[i] = perp * std::cos( phi ) ; 
+    py[i] = perp * std::sin( phi ) ; 
+    pz[i] = z ; 
+  }
+  kFiducial->FiducialCutBatch( conf::kPdgElectron, kEBeam, kPhiPoints, px, py, pz, is_detected, kIsData ) ; 
+
+  unsigned int n_detected = 0 ; 
+  for( unsigned int i = 0 ; i < kPhiPoints ; ++i ) if( is_detected[i] ) ++n_detected ; 
+  return n_detected / (double) kPhiPoints ; 
+}
+
+double ElectronAcceptanceTable::GetNode( const unsigned int mom_id, const unsigned int theta_id ) {
+  float & node = kTable[ mom_id * kThetaNodes + theta_id ] ; 
+  if( node < 0 ) { 
+    double momentum = kEBeam * mom_id / ( kMomentumNodes - 1 ) ; 
+    double theta = TMath::Pi() * theta_id / ( kThetaNodes - 1 ) ; 
+    node = ComputeAcceptance( momentum, theta ) ; 
+  }
+  return node ; 
+}
+
+double ElectronAcceptanceTable::GetAcceptance( const TVector3 & momentum ) {
+  if( !kFiducial || kEBeam <= 0 ) return 0 ; 
+
+  // Position in node units, clamped to the table
+  double x = std::min( std::max( momentum.Mag() / kEBeam, 0. ), 1. ) * ( kMomentumNodes - 1 ) ; 
+  double y = std::min( std::max( momentum.Theta() / TMath::Pi(), 0. ), 1. ) * ( kThetaNodes - 1 ) ; 
+  unsigned int mom_id = std::min( (unsigned int) x, kMomentumNodes - 2 ) ; 
+  unsigned int theta_id = std::min( (unsigned int) y, kThetaNodes - 2 ) ; 
+  double dx = x - mom_id ; 
+  double dy = y - theta_id ; 
+
+  std::lock_guard<std::mutex> lock( kMutex ) ; 
+  double n00 = GetNode( mom_id, theta_id ) ; 
+  double n10 = GetNode( mom_id + 1, theta_id ) ; 
+  double n01 = GetNode( mom_id, theta_id + 1 ) ; 
+  double n11 = GetNode( mom_id + 1, theta_id + 1 ) ; 
+
+  // Do not interpolate into the edge of the acceptance
+  if( n00 == 0 || n10 == 0 || n01 == 0 || n11 == 0 ) { 
+    if( dx < 0.5 ) return dy < 0.5 ? n00 : n01 ; 
+    return dy < 0.5 ? n10 : n11 ; 
+  }
+  return ( 1 - dx ) * ( 1 - dy ) * n00 + dx * ( 1 - dy ) * n10 + ( 1 - dx ) * dy * n01 + dx * dy * n11 ; 
+}
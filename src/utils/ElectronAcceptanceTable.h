@@ -0,0 +1,46 @@
+/**
+ * This class stores the fraction of the azimuthal orbit of an electron accepted by the electron fiducial cut
+ * For rotations around the beam axis, the acceptance only depends on the momentum and the polar angle,
+ * so the rotations of each electron are replaced by a lookup in a (p,theta) table
+ *
+ * The table is built for one beam energy and torus current (the ones of the Fiducial object). 
+ * Each node is computed the first time it is needed, scanning kPhiPoints azimuthal angles,
+ * and kept for the rest of the run. The acceptance is interpolated linearly between nodes
+ * Near the edges of the acceptance (momentum threshold, polar angle limits), some nodes are 0.
+ * There the value of the nearest node is used instead, so that the acceptance does not fall to small spurious values
+ **/
+
+#ifndef _ELECTRON_ACCEPTANCE_TABLE_H_
+#define _ELECTRON_ACCEPTANCE_TABLE_H_
+
+#include <vector>
+#include <mutex>
+#include "TVector3.h"
+#include "utils/Fiducial.h"
+
+namespace e4nu {
+
+  class ElectronAcceptanceTable {
+  public :
+    ElectronAcceptanceTable( const Fiducial * fiducial, const double EBeam, const bool is_data ) ;
+
+    // Accepted fraction of the rotations of momentum around the beam axis. It is thread safe
+    double GetAcceptance( const TVector3 & momentum ) ;
+
+    static const unsigned int kMomentumNodes = 201 ; // Between 0 and EBeam
+    static const unsigned int kThetaNodes = 361 ; // 0.5 degrees
+    static const unsigned int kPhiPoints = 720 ; // 0.5 degrees
+
+  private :
+    double GetNode( const unsigned int mom_id, const unsigned int theta_id ) ;
+    double ComputeAcceptance( const double momentum, const double theta ) const ;
+
+    const Fiducial * kFiducial = nullptr ;
+    double kEBeam = 0 ;
+    bool kIsData = false ;
+    std::vector<float> kTable ; // Negative until the node is computed
+    std::mutex kMutex ;
+  };
+}
+
+#endif
@@ -18,69 +18,54 @@ using namespace e4nu ;
 
 void Fiducial::InitPiMinusFit(const double beam_en)
 {
-  if (beam_en == 1.161) { myPiMinusFit = std::unique_ptr<TF1>(new TF1("myPiMinusFit","17.+4./TMath::Power(x,1.)",0,5.)); }
-  if (beam_en == 2.261) { myPiMinusFit = std::unique_ptr<TF1>(new TF1("myPiMinusFit","(x<0.35)*(25.+7./TMath::Power(x,1.)) + (x>0.35)*(16.+10/TMath::Power(x,1.))",0,5.)); }
-  if (beam_en == 4.461) { myPiMinusFit = std::unique_ptr<TF1>(new TF1("myPiMinusFit","(x<0.35)*(25.+7./TMath::Power(x,1.)) + (x>0.35)*(16.+10/TMath::Power(x,1.))",0,5.)); }
+  if (beam_en == 1.161) { fPiMinusFit = 1; }
+  if (beam_en == 2.261) { fPiMinusFit = 2; }
+  if (beam_en == 4.461) { fPiMinusFit = 2; }
+}
+
+double Fiducial::GetPiMinusThetaMin( const double mom ) const
+{
+  if (fPiMinusFit == 1) { return 17.+4./mom; }
+  if (fPiMinusFit == 2) { return (mom<0.35)*(25.+7./mom) + (mom>0.35)*(16.+10/mom); }
+  return 0;
 }
 
 void Fiducial::InitEClimits()
 {
-  up_lim1_ec =std::unique_ptr<TF1>( new TF1("up_lim1_ec","[0]+(x-[1])*(x-[1])*[2]",0,360));
-  up_lim2_ec =std::unique_ptr<TF1>( new TF1("up_lim2_ec","[0]+(x-[1])*(x-[1])*[2]",0,360));
-  up_lim3_ec =std::unique_ptr<TF1>( new TF1("up_lim3_ec","[0]+(x-[1])*(x-[1])*[2]",0,360));
-  up_lim4_ec =std::unique_ptr<TF1>( new TF1("up_lim4_ec","[0]+(x-[1])*(x-[1])*[2]",0,360));
-  up_lim5_ec =std::unique_ptr<TF1>( new TF1("up_lim5_ec","[0]+(x-[1])*(x-[1])*[2]",0,360));
-  up_lim6_ec =std::unique_ptr<TF1>( new TF1("up_lim6_ec","[0]+(x-[1])*(x-[1])*[2]",0,360));
-  low_lim1_ec=std::unique_ptr<TF1>( new TF1("low_lim1_ec","[0]+(x-[1])*(x-[1])*[2]",0,360));
-  low_lim2_ec=std::unique_ptr<TF1>( new TF1("low_lim2_ec","[0]+(x-[1])*(x-[1])*[2]",0,360));
-  low_lim3_ec=std::unique_ptr<TF1>( new TF1("low_lim3_ec","[0]+(x-[1])*(x-[1])*[2]",0,360));
-  low_lim4_ec=std::unique_ptr<TF1>( new TF1("low_lim4_ec","[0]+(x-[1])*(x-[1])*[2]",0,360));
-  low_lim5_ec=std::unique_ptr<TF1>( new TF1("low_lim5_ec","[0]+(x-[1])*(x-[1])*[2]",0,360));
-  low_lim6_ec=std::unique_ptr<TF1>( new TF1("low_lim6_ec","[0]+(x-[1])*(x-[1])*[2]",0,360));
-  rightside_lim1_ec=std::unique_ptr<TF1>( new TF1("rightside_lim1_ec","[0]*(x+[1])+[2]",0,360));
-  leftside_lim1_ec=std::unique_ptr<TF1>( new TF1("leftside_lim1_ec","[0]*(x+[1])+[2]",0,360));
-  rightside_lim2_ec=std::unique_ptr<TF1>( new TF1("rightside_lim2_ec","[0]*(x+[1])+[2]",0,360));
-  leftside_lim2_ec=std::unique_ptr<TF1>( new TF1("leftside_lim2_ec","[0]*(x+[1])+[2]",0,360));
-  rightside_lim3_ec=std::unique_ptr<TF1>( new TF1("rightside_lim3_ec","[0]*(x+[1])+[2]",0,360));
-  leftside_lim3_ec=std::unique_ptr<TF1>( new TF1("leftside_lim3_ec","[0]*(x+[1])+[2]",0,360));
-  rightside_lim4_ec=std::unique_ptr<TF1>( new TF1("rightside_lim4_ec","[0]*(x+[1])+[2]",0,360));
-  leftside_lim4_ec=std::unique_ptr<TF1>( new TF1("leftside_lim4_ec","[0]*(x+[1])+[2]",0,360));
-  rightside_lim5_ec=std::unique_ptr<TF1>( new TF1("rightside_lim5_ec","[0]*(x+[1])+[2]",0,360));
-  leftside_lim5_ec=std::unique_ptr<TF1>( new TF1("leftside_lim5_ec","[0]*(x+[1])+[2]",0,360));
-  rightside_lim6_ec=std::unique_ptr<TF1>( new TF1("rightside_lim6_ec","[0]*(x+[1])+[2]",0,360));
-  leftside_lim6_ec=std::unique_ptr<TF1>( new TF1("leftside_lim6_ec","[0]*(x+[1])+[2]",0,360));
-
-
-  up_lim1_ec->SetParameters(0.995,30,-0.0001);
-  up_lim2_ec->SetParameters(0.995,90,-0.0001);
-  up_lim3_ec->SetParameters(0.995,150,-0.0001);
-  up_lim4_ec->SetParameters(0.995,210,-0.0001);
-  up_lim5_ec->SetParameters(0.995,270,-0.0001);
-  up_lim6_ec->SetParameters(0.995,330,-0.0001);
-  low_lim1_ec->SetParameters(0.7,30,-0.00005);
-  low_lim2_ec->SetParameters(0.7,90,-0.00005);
-  low_lim3_ec->SetParameters(0.7,150,-0.00005);
-  low_lim4_ec->SetParameters(0.7,210,-0.00005);
-  low_lim5_ec->SetParameters(0.7,270,-0.00005);
-  low_lim6_ec->SetParameters(0.7,330,-0.00005);
-  leftside_lim1_ec->SetParameters(0.11,0,0.03);
-  rightside_lim1_ec->SetParameters(-0.11,-60,0.03);
-  leftside_lim2_ec->SetParameters(0.11,-60,0.03);
-  rightside_lim2_ec->SetParameters(-0.11,-120,0.03);
-  leftside_lim3_ec->SetParameters(0.11,-120,0.03);
-  rightside_lim3_ec->SetParameters(-0.11,-180,0.03);
-  leftside_lim4_ec->SetParameters(0.11,-180,0.03);
-  rightside_lim4_ec->SetParameters(-0.11,-240,0.03);
-  leftside_lim5_ec->SetParameters(0.11,-240,0.03);
-  rightside_lim5_ec->SetParameters(-0.11,-300,0.03);
-  leftside_lim6_ec->SetParameters(0.11,-300,0.03);
-  rightside_lim6_ec->SetParameters(-0.11,-360,0.03);
+  for (int sector = 0; sector < 6; sector++) {
+    double up[3] = {0.995, 30.+60*sector, -0.0001};
+    double low[3] = {0.7, 30.+60*sector, -0.00005};
+    double leftside[3] = {0.11, -60.*sector, 0.03};
+    double rightside[3] = {-0.11, -60.*(sector+1), 0.03};
+    for (int i = 0; i < 3; i++) {
+      up_lim_ec[sector][i] = up[i];
+      low_lim_ec[sector][i] = low[i];
+      leftside_lim_ec[sector][i] = leftside[i];
+      rightside_lim_ec[sector][i] = rightside[i];
+    }
+  }
+}
+
+void Fiducial::EnableGrid( const std::string cache_file ) {
+  fGrid = std::unique_ptr<FiducialGrid>( new FiducialGrid( this, en_beam, fTorusCurrent, cache_file ) ) ; 
 }
 
 void Fiducial::SetConstants(int in_TorusCurrent, int target_pdg, double in_en_beam) {
   fTorusCurrent = in_TorusCurrent;
   ftarget_pdg = target_pdg;
   en_beam = in_en_beam;
+  SetKernels() ;
+}
+
+void Fiducial::SetKernels(void) {
+  fKernels[kElectronKernel] = &Fiducial::EFiducialCut ;
+  if ( en_beam > 1. && en_beam < 2. && fTorusCurrent > 740 && fTorusCurrent < 1510) fKernels[kElectronKernel] = &Fiducial::EFiducialCut1GeV ;
+  else if ( en_beam > 2. && en_beam < 3. && fTorusCurrent > 2240 && fTorusCurrent < 2260) fKernels[kElectronKernel] = &Fiducial::EFiducialCut2GeV ;
+  else if ( en_beam > 4. && en_beam < 5. && fTorusCurrent > 2240 && fTorusCurrent < 2260) fKernels[kElectronKernel] = &Fiducial::EFiducialCut4GeV ;
+  fKernels[kProtonKernel] = &Fiducial::PFiducialCut ;
+  fKernels[kPiPlusKernel] = &Fiducial::PiPlusFiducialCut ;
+  fKernels[kPiMinusKernel] = &Fiducial::PiMinusFiducialCut ;
+  fKernels[kPhotonKernel] = &Fiducial::PhotonFiducialCut ;
 }
 
 bool Fiducial::SetFiducialCutParameters(double beam_en){
@@ -303,7 +288,16 @@ bool Fiducial::SetFiducialCutParameters(double beam_en){
 
     param_file.close();
 
-
+    // e- pol5 coefficients for the torus current, used by EFiducialCut1GeV
+    for(Int_t sector=0;sector<6;sector++) {
+      for(Int_t thetapar=0;thetapar<5;thetapar++) {
+	for(Int_t mompar=0;mompar<6;mompar++) {
+	  fgPar_1gev_Efid[sector][thetapar][mompar] = 0 ;
+	  if ( fTorusCurrent > 1490 && fTorusCurrent < 1510 ) fgPar_1gev_Efid[sector][thetapar][mompar] = fgPar_1gev_1500_Efid[sector][thetapar][mompar] ;
+	  else if ( fTorusCurrent > 740 && fTorusCurrent < 760 ) fgPar_1gev_Efid[sector][thetapar][mompar] = fgPar_1gev_750_Efid[sector][thetapar][mompar] ;
+	}
+      }
+    }
 
     //
     // reads FC parameters for 1.1GeV , p fiducial cut parameters at 1GeV
@@ -569,7 +563,7 @@ bool Fiducial::SetFiducialCutParameters(double beam_en){
   return true ; 
 }
 
-Bool_t Fiducial::GetEPhiLimits(double beam_en, Float_t momentum, Float_t theta, Int_t sector,Float_t *EPhiMin, Float_t *EPhiMax){
+Bool_t Fiducial::GetEPhiLimits(double beam_en, Float_t momentum, Float_t theta, Int_t sector,Float_t *EPhiMin, Float_t *EPhiMax) const{
   //Begin_Html
   /*</pre>
     Information for electron fiducial cut,
@@ -588,7 +582,6 @@ Bool_t Fiducial::GetEPhiLimits(double beam_en, Float_t momentum, Float_t theta,
     <pre>
   */
   //End_Html
-  std::string fbeam_en = std::to_string((int)(beam_en*1000));
   if (sector < 0 || sector > 5) return kFALSE;    // bad input
 
   if(beam_en>4. && beam_en<5. && fTorusCurrent>2240 && fTorusCurrent<2260){// 4.4GeV fiducial cuts by protopop@jlab.org
@@ -604,10 +597,10 @@ Bool_t Fiducial::GetEPhiLimits(double beam_en, Float_t momentum, Float_t theta,
 
     // calculates parameters of cut functions for this energy
     t0 = fgPar_4Gev_2250_Efid_t0_p[sector][0]/pow(momentum, fgPar_4Gev_2250_Efid_t0_p[sector][1]);
-    t1 = 0.; for(int k=0; k<6; k++) t1 += (fgPar_4Gev_2250_Efid_t1_p[sector][k]*pow(momentum, k));
+    t1 = 0.; for(int k=5; k>=0; k--) t1 = t1*momentum + fgPar_4Gev_2250_Efid_t1_p[sector][k];
     for(int l=0; l<2; l++){
-      b[l] = 0.; for(int k=0; k<6; k++) b[l] += (fgPar_4Gev_2250_Efid_b_p[sector][l][k]*pow(momentum, k));
-      a[l] = 0.; for(int k=0; k<6; k++) a[l] += (fgPar_4Gev_2250_Efid_a_p[sector][l][k]*pow(momentum, k));
+      b[l] = 0.; for(int k=5; k>=0; k--) b[l] = b[l]*momentum + fgPar_4Gev_2250_Efid_b_p[sector][l][k];
+      a[l] = 0.; for(int k=5; k>=0; k--) a[l] = a[l]*momentum + fgPar_4Gev_2250_Efid_a_p[sector][l][k];
     }
 
 
@@ -635,13 +628,76 @@ Bool_t Fiducial::GetEPhiLimits(double beam_en, Float_t momentum, Float_t theta,
 
 // --------------------------------------------------------------------------------------------------------------------------------------------------------
 
-Bool_t Fiducial::FiducialCut( const int pdg, const double beam_en, TVector3 momentum, const bool is_data ) {
+Bool_t Fiducial::FiducialCut( const int pdg, const double beam_en, TVector3 momentum, const bool is_data ) const {
   
   if( !is_data ) {
     // Electron fiducial cut, return kTRUE if pass or kFALSE if not
-    momentum.SetPhi( momentum.Phi() + TMath::Pi() ) ;
+    // phi + pi
+    momentum.SetXYZ( -momentum.X(), -momentum.Y(), momentum.Z() ) ;
+  }
+
+  if( fGrid && beam_en == fGrid->GetEBeam() ) { 
+    FiducialGrid::CellStatus status = fGrid->GetStatus( pdg, momentum ) ; 
+    if( status == FiducialGrid::kInside ) return kTRUE ; 
+    if( status == FiducialGrid::kOutside ) return kFALSE ; 
+  }
+  return DetectorFiducialCut( pdg, beam_en, momentum ) ; 
+}
+
+Fiducial::FiducialKernel Fiducial::GetKernel( const int pdg, const double beam_en ) const {
+  if ( beam_en != en_beam ) return nullptr ; 
+  if ( pdg == conf::kPdgElectron ) return fKernels[kElectronKernel] ; 
+  else if ( pdg == conf::kPdgProton ) return fKernels[kProtonKernel] ; 
+  else if ( pdg == conf::kPdgPiP ) return fKernels[kPiPlusKernel] ; 
+  else if ( pdg == conf::kPdgPiM ) return fKernels[kPiMinusKernel] ; 
+  else if ( pdg == conf::kPdgPhoton ) return fKernels[kPhotonKernel] ; 
+  return nullptr ; 
+}
+
+void Fiducial::FiducialCutBatch( const int pdg, const double beam_en, const unsigned int n, const double * px, const double * py, const double * pz,
+				 bool * out_mask, const bool is_data ) const {
+  std::vector<double> flip_x, flip_y ; 
+  if( !is_data ) {
+    // phi + pi, as in FiducialCut
+    flip_x.resize( n ) ; 
+    flip_y.resize( n ) ; 
+    for( unsigned int i = 0 ; i < n ; ++i ) flip_x[i] = -px[i] ; 
+    for( unsigned int i = 0 ; i < n ; ++i ) flip_y[i] = -py[i] ; 
+    px = flip_x.data() ; 
+    py = flip_y.data() ; 
+  }
+
+  if( !fGrid || beam_en != fGrid->GetEBeam() ) {
+    DetectorFiducialCutBatch( pdg, beam_en, n, px, py, pz, out_mask ) ; 
+    return ; 
   }
 
+  std::vector<unsigned char> status( n ) ; 
+  fGrid->GetStatus( pdg, n, px, py, pz, status.data() ) ; 
+  // The exact cut is only evaluated for the boundary cells
+  FiducialKernel kernel = GetKernel( pdg, beam_en ) ; 
+  for( unsigned int i = 0 ; i < n ; ++i ) {
+    if( status[i] == FiducialGrid::kInside ) out_mask[i] = true ; 
+    else if( status[i] == FiducialGrid::kOutside ) out_mask[i] = false ; 
+    else if( kernel ) out_mask[i] = (this->*kernel)( beam_en, TVector3( px[i], py[i], pz[i] ) ) ; 
+    else out_mask[i] = DetectorFiducialCut( pdg, beam_en, TVector3( px[i], py[i], pz[i] ) ) ; 
+  }
+}
+
+void Fiducial::DetectorFiducialCutBatch( const int pdg, const double beam_en, const unsigned int n, const double * px, const double * py, const double * pz,
+					 bool * out_mask ) const {
+  FiducialKernel kernel = GetKernel( pdg, beam_en ) ; 
+  if( kernel ) {
+    for( unsigned int i = 0 ; i < n ; ++i ) out_mask[i] = (this->*kernel)( beam_en, TVector3( px[i], py[i], pz[i] ) ) ; 
+  }
+  else {
+    for( unsigned int i = 0 ; i < n ; ++i ) out_mask[i] = DetectorFiducialCut( pdg, beam_en, TVector3( px[i], py[i], pz[i] ) ) ; 
+  }
+}
+
+Bool_t Fiducial::DetectorFiducialCut( const int pdg, const double beam_en, const TVector3 & momentum ) const {
+  FiducialKernel kernel = GetKernel( pdg, beam_en ) ; 
+  if ( kernel ) return (this->*kernel)( beam_en, momentum ) ; 
   if ( pdg == conf::kPdgElectron ) return EFiducialCut( beam_en, momentum ) ; 
   else if ( pdg == conf::kPdgProton ) return PFiducialCut( beam_en, momentum ) ; 
   else if ( pdg == conf::kPdgPiP ) return Pi_phot_fid_united( beam_en, momentum, 1 ) ; 
@@ -653,526 +709,524 @@ Bool_t Fiducial::FiducialCut( const int pdg, const double beam_en, TVector3 mome
 
 // --------------------------------------------------------------------------------------------------------------------------------------------------------
 
-Bool_t Fiducial::EFiducialCut(double beam_en, TVector3 momentum) {
+Bool_t Fiducial::EFiducialCut(double beam_en, TVector3 momentum) const {
+  // Kernel for the beam energy and torus current
+  if ( beam_en > 1. && beam_en < 2. && fTorusCurrent > 740 && fTorusCurrent < 1510) return EFiducialCut1GeV( beam_en, momentum ) ;
+  if ( beam_en > 2. && beam_en < 3. && fTorusCurrent > 2240 && fTorusCurrent < 2260) return EFiducialCut2GeV( beam_en, momentum ) ;
+  if ( beam_en > 4. && beam_en < 5. && fTorusCurrent > 2240 && fTorusCurrent < 2260) return EFiducialCut4GeV( beam_en, momentum ) ;
+  return kTRUE ;
+}
+
+// 1.1 GeV electron fiducials, 750 and 1500 torus field
+Bool_t Fiducial::EFiducialCut1GeV(double beam_en, TVector3 momentum) const {
 
   Bool_t status = kTRUE;
-  std::string fbeam_en = std::to_string((int)(beam_en*1000));
   bool SCpdcut = true;
 
-  // 1.1 GeV electron fiducials & 750 torus field
-  if ( beam_en > 1. && beam_en < 2. && fTorusCurrent > 740 && fTorusCurrent < 1510) {
-
-    Float_t mom = momentum.Mag();
-    Float_t phi = momentum.Phi() * 180. / TMath::Pi();
-    if (phi < -30.) phi += 360.;
-    Float_t theta = momentum.Theta() * 180. / TMath::Pi();
-    Int_t sector = (Int_t)((phi+30.)/60.);
-    if(sector < 0) sector = 0;
-    if(sector > 5) sector = 5; // to match array index
+  Float_t mom = momentum.Mag();
+  Float_t phi = momentum.Phi() * 180. / TMath::Pi();
+  if (phi < -30.) phi += 360.;
+  Float_t theta = momentum.Theta() * 180. / TMath::Pi();
+  Int_t sector = (Int_t)((phi+30.)/60.);
+  if(sector < 0) sector = 0;
+  if(sector > 5) sector = 5; // to match array index
+
+  phi -= sector * 60;
+  Double_t elmom = (momentum.Mag())*1000;
+  Double_t thetapars[5]={0,0,0,0,0};
+
+  // pol5 in elmom, with the coefficients for the torus current (see SetFiducialCutParameters)
+  for (Int_t thetapar = 0; thetapar < 5; thetapar++) {
+    for ( Int_t mompar = 5; mompar >= 0; mompar--) { thetapars[thetapar] = thetapars[thetapar]*elmom + fgPar_1gev_Efid[sector][thetapar][mompar]; }
+  }
 
-    phi -= sector * 60;
-    Double_t elmom = (momentum.Mag())*1000;
-    Double_t thetapars[5]={0,0,0,0,0};
+  Int_t uplow;
+  Double_t thetacutoff;
+  Float_t p_thetae = mom, thetamax_e = 0;
 
-    for ( Int_t mompar = 0; mompar < 6; mompar++) {
-      for (Int_t thetapar = 0; thetapar < 5; thetapar++) {
-	if ( (fTorusCurrent > 1490) && (fTorusCurrent < 1510) ) {
-	  // 1500A torus current
-	  thetapars[thetapar]+=fgPar_1gev_1500_Efid[sector][thetapar][mompar]*pow(elmom,mompar);
-	}
+  if (p_thetae > 1.05) { p_thetae = 1.05; }
+  else if (p_thetae < 0.4)  { p_thetae = 0.4; }
 
-	if ( (fTorusCurrent > 740) && (fTorusCurrent < 760) ) {
-	  // 750A torus current
-	  thetapars[thetapar]+=fgPar_1gev_750_Efid[sector][thetapar][mompar]*pow(elmom,mompar);
-	}
-      }
-    }
+  for (int i = 4; i >= 0;i--) { thetamax_e = thetamax_e*p_thetae + el_thetamax1[i]; }
 
-    Int_t uplow;
-    Double_t thetacutoff;
-    Float_t p_thetae = mom, thetamax_e = 0;
+  if (phi <= 0) {
+    uplow = 1;
+    thetacutoff = ((phi*(thetapars[0]-(thetapars[1]/thetapars[2])))+
+		   (double(uplow)*thetapars[2]*thetapars[0]))/(phi+(double(uplow)*thetapars[2]));
+  } else {
+    uplow = -1;
+    thetacutoff = ( (phi*(thetapars[0]-(thetapars[3]/thetapars[4]))) + (double(uplow)*thetapars[4]*thetapars[0]))/(phi+(double(uplow)*thetapars[4]) );
+  }
 
-    if (p_thetae > 1.05) { p_thetae = 1.05; }
-    else if (p_thetae < 0.4)  { p_thetae = 0.4; }
+  status = (theta>thetacutoff) && (thetacutoff>=thetapars[0]) && (elmom>300) && (elmom<=1100)  && theta<=thetamax_e;
 
-    for (int i = 4; i >= 0;i--) { thetamax_e = thetamax_e*p_thetae + el_thetamax1[i]; }
+  if (SCpdcut && (fTorusCurrent>1490) && (fTorusCurrent<1510) ) {  // if the SCpdCut bit is set, take off the bad SC paddle by strictly cutting off a theta gap.
 
-    if (phi <= 0) {
-      uplow = 1;
-      thetacutoff = ((phi*(thetapars[0]-(thetapars[1]/thetapars[2])))+
-		     (double(uplow)*thetapars[2]*thetapars[0]))/(phi+(double(uplow)*thetapars[2]));
-    } else {
-      uplow = -1;
-      thetacutoff = ( (phi*(thetapars[0]-(thetapars[3]/thetapars[4]))) + (double(uplow)*thetapars[4]*thetapars[0]))/(phi+(double(uplow)*thetapars[4]) );
-    }
+    if (status) {
 
-    status = (theta>thetacutoff) && (thetacutoff>=thetapars[0]) && (elmom>300) && (elmom<=1100)  && theta<=thetamax_e;
+      int tsector = sector + 1;
 
-    if (SCpdcut && (fTorusCurrent>1490) && (fTorusCurrent<1510) ) {  // if the SCpdCut bit is set, take off the bad SC paddle by strictly cutting off a theta gap.
-        
-      if (status) {
+      // sector 3 has two bad paddles
 
-	int tsector = sector + 1;
+      if (tsector == 3) {
 
-	// sector 3 has two bad paddles
+	float badpar3[4]; // 4 parameters to determine the positions of the two theta gaps
 
-	if (tsector == 3) {
-
-	  float badpar3[4]; // 4 parameters to determine the positions of the two theta gaps
+	for (int i = 0; i < 4; i++) {
 
-	  for (int i = 0; i < 4; i++) {
+	  badpar3[i] = 0;
 
-	    badpar3[i] = 0;
+	  // calculate the parameters using pol7
 
-	    // calculate the parameters using pol7
+	  for (int d=7; d>=0; d--) { badpar3[i] = badpar3[i]*mom + fgPar_1gev_1500_Efid_Theta_S3[i][d]; }
 
-	    for (int d=7; d>=0; d--) { badpar3[i] = badpar3[i]*mom + fgPar_1gev_1500_Efid_Theta_S3[i][d]; }
-					
-	  }
+	}
 
-	  for (int ipar = 0; ipar < 2;ipar++) { status = status && !(theta>badpar3[2*ipar] && theta<badpar3[2*ipar+1]); }
+	for (int ipar = 0; ipar < 2;ipar++) { status = status && !(theta>badpar3[2*ipar] && theta<badpar3[2*ipar+1]); }
 
-	}
+      }
 
-	// sector 4 has one bad paddle
+      // sector 4 has one bad paddle
 
-	else if (tsector == 4) {
+      else if (tsector == 4) {
 
-	  float badpar4[2]; // 2 parameters to determine the position of the theta gap
-		    
-	  for (int i = 0; i < 2; i++) {
+	float badpar4[2]; // 2 parameters to determine the position of the theta gap
 
-	    badpar4[i] = 0;
+	for (int i = 0; i < 2; i++) {
 
-	    // calculate the parameters using pol7
+	  badpar4[i] = 0;
 
-	    for (int d=7; d>=0; d--) { badpar4[i] = badpar4[i]*mom + fgPar_1gev_1500_Efid_Theta_S4[i][d]; }
-		    
-	  }
+	  // calculate the parameters using pol7
 
-	  status = !(theta>badpar4[0] && theta<badpar4[1]);
+	  for (int d=7; d>=0; d--) { badpar4[i] = badpar4[i]*mom + fgPar_1gev_1500_Efid_Theta_S4[i][d]; }
 
 	}
 
-	// sector 5 has four bad paddles
+	status = !(theta>badpar4[0] && theta<badpar4[1]);
 
-	else if (tsector == 5) {
+      }
 
-	  Float_t badpar5[8]; // 8 parameters to determine the positions of the four theta gaps
+      // sector 5 has four bad paddles
 
-	  for (Int_t i = 0; i < 8; i++) {
+      else if (tsector == 5) {
 
-	    badpar5[i] = 0;
+	Float_t badpar5[8]; // 8 parameters to determine the positions of the four theta gaps
 
-	    // calculate the parameters using pol7
+	for (Int_t i = 0; i < 8; i++) {
 
-	    for (Int_t d = 7; d >= 0; d--) { badpar5[i] = badpar5[i]*mom + fgPar_1gev_1500_Efid_Theta_S5[i][d]; }
+	  badpar5[i] = 0;
 
-	  }
+	  // calculate the parameters using pol7
+
+	  for (Int_t d = 7; d >= 0; d--) { badpar5[i] = badpar5[i]*mom + fgPar_1gev_1500_Efid_Theta_S5[i][d]; }
 
-	  if (mom < 1.25) { badpar5[0] = 23.4 * 1500 / 2250; }
+	}
 
-	  if (mom < 1.27) { badpar5[1] = 24.0 * 1500 / 2250; } // some dummy constants. see fiducial cuts webpage.
+	if (mom < 1.25) { badpar5[0] = 23.4 * 1500 / 2250; }
 
-	  for (Int_t ip = 0; ip < 4; ip++) { status = status && !(theta>badpar5[2*ip] && theta<badpar5[2*ip+1]); }
+	if (mom < 1.27) { badpar5[1] = 24.0 * 1500 / 2250; } // some dummy constants. see fiducial cuts webpage.
 
-	}
+	for (Int_t ip = 0; ip < 4; ip++) { status = status && !(theta>badpar5[2*ip] && theta<badpar5[2*ip+1]); }
 
       }
+
     }
+  }
 
-    if (SCpdcut && (fTorusCurrent>740) && (fTorusCurrent<760) ) {  // if the SCpdCut bit is set, take off the bad SC paddle by strictly cutting off a theta gap.
+  if (SCpdcut && (fTorusCurrent>740) && (fTorusCurrent<760) ) {  // if the SCpdCut bit is set, take off the bad SC paddle by strictly cutting off a theta gap.
 
-      if (status) {
+    if (status) {
 
-	int tsector = sector + 1;
-	mom = momentum.Mag();
+      int tsector = sector + 1;
+      mom = momentum.Mag();
 
-	//sector 2 has one gap
+      //sector 2 has one gap
 
-	if (tsector == 2) {
+      if (tsector == 2) {
 
-	  double parsec2_l, parsec2_h;
-	  if (mom < 0.4) mom = 0.4;
-	  parsec2_l = fid_1gev_750_efid_S2[0][0]+fid_1gev_750_efid_S2[0][1]/mom +fid_1gev_750_efid_S2[0][2]/(mom*mom) +fid_1gev_750_efid_S2[0][3]/(mom*mom*mom);
-	  parsec2_h = fid_1gev_750_efid_S2[1][0]+fid_1gev_750_efid_S2[1][1]/mom +fid_1gev_750_efid_S2[1][2]/(mom*mom) +fid_1gev_750_efid_S2[1][3]/(mom*mom*mom);
-	  status=status && !(theta>parsec2_l && theta<parsec2_h);
+	double parsec2_l, parsec2_h;
+	if (mom < 0.4) mom = 0.4;
+	parsec2_l = fid_1gev_750_efid_S2[0][0]+fid_1gev_750_efid_S2[0][1]/mom +fid_1gev_750_efid_S2[0][2]/(mom*mom) +fid_1gev_750_efid_S2[0][3]/(mom*mom*mom);
+	parsec2_h = fid_1gev_750_efid_S2[1][0]+fid_1gev_750_efid_S2[1][1]/mom +fid_1gev_750_efid_S2[1][2]/(mom*mom) +fid_1gev_750_efid_S2[1][3]/(mom*mom*mom);
+	status=status && !(theta>parsec2_l && theta<parsec2_h);
 
-	}
+      }
 
-	// sector 3 has four gaps, the last two appear only at low momenta (p<0.3) and affect only pimi
-		  
-	if (tsector == 3) {
+      // sector 3 has four gaps, the last two appear only at low momenta (p<0.3) and affect only pimi
 
-	  double parsec3_l[4],parsec3_h[4];
-		    
-	  for (int d = 0; d < 4; d++) {
+      if (tsector == 3) {
 
-	    mom = momentum.Mag();
-	    if ( (d==2 || d==3) && mom>0.3 ) { mom = 0.3; }
-	    else if ( d < 2 && mom < 0.4) { mom = 0.4; }
-	    parsec3_l[d] = fid_1gev_750_efid_S3[d][0][0]+fid_1gev_750_efid_S3[d][0][1]/mom +fid_1gev_750_efid_S3[d][0][2]/(mom*mom) +fid_1gev_750_efid_S3[d][0][3]/(mom*mom*mom);
-	    parsec3_h[d]= fid_1gev_750_efid_S3[d][1][0]+fid_1gev_750_efid_S3[d][1][1]/mom +fid_1gev_750_efid_S3[d][1][2]/(mom*mom) +fid_1gev_750_efid_S3[d][1][3]/(mom*mom*mom);
-	    status=status && !(theta>parsec3_l[d] && theta<parsec3_h[d]);
-		    
-	  }
+	double parsec3_l[4],parsec3_h[4];
+
+	for (int d = 0; d < 4; d++) {
+
+	  mom = momentum.Mag();
+	  if ( (d==2 || d==3) && mom>0.3 ) { mom = 0.3; }
+	  else if ( d < 2 && mom < 0.4) { mom = 0.4; }
+	  parsec3_l[d] = fid_1gev_750_efid_S3[d][0][0]+fid_1gev_750_efid_S3[d][0][1]/mom +fid_1gev_750_efid_S3[d][0][2]/(mom*mom) +fid_1gev_750_efid_S3[d][0][3]/(mom*mom*mom);
+	  parsec3_h[d]= fid_1gev_750_efid_S3[d][1][0]+fid_1gev_750_efid_S3[d][1][1]/mom +fid_1gev_750_efid_S3[d][1][2]/(mom*mom) +fid_1gev_750_efid_S3[d][1][3]/(mom*mom*mom);
+	  status=status && !(theta>parsec3_l[d] && theta<parsec3_h[d]);
 
 	}
 
-	//sector 4 has two gaps , second gap appears only at p<0.3 and theta>105 and affects only pimi
-			  
-	else if (tsector == 4) {
+      }
 
-	  double parsec4_l[2],parsec4_h[2];
-			    
-	  for (int d = 0; d < 2;d++) {
+      //sector 4 has two gaps , second gap appears only at p<0.3 and theta>105 and affects only pimi
 
-	    mom = momentum.Mag();
-	    if( d == 0 && mom < 0.775 ) { mom = 0.775; }
-	    else if ( d == 1 && mom > 0.3 ) { mom = 0.3; }
-	    parsec4_l[d] = fid_1gev_750_efid_S4[d][0][0]+fid_1gev_750_efid_S4[d][0][1]/mom +fid_1gev_750_efid_S4[d][0][2]/(mom*mom) +fid_1gev_750_efid_S4[d][0][3]/(mom*mom*mom);
-	    parsec4_h[d] = fid_1gev_750_efid_S4[d][1][0]+fid_1gev_750_efid_S4[d][1][1]/mom +fid_1gev_750_efid_S4[d][1][2]/(mom*mom) +fid_1gev_750_efid_S4[d][1][3]/(mom*mom*mom);
-	    status=status && !(theta>parsec4_l[d] && theta<parsec4_h[d]);
-			    
-	  }
+      else if (tsector == 4) {
+
+	double parsec4_l[2],parsec4_h[2];
+
+	for (int d = 0; d < 2;d++) {
+
+	  mom = momentum.Mag();
+	  if( d == 0 && mom < 0.775 ) { mom = 0.775; }
+	  else if ( d == 1 && mom > 0.3 ) { mom = 0.3; }
+	  parsec4_l[d] = fid_1gev_750_efid_S4[d][0][0]+fid_1gev_750_efid_S4[d][0][1]/mom +fid_1gev_750_efid_S4[d][0][2]/(mom*mom) +fid_1gev_750_efid_S4[d][0][3]/(mom*mom*mom);
+	  parsec4_h[d] = fid_1gev_750_efid_S4[d][1][0]+fid_1gev_750_efid_S4[d][1][1]/mom +fid_1gev_750_efid_S4[d][1][2]/(mom*mom) +fid_1gev_750_efid_S4[d][1][3]/(mom*mom*mom);
+	  status=status && !(theta>parsec4_l[d] && theta<parsec4_h[d]);
 
 	}
 
-	//sector 5 has three gaps
+      }
 
-	else if (tsector == 5) {
+      //sector 5 has three gaps
 
-	  double parsec5_l[3],parsec5_h[3];
-			    
-	  for (int d = 0; d < 3; d++ ) {
+      else if (tsector == 5) {
 
-	    mom = momentum.Mag();
-	    if ( d == 0 && mom > 0.3) { mom = 0.3; } //first one shows up only for pimi at p<0.3 and theta~128
-	    else if ( d > 0 && mom < 0.5 ) { mom = 0.5; }
-	    parsec5_l[d] = fid_1gev_750_efid_S5[d][0][0]+fid_1gev_750_efid_S5[d][0][1]/mom +fid_1gev_750_efid_S5[d][0][2]/(mom*mom) +fid_1gev_750_efid_S5[d][0][3]/(mom*mom*mom);
-	    parsec5_h[d] = fid_1gev_750_efid_S5[d][1][0]+fid_1gev_750_efid_S5[d][1][1]/mom +fid_1gev_750_efid_S5[d][1][2]/(mom*mom) +fid_1gev_750_efid_S5[d][1][3]/(mom*mom*mom);
-	    status=status && !(theta>parsec5_l[d] && theta<parsec5_h[d]);
-	  }
+	double parsec5_l[3],parsec5_h[3];
+
+	for (int d = 0; d < 3; d++ ) {
+
+	  mom = momentum.Mag();
+	  if ( d == 0 && mom > 0.3) { mom = 0.3; } //first one shows up only for pimi at p<0.3 and theta~128
+	  else if ( d > 0 && mom < 0.5 ) { mom = 0.5; }
+	  parsec5_l[d] = fid_1gev_750_efid_S5[d][0][0]+fid_1gev_750_efid_S5[d][0][1]/mom +fid_1gev_750_efid_S5[d][0][2]/(mom*mom) +fid_1gev_750_efid_S5[d][0][3]/(mom*mom*mom);
+	  parsec5_h[d] = fid_1gev_750_efid_S5[d][1][0]+fid_1gev_750_efid_S5[d][1][1]/mom +fid_1gev_750_efid_S5[d][1][2]/(mom*mom) +fid_1gev_750_efid_S5[d][1][3]/(mom*mom*mom);
+	  status=status && !(theta>parsec5_l[d] && theta<parsec5_h[d]);
 	}
       }
     }
-    return status;
   }
+  return status;
+}
 
-  // -------------------------------------------------------------------------------------------------
-  // 2GeV fiducials
-  if ( beam_en > 2. &&  beam_en < 3. && fTorusCurrent > 2240 && fTorusCurrent < 2260) {
-    Float_t phi = momentum.Phi() * 180. / TMath::Pi();
-    if ( phi < -30. ) { phi += 360.; }
-    Int_t sector = (Int_t)( (phi+30.) / 60.);
-    if ( sector < 0 ) { sector = 0; }
-    if ( sector > 5 ) { sector = 5; }
-    phi -= sector*60;
-    Float_t theta = momentum.Theta() * 180./TMath::Pi();
-    Float_t mom = momentum.Mag();
-    Float_t par[6];  // six parameters to determine the outline of Theta vs Phi
+// 2GeV electron fiducials
+Bool_t Fiducial::EFiducialCut2GeV(double beam_en, TVector3 momentum) const {
 
-    for (Int_t i = 0; i < 6; i++ ) {
+  Bool_t status = kTRUE;
+  bool SCpdcut = true;
 
-      par[i] = 0;
+  Float_t phi = momentum.Phi() * 180. / TMath::Pi();
+  if ( phi < -30. ) { phi += 360.; }
+  Int_t sector = (Int_t)( (phi+30.) / 60.);
+  if ( sector < 0 ) { sector = 0; }
+  if ( sector > 5 ) { sector = 5; }
+  phi -= sector*60;
+  Float_t theta = momentum.Theta() * 180./TMath::Pi();
+  Float_t mom = momentum.Mag();
+  Float_t par[6];  // six parameters to determine the outline of Theta vs Phi
 
-      for (Int_t d = 8; d >= 0; d--) {
+  for (Int_t i = 0; i < 6; i++ ) {
 
-	par[i] = par[i]*mom + fgPar_2GeV_2250_Efid[sector][i][d];
+    par[i] = 0;
 
-      } // calculate the parameters using pol8
+    for (Int_t d = 8; d >= 0; d--) {
 
-    }
+      par[i] = par[i]*mom + fgPar_2GeV_2250_Efid[sector][i][d];
 
-    if (phi < 0) {
+    } // calculate the parameters using pol8
 
-      Float_t tmptheta = par[0] - par[3]/par[2] + par[3]/(par[2]+phi);
-      status = (theta > tmptheta && tmptheta>=par[0] && theta<par[1]);
+  }
 
-    } else {
+  if (phi < 0) {
 
-      Float_t tmptheta = par[0] - par[5]/par[4] + par[5]/(par[4]-phi);
-      status = (theta>tmptheta && tmptheta>=par[0] && theta<par[1]);
+    Float_t tmptheta = par[0] - par[3]/par[2] + par[3]/(par[2]+phi);
+    status = (theta > tmptheta && tmptheta>=par[0] && theta<par[1]);
 
-    }
+  } else {
 
-    // by now, we have checked if the electron is within the outline of theta vs phi plot
+    Float_t tmptheta = par[0] - par[5]/par[4] + par[5]/(par[4]-phi);
+    status = (theta>tmptheta && tmptheta>=par[0] && theta<par[1]);
 
-    if (SCpdcut) { // if the kESCpdCut bit is set, take off the bad SC paddle by strictly cutting off a theta gap
+  }
 
-      if (status) {
+  // by now, we have checked if the electron is within the outline of theta vs phi plot
 
-	Int_t tsector = sector + 1;
+  if (SCpdcut) { // if the kESCpdCut bit is set, take off the bad SC paddle by strictly cutting off a theta gap
 
-	if (tsector == 3) { // sector 3 has two bad paddles
+    if (status) {
 
-	  Float_t badpar3[4]; // 4 parameters to determine the positions of the two theta gaps
+      Int_t tsector = sector + 1;
 
-	  for (Int_t i = 0; i < 4; i++) {
+      if (tsector == 3) { // sector 3 has two bad paddles
 
-	    badpar3[i] = 0;
+	Float_t badpar3[4]; // 4 parameters to determine the positions of the two theta gaps
 
-	    for (Int_t d = 7; d >= 0; d--) {
+	for (Int_t i = 0; i < 4; i++) {
 
-	      badpar3[i] = badpar3[i]*mom +  fgPar_2GeV_2250_EfidTheta_S3[i][d];
+	  badpar3[i] = 0;
 
-	    } // calculate the parameters using pol7
+	  for (Int_t d = 7; d >= 0; d--) {
 
-	  }
+	    badpar3[i] = badpar3[i]*mom +  fgPar_2GeV_2250_EfidTheta_S3[i][d];
 
-	  for (Int_t ipar = 0; ipar < 2; ipar++ ) { status = status && !(theta>badpar3[2*ipar] && theta<badpar3[2*ipar+1]); }
+	  } // calculate the parameters using pol7
 
 	}
 
-	else if (tsector == 4) { // sector 4 has one bad paddle
+	for (Int_t ipar = 0; ipar < 2; ipar++ ) { status = status && !(theta>badpar3[2*ipar] && theta<badpar3[2*ipar+1]); }
 
-	  Float_t badpar4[2]; // 2 parameters to determine the position of the theta gap
+      }
 
-	  for ( Int_t i = 0; i < 2; i++) {
+      else if (tsector == 4) { // sector 4 has one bad paddle
 
-	    badpar4[i] = 0;
+	Float_t badpar4[2]; // 2 parameters to determine the position of the theta gap
 
-	    for (Int_t d = 7; d >= 0; d--) {
+	for ( Int_t i = 0; i < 2; i++) {
 
-	      badpar4[i] = badpar4[i]*mom +  fgPar_2GeV_2250_EfidTheta_S4[i][d];
+	  badpar4[i] = 0;
 
-	    }  // calculate the parameters using pol7
+	  for (Int_t d = 7; d >= 0; d--) {
 
-	  }
+	    badpar4[i] = badpar4[i]*mom +  fgPar_2GeV_2250_EfidTheta_S4[i][d];
 
-	  status = !(theta>badpar4[0] && theta<badpar4[1]);
+	  }  // calculate the parameters using pol7
 
 	}
 
-	else if (tsector == 5) { // sector 5 has four bad paddles
+	status = !(theta>badpar4[0] && theta<badpar4[1]);
 
-	  Float_t badpar5[8];  // 8 parameters to determine the positions of the four theta gaps
+      }
 
-	  for (Int_t i = 0; i < 8; i++) {
+      else if (tsector == 5) { // sector 5 has four bad paddles
 
-	    badpar5[i] = 0;
+	Float_t badpar5[8];  // 8 parameters to determine the positions of the four theta gaps
 
-	    for (Int_t d = 7; d >= 0; d--) {
+	for (Int_t i = 0; i < 8; i++) {
 
-	      badpar5[i] = badpar5[i]*mom +  fgPar_2GeV_2250_EfidTheta_S5[i][d];
+	  badpar5[i] = 0;
 
-	    } // calculate the parameters using pol7
+	  for (Int_t d = 7; d >= 0; d--) {
 
-	  }
+	    badpar5[i] = badpar5[i]*mom +  fgPar_2GeV_2250_EfidTheta_S5[i][d];
 
-	  if (mom<1.25) badpar5[0] = 23.4;
-	  if (mom<1.27) badpar5[1] = 24.0; // some dummy constants. see fiducial cuts webpage.
+	  } // calculate the parameters using pol7
 
-	  for(Int_t ipar = 0; ipar < 4; ipar++) { status = status && !(theta>badpar5[2*ipar] && theta<badpar5[2*ipar+1]); }
 	}
+
+	if (mom<1.25) badpar5[0] = 23.4;
+	if (mom<1.27) badpar5[1] = 24.0; // some dummy constants. see fiducial cuts webpage.
+
+	for(Int_t ipar = 0; ipar < 4; ipar++) { status = status && !(theta>badpar5[2*ipar] && theta<badpar5[2*ipar+1]); }
       }
     }
   }
-  // ------------------------------------------------------------------------------------------------
-  // 4GeV electron fiducials
-  if ( beam_en > 4. && beam_en < 5. && fTorusCurrent > 2240 && fTorusCurrent < 2260) {
-
-    //		//Begin_Html
-    //		</pre>
-    //		Electron fiducial cut, return kTRUE if the electron is in the fiducial volume
-    //		modified 14 May 2001 lbw
-    //		Now calls GetEPhiLimits for 2.2 and 4.4 GeV
-    //		tested against EFiducialCut for both 2.2 (with and without bad scintillator cuts) and 4.4 GeV
-    //		discrepancy less than 2 in 10^6 events
-    //		Please refer to <A HREF="http://www.jlab.org/Hall-B/secure/e2/bzh/efiducialcut.html">Electron Fiducial Cuts</A> -- Bin Zhang (MIT).
-    //		For 4.4GeV please refer to <A HREF="http://einstein.unh.edu/protopop/FiducialCuts/fc4E2.html">Fiducial Cuts</A> -- D.Protopopescu (UNH)
-    //		Please refer to <a href="http://www.jlab.org/Hall-B/secure/e2/stevenmc/FiducialCuts/index.html">1.1 GeV fiducial cuts</a> -- Steven McLauchlan (GU).
-    //		<pre>
-    //		//End_Html
-
-    Float_t phiMin, phiMax;
-    Float_t mom = momentum.Mag();
-    Float_t phi = momentum.Phi()*180./TMath::Pi();
-    if(phi<-30.) phi += 360.;
-    Float_t theta = momentum.Theta()*180./TMath::Pi();
-    Int_t  sector = (Int_t)((phi+30.)/60.);
-    if(sector < 0) sector = 0;
-    if(sector > 5) sector = 5; // to match array index
-    // all the work is now done in GetEPhiLimits
-
-    status = GetEPhiLimits(beam_en,mom, theta, sector, &phiMin, &phiMax);
 
-    if (status) {
-      status = status && (phi > phiMin) && (phi < phiMax);
-    }
+  return status;
+}
 
-    if(mom <= 2.0) {
+// 4GeV electron fiducials
+Bool_t Fiducial::EFiducialCut4GeV(double beam_en, TVector3 momentum) const {
 
-      SCpdcut = true;
+  Bool_t status = kTRUE;
+  bool SCpdcut = true;
 
-      if (SCpdcut) {  // if the SCpdCut bit is set, take off the bad SC paddle by strictly cutting off a theta gap.
+  //		//Begin_Html
+  //		</pre>
+  //		Electron fiducial cut, return kTRUE if the electron is in the fiducial volume
+  //		modified 14 May 2001 lbw
+  //		Now calls GetEPhiLimits for 2.2 and 4.4 GeV
+  //		tested against EFiducialCut for both 2.2 (with and without bad scintillator cuts) and 4.4 GeV
+  //		discrepancy less than 2 in 10^6 events
+  //		Please refer to <A HREF="http://www.jlab.org/Hall-B/secure/e2/bzh/efiducialcut.html">Electron Fiducial Cuts</A> -- Bin Zhang (MIT).
+  //		For 4.4GeV please refer to <A HREF="http://einstein.unh.edu/protopop/FiducialCuts/fc4E2.html">Fiducial Cuts</A> -- D.Protopopescu (UNH)
+  //		Please refer to <a href="http://www.jlab.org/Hall-B/secure/e2/stevenmc/FiducialCuts/index.html">1.1 GeV fiducial cuts</a> -- Steven McLauchlan (GU).
+  //		<pre>
+  //		//End_Html
+
+  Float_t phiMin, phiMax;
+  Float_t mom = momentum.Mag();
+  Float_t phi = momentum.Phi()*180./TMath::Pi();
+  if(phi<-30.) phi += 360.;
+  Float_t theta = momentum.Theta()*180./TMath::Pi();
+  Int_t  sector = (Int_t)((phi+30.)/60.);
+  if(sector < 0) sector = 0;
+  if(sector > 5) sector = 5; // to match array index
+  // all the work is now done in GetEPhiLimits
+
+  status = GetEPhiLimits(beam_en,mom, theta, sector, &phiMin, &phiMax);
+
+  if (status) {
+    status = status && (phi > phiMin) && (phi < phiMax);
+  }
 
-	if (status) {
+  if(mom <= 2.0) {
 
-	  int tsector = sector + 1;
+    SCpdcut = true;
 
-	  // sector 3 has two bad paddles
+    if (SCpdcut) {  // if the SCpdCut bit is set, take off the bad SC paddle by strictly cutting off a theta gap.
 
-	  if (tsector == 3) {
+      if (status) {
 
-	    float badpar3[4]; // 4 parameters to determine the positions of the two theta gaps
+	int tsector = sector + 1;
 
-	    for (int i = 0; i < 4; i++) {
+	// sector 3 has two bad paddles
 
-	      badpar3[i] = 0;
+	if (tsector == 3) {
 
-	      // calculate the parameters using pol7
+	  float badpar3[4]; // 4 parameters to determine the positions of the two theta gaps
 
-	      for (int d = 7; d >= 0; d-- ) { badpar3[i] = badpar3[i]*mom + fgPar_4Gev_2250_Efid_Theta_S3[i][d]; }
+	  for (int i = 0; i < 4; i++) {
 
-	    }
+	    badpar3[i] = 0;
 
-	    for(int ipar=0;ipar<2;ipar++) { status = status && !(theta>badpar3[2*ipar] && theta<badpar3[2*ipar+1]); }
+	    // calculate the parameters using pol7
+
+	    for (int d = 7; d >= 0; d-- ) { badpar3[i] = badpar3[i]*mom + fgPar_4Gev_2250_Efid_Theta_S3[i][d]; }
 
 	  }
 
-	  // sector 4 has one bad paddle
+	  for(int ipar=0;ipar<2;ipar++) { status = status && !(theta>badpar3[2*ipar] && theta<badpar3[2*ipar+1]); }
 
-	  else if ( tsector == 4) {
+	}
 
-	    float badpar4[2]; // 2 parameters to determine the position of the theta gap
+	// sector 4 has one bad paddle
 
-	    for (int i = 0; i < 2; i++) {
+	else if ( tsector == 4) {
 
-	      badpar4[i] = 0;
+	  float badpar4[2]; // 2 parameters to determine the position of the theta gap
 
-	      // calculate the parameters using pol7
+	  for (int i = 0; i < 2; i++) {
 
-	      for (int d = 7; d >= 0; d--) { badpar4[i] = badpar4[i]*mom + fgPar_4Gev_2250_Efid_Theta_S4[i][d]; }
+	    badpar4[i] = 0;
 
-	    }
+	    // calculate the parameters using pol7
 
-	    status = !(theta>badpar4[0] && theta<badpar4[1]);
+	    for (int d = 7; d >= 0; d--) { badpar4[i] = badpar4[i]*mom + fgPar_4Gev_2250_Efid_Theta_S4[i][d]; }
 
 	  }
 
-	  // sector 5 has four bad paddles
+	  status = !(theta>badpar4[0] && theta<badpar4[1]);
 
-	  else if (tsector == 5) {
+	}
 
-	    Float_t badpar5[8]; // 8 parameters to determine the positions of the four theta gaps
+	// sector 5 has four bad paddles
 
-	    for (Int_t i = 0; i < 8; i++) {
+	else if (tsector == 5) {
 
-	      badpar5[i] = 0;
+	  Float_t badpar5[8]; // 8 parameters to determine the positions of the four theta gaps
 
-	      // calculate the parameters using pol7
+	  for (Int_t i = 0; i < 8; i++) {
 
-	      for (Int_t d = 7; d >= 0; d--) { badpar5[i] = badpar5[i]*mom + fgPar_4Gev_2250_Efid_Theta_S5[i][d];}
-			
-	    }
+	    badpar5[i] = 0;
+
+	    // calculate the parameters using pol7
 
-	    if (mom<1.25) badpar5[0] = 23.4;
-	    if (mom<1.27) badpar5[1] = 24.0; // some dummy constants. see fiducial cuts webpage.
-			
-	    for (Int_t ipar = 0; ipar < 4; ipar++) { status = status && !(theta>badpar5[2*ipar] && theta<badpar5[2*ipar+1]); }
+	    for (Int_t d = 7; d >= 0; d--) { badpar5[i] = badpar5[i]*mom + fgPar_4Gev_2250_Efid_Theta_S5[i][d];}
 
 	  }
 
+	  if (mom<1.25) badpar5[0] = 23.4;
+	  if (mom<1.27) badpar5[1] = 24.0; // some dummy constants. see fiducial cuts webpage.
+
+	  for (Int_t ipar = 0; ipar < 4; ipar++) { status = status && !(theta>badpar5[2*ipar] && theta<badpar5[2*ipar+1]); }
+
 	}
 
       }
 
-      return (status && (phi < phiMax) && (phi>phiMin));
+    }
 
-    } else {
+    return (status && (phi < phiMax) && (phi>phiMin));
 
-      SCpdcut = true;
-			
-      if (SCpdcut) { // if the SCpdCut bit is set, take off the bad SC paddle by strictly cutting off a theta gap.
+  } else {
 
-	if (status) {
+    SCpdcut = true;
 
-	  int tsector = sector + 1;
+    if (SCpdcut) { // if the SCpdCut bit is set, take off the bad SC paddle by strictly cutting off a theta gap.
 
-	  // sector 3 has two bad paddles
+      if (status) {
 
-	  if (tsector == 3) {
+	int tsector = sector + 1;
 
-	    float badpar3[4]; // 4 parameters to determine the positions of the two theta gaps
+	// sector 3 has two bad paddles
 
-	    for (int i = 0; i < 4; i++) {
+	if (tsector == 3) {
 
-	      badpar3[i] = 0;
+	  float badpar3[4]; // 4 parameters to determine the positions of the two theta gaps
 
-	      // calculate the parameters using 1/p
+	  for (int i = 0; i < 4; i++) {
 
-	      badpar3[i] = fgPar_4Gev_2250_Efid_Theta_S3_extra[i][0] + fgPar_4Gev_2250_Efid_Theta_S3_extra[i][1]/mom + fgPar_4Gev_2250_Efid_Theta_S3_extra[i][2]/(mom*mom) + fgPar_4Gev_2250_Efid_Theta_S3_extra[i][3]/(mom*mom*mom);
+	    badpar3[i] = 0;
 
-	    }
+	    // calculate the parameters using 1/p
 
-	    for(int ipar=0;ipar<2;ipar++) { status = status && !(theta>badpar3[2*ipar] && theta<badpar3[2*ipar+1]); }
+	    badpar3[i] = fgPar_4Gev_2250_Efid_Theta_S3_extra[i][0] + fgPar_4Gev_2250_Efid_Theta_S3_extra[i][1]/mom + fgPar_4Gev_2250_Efid_Theta_S3_extra[i][2]/(mom*mom) + fgPar_4Gev_2250_Efid_Theta_S3_extra[i][3]/(mom*mom*mom);
 
 	  }
 
-	  // sector 4 has one bad paddle
+	  for(int ipar=0;ipar<2;ipar++) { status = status && !(theta>badpar3[2*ipar] && theta<badpar3[2*ipar+1]); }
+
+	}
 
-	  else if (tsector == 4) {
+	// sector 4 has one bad paddle
 
-	    float badpar4[2]; // 2 parameters to determine the position of the theta gap
+	else if (tsector == 4) {
 
-	    for (int i = 0; i < 2; i++) {
+	  float badpar4[2]; // 2 parameters to determine the position of the theta gap
 
-	      badpar4[i] = 0;
+	  for (int i = 0; i < 2; i++) {
 
-	      // calculate the parameters using 1/p
+	    badpar4[i] = 0;
 
-	      badpar4[i] = fgPar_4Gev_2250_Efid_Theta_S4_extra[i][0] + fgPar_4Gev_2250_Efid_Theta_S4_extra[i][1]/mom + fgPar_4Gev_2250_Efid_Theta_S4_extra[i][2]/(mom*mom) + fgPar_4Gev_2250_Efid_Theta_S4_extra[i][3]/(mom*mom*mom);
+	    // calculate the parameters using 1/p
 
-	    }
+	    badpar4[i] = fgPar_4Gev_2250_Efid_Theta_S4_extra[i][0] + fgPar_4Gev_2250_Efid_Theta_S4_extra[i][1]/mom + fgPar_4Gev_2250_Efid_Theta_S4_extra[i][2]/(mom*mom) + fgPar_4Gev_2250_Efid_Theta_S4_extra[i][3]/(mom*mom*mom);
 
-	    status = !(theta>badpar4[0] && theta<badpar4[1]);
-				
 	  }
 
-	  // sector 5 has four bad paddles
-
-	  else if (tsector == 5) {
+	  status = !(theta>badpar4[0] && theta<badpar4[1]);
 
-	    Float_t badpar5[8]; // 8 parameters to determine the positions of the four theta gaps
+	}
 
-	    for ( Int_t i = 0; i < 8; i++) {
+	// sector 5 has four bad paddles
 
-	      badpar5[i] = 0;
+	else if (tsector == 5) {
 
-	      // calculate the parameters using 1/p
+	  Float_t badpar5[8]; // 8 parameters to determine the positions of the four theta gaps
 
-	      badpar5[i] = fgPar_4Gev_2250_Efid_Theta_S5_extra[i][0] + fgPar_4Gev_2250_Efid_Theta_S5_extra[i][1]/mom + fgPar_4Gev_2250_Efid_Theta_S5_extra[i][2]/(mom*mom) + fgPar_4Gev_2250_Efid_Theta_S5_extra[i][3]/(mom*mom*mom);
+	  for ( Int_t i = 0; i < 8; i++) {
 
-	    }
+	    badpar5[i] = 0;
 
-	    if (mom < 1.25) badpar5[0] = 23.4;
-	    if (mom < 1.27) badpar5[1] = 24.0; // some dummy constants. see fiducial cuts webpage.
+	    // calculate the parameters using 1/p
 
-	    for ( Int_t ipar = 0; ipar < 4; ipar++) { status = status && !(theta>badpar5[2*ipar] && theta<badpar5[2*ipar+1]); }
+	    badpar5[i] = fgPar_4Gev_2250_Efid_Theta_S5_extra[i][0] + fgPar_4Gev_2250_Efid_Theta_S5_extra[i][1]/mom + fgPar_4Gev_2250_Efid_Theta_S5_extra[i][2]/(mom*mom) + fgPar_4Gev_2250_Efid_Theta_S5_extra[i][3]/(mom*mom*mom);
 
 	  }
 
+	  if (mom < 1.25) badpar5[0] = 23.4;
+	  if (mom < 1.27) badpar5[1] = 24.0; // some dummy constants. see fiducial cuts webpage.
+
+	  for ( Int_t ipar = 0; ipar < 4; ipar++) { status = status && !(theta>badpar5[2*ipar] && theta<badpar5[2*ipar+1]); }
+
 	}
 
       }
-			
-      return (status && (phi < phiMax) && (phi>phiMin));
 
     }
 
+    return (status && (phi < phiMax) && (phi>phiMin));
+
   }
 
   return status;
-
 }
 
-// ------------------------------------------------------------------------------------------------------------------------------------------
-// ------------------------------------------------------------------------------------------------------------------------------------------
-
-// apapadop // Nov 11 2020 // Narrow band 30 deg in phi and either accepting ALL theta or theta_pos > 12 deg (piplus & protons) and theta_pi- > 30
+// --------------------------------------------------------------------------------------------------------------------------------------------------------
 
-double Fiducial::GetPhi(TVector3 momentum) {
+double Fiducial::GetPhi(TVector3 momentum) const {
 
   double phi = momentum.Phi() * 180. / TMath::Pi() + 30.;
   if (phi < 0) { phi += 360; }
@@ -1184,7 +1238,7 @@ double Fiducial::GetPhi(TVector3 momentum) {
 
 // ------------------------------------------------------------------------------------------------------------------------------------------
 
-double Fiducial::GetTheta(TVector3 momentum) {
+double Fiducial::GetTheta(TVector3 momentum) const {
 
   double theta = momentum.Theta() * 180. / TMath::Pi();
   if (theta < 0) { theta += 180; }
@@ -1197,7 +1251,7 @@ double Fiducial::GetTheta(TVector3 momentum) {
 // ------------------------------------------------------------------------------------------------------------------------------------------
 // ------------------------------------------------------------------------------------------------------------------------------------------
 
-Bool_t Fiducial::PFiducialCut(double beam_en, TVector3 momentum){
+Bool_t Fiducial::PFiducialCut(double beam_en, TVector3 momentum) const{
   //Positive Hadron Fiducial Cut
   //Please refer to <A HREF="http://www.jlab.org/Hall-B/secure/e2/bzh/pfiducialcut.html">Electron Fiducial Cuts</A> -- Bin Zhang (MIT).
 
@@ -1217,7 +1271,6 @@ Bool_t Fiducial::PFiducialCut(double beam_en, TVector3 momentum){
   } else {
 
     Bool_t status = kTRUE;
-    std::string fbeam_en = std::to_string((int)(beam_en*1000));
 
     if ( beam_en>1. && beam_en<2.) {
 
@@ -1238,16 +1291,8 @@ Bool_t Fiducial::PFiducialCut(double beam_en, TVector3 momentum){
 	if (p < .3) { return false; }
 	if (p > 1) { p = 1; }
 
-	for (Int_t mompar=0;mompar<6;mompar++) {
-
-	  for(Int_t phipar=0;phipar<5;phipar++) {
-          
-	    phipars[phipar]+=fgPar_1gev_1500_Pfid[sector][phipar][mompar]*pow(p,mompar);
-	    //std::cout << p << " " << mompar << " " << phipar << " " << phipars[1] << " " << phipars[2] << std::endl;
-	    //std::cout << " " << phipars[3] << " " << phipars[4] << " " << phipars[5] << std::endl;
-
-	  }
-
+	for(Int_t phipar=0;phipar<5;phipar++) {
+	  for(Int_t mompar=5;mompar>=0;mompar--) { phipars[phipar] = phipars[phipar]*p + fgPar_1gev_1500_Pfid[sector][phipar][mompar]; }
 	}
 
 	Double_t phicutoff;
@@ -1351,11 +1396,8 @@ Bool_t Fiducial::PFiducialCut(double beam_en, TVector3 momentum){
 	  return false;
 	if (p > 1)
 	  p = 1;
-	for(Int_t mompar=0;mompar<6;mompar++) {
-	  for(Int_t phipar=0;phipar<5;phipar++) {
-	    phipars[phipar]+=fgPar_1gev_750_Pfid[sector][phipar][mompar]*pow(p,mompar);
-	    //std::cout << p << " " << mompar << " " << phipar << " " << phipars[1] << " " << phipars[2] << " " << phipars[3] << " " << phipars[4] << " " << phipars[5] << std::endl;
-	  }
+	for(Int_t phipar=0;phipar<5;phipar++) {
+	  for(Int_t mompar=5;mompar>=0;mompar--) { phipars[phipar] = phipars[phipar]*p + fgPar_1gev_750_Pfid[sector][phipar][mompar]; }
 	}
 
 	Double_t phicutoff;
@@ -1819,7 +1861,7 @@ Bool_t Fiducial::PFiducialCut(double beam_en, TVector3 momentum){
 
 // ---------------------------------------------------------------------------------------------
 
-Bool_t Fiducial::PiplFiducialCut(double beam_en, TVector3 momentum, Float_t *philow, Float_t *phiup){
+Bool_t Fiducial::PiplFiducialCut(double beam_en, TVector3 momentum, Float_t *philow, Float_t *phiup) const{
   //Positive Hadron Fiducial Cut
   //Please refer to <A HREF="http://www.jlab.org/Hall-B/secure/e2/bzh/pfiducialcut.html">Electron Fiducial Cuts</A> -- Bin Zhang (MIT).
 
@@ -1858,11 +1900,8 @@ Bool_t Fiducial::PiplFiducialCut(double beam_en, TVector3 momentum, Float_t *phi
 	if (p < 0.15)p=0.15;
 	if (p > 1)
 	  p = 1;
-	for(Int_t mompar=0;mompar<6;mompar++) {
-	  for(Int_t phipar=0;phipar<5;phipar++) {
-	    phipars[phipar]+=fgPar_1gev_1500_Pfid[sector][phipar][mompar]*pow(p,mompar);
-	    //std::cout << p << " " << mompar << " " << phipar << " " << phipars[1] << " " << phipars[2] << " " << phipars[3] << " " << phipars[4] << " " << phipars[5] << std::endl;
-	  }
+	for(Int_t phipar=0;phipar<5;phipar++) {
+	  for(Int_t mompar=5;mompar>=0;mompar--) { phipars[phipar] = phipars[phipar]*p + fgPar_1gev_1500_Pfid[sector][phipar][mompar]; }
 	}
 
 	Double_t phicutoff;
@@ -1948,11 +1987,8 @@ Bool_t Fiducial::PiplFiducialCut(double beam_en, TVector3 momentum, Float_t *phi
 	if (p < 0.15)p=0.15;
 	if (p > 1)
 	  p = 1;
-	for(Int_t mompar=0;mompar<6;mompar++) {
-	  for(Int_t phipar=0;phipar<5;phipar++) {
-	    phipars[phipar]+=fgPar_1gev_750_Pfid[sector][phipar][mompar]*pow(p,mompar);
-	    //std::cout << p << " " << mompar << " " << phipar << " " << phipars[1] << " " << phipars[2] << " " << phipars[3] << " " << phipars[4] << " " << phipars[5] << std::endl;
-	  }
+	for(Int_t phipar=0;phipar<5;phipar++) {
+	  for(Int_t mompar=5;mompar>=0;mompar--) { phipars[phipar] = phipars[phipar]*p + fgPar_1gev_750_Pfid[sector][phipar][mompar]; }
 	}
 
 	Double_t phicutoff;
@@ -2417,7 +2453,7 @@ Bool_t Fiducial::PiplFiducialCut(double beam_en, TVector3 momentum, Float_t *phi
 
 // ----------------------------------------------------------------------------------------------------------------------------------
 
-Bool_t Fiducial::PFiducialCutExtra(double beam_en, TVector3 momentum) {
+Bool_t Fiducial::PFiducialCutExtra(double beam_en, TVector3 momentum) const {
 
   bool status = true;
 
@@ -2431,7 +2467,7 @@ Bool_t Fiducial::PFiducialCutExtra(double beam_en, TVector3 momentum) {
 
 // ----------------------------------------------------------------------------------------------------------------------------------
 
-Bool_t Fiducial::PiplFiducialCutExtra(double beam_en, TVector3 momentum) {
+Bool_t Fiducial::PiplFiducialCutExtra(double beam_en, TVector3 momentum) const {
 
   bool status = true;
 
@@ -2445,7 +2481,7 @@ Bool_t Fiducial::PiplFiducialCutExtra(double beam_en, TVector3 momentum) {
 
 // ----------------------------------------------------------------------------------------------------------------------------------
 
-Bool_t Fiducial::Phot_fidExtra(TVector3 momentum) {
+Bool_t Fiducial::Phot_fidExtra(TVector3 momentum) const {
 
   bool status = true;
 
@@ -2459,13 +2495,13 @@ Bool_t Fiducial::Phot_fidExtra(TVector3 momentum) {
 
 // ----------------------------------------------------------------------------------------------------------------------------------
 
-Bool_t Fiducial::PimiFiducialCutExtra(double beam_en, TVector3 momentum) {
+Bool_t Fiducial::PimiFiducialCutExtra(double beam_en, TVector3 momentum) const {
 
   bool status = true;
 
   double theta = momentum.Theta() * 180. / TMath::Pi();
   double mom = momentum.Mag();
-  double theta_min = myPiMinusFit->Eval(mom);
+  double theta_min = GetPiMinusThetaMin(mom);
 
   if (theta < theta_min) { status = false; }
 
@@ -2488,7 +2524,7 @@ Bool_t Fiducial::PimiFiducialCutExtra(double beam_en, TVector3 momentum) {
 //                                       A future update will implement new phi fiducial cuts at all momenta, but the current bug fixes are considered
 //                                       adequate for the zero pion analyses
 
-Bool_t Fiducial::PimiFiducialCut(double beam_en, TVector3 momentum, Float_t *pimi_philow, Float_t *pimi_phiup){
+Bool_t Fiducial::PimiFiducialCut(double beam_en, TVector3 momentum, Float_t *pimi_philow, Float_t *pimi_phiup) const{
   
   if (beam_en == 0) {
 
@@ -2553,11 +2589,8 @@ Bool_t Fiducial::PimiFiducialCut(double beam_en, TVector3 momentum, Float_t *pim
       //Not used in Mariana's analysis, so are these still valid?
       if( fTorusCurrent>1490 && fTorusCurrent<1510){
 
-	for(Int_t mompar=0;mompar<6;mompar++) {
-	  for(Int_t phipar=0;phipar<5;phipar++) {
-	    phipars[phipar]+=fgPar_1gev_1500_Pimfid[sector][phipar][mompar]*pow(mom_pi,mompar);
-	    //std::cout << mom_e << " " << mompar << " " << phipar << " " << phipars[1] << " " << phipars[2] << " " << phipars[3] << " " << phipars[4] << " " << phipars[5] << std::endl;
-	  }
+	for(Int_t phipar=0;phipar<5;phipar++) {
+	  for(Int_t mompar=5;mompar>=0;mompar--) { phipars[phipar] = phipars[phipar]*mom_pi + fgPar_1gev_1500_Pimfid[sector][phipar][mompar]; }
 	}
 
 	//cut on phi fiducial edges
@@ -2684,11 +2717,8 @@ Bool_t Fiducial::PimiFiducialCut(double beam_en, TVector3 momentum, Float_t *pim
       //------------------------------
       if ( fTorusCurrent>740 && fTorusCurrent<760){
 
-	for(Int_t mompar=0;mompar<6;mompar++) {
-	  for(Int_t phipar=0;phipar<5;phipar++) {
-	    phipars[phipar]+=fgPar_1gev_750_Pimfid[sector][phipar][mompar]*pow(mom_pi,mompar);
-	    //std::cout << p << " " << mompar << " " << phipar << " " << phipars[1] << " " << phipars[2] << " " << phipars[3] << " " << phipars[4] << " " << phipars[5] << std::endl;
-	  }
+	for(Int_t phipar=0;phipar<5;phipar++) {
+	  for(Int_t mompar=5;mompar>=0;mompar--) { phipars[phipar] = phipars[phipar]*mom_pi + fgPar_1gev_750_Pimfid[sector][phipar][mompar]; }
 	}
 
 	//Temporary momentum parameter to define a maximum limit on theta in the range 0.1-0.7 GeV pion momentum
@@ -2978,7 +3008,7 @@ Bool_t Fiducial::PimiFiducialCut(double beam_en, TVector3 momentum, Float_t *pim
 // --------------------------------------------------------------------------------------------------------------------------------------------------
 
 
-bool Fiducial::Phot_fid(TVector3 V3_phot){
+bool Fiducial::Phot_fid(TVector3 V3_phot) const{
 
   bool status = true;
   //  double costheta=V3_phot.Pz();
@@ -2989,23 +3019,20 @@ bool Fiducial::Phot_fid(TVector3 V3_phot){
   bool hot_spot=(phi_deg>185 && phi_deg<191 && costheta<0.71 && costheta>0.67) || (phi_deg>221 && phi_deg<236 && costheta<0.73 && costheta>0.67); // used to kill the two hot spots in sector 4
 
 
-  if((costheta>low_lim1_ec->Eval(phi_deg) && costheta<up_lim1_ec->Eval(phi_deg) && costheta<rightside_lim1_ec->Eval(phi_deg) && costheta<leftside_lim1_ec->Eval(phi_deg))  ||
-     (costheta>low_lim2_ec->Eval(phi_deg) && costheta<up_lim2_ec->Eval(phi_deg) && costheta<rightside_lim2_ec->Eval(phi_deg) && costheta<leftside_lim2_ec->Eval(phi_deg))       ||
-     (costheta>low_lim3_ec->Eval(phi_deg) && costheta<up_lim3_ec->Eval(phi_deg) && costheta<rightside_lim3_ec->Eval(phi_deg) && costheta<leftside_lim3_ec->Eval(phi_deg))       ||
-     (costheta>low_lim4_ec->Eval(phi_deg) && costheta<up_lim4_ec->Eval(phi_deg) && costheta<rightside_lim4_ec->Eval(phi_deg) && costheta<leftside_lim4_ec->Eval(phi_deg) && !hot_spot)       ||
-     (costheta>low_lim5_ec->Eval(phi_deg) && costheta<up_lim5_ec->Eval(phi_deg) && costheta<rightside_lim5_ec->Eval(phi_deg) && costheta<leftside_lim5_ec->Eval(phi_deg))       ||
-     (costheta>low_lim6_ec->Eval(phi_deg) && costheta<up_lim6_ec->Eval(phi_deg) && costheta<rightside_lim6_ec->Eval(phi_deg) && costheta<leftside_lim6_ec->Eval(phi_deg))
-     ){ //EC only
-    status=true;}
-  else {
-    status=false;}
+  //EC only
+  status=false;
+  for (int sector = 0; sector < 6 && !status; sector++) {
+    if (sector == 3 && hot_spot) continue;
+    status = costheta>ECLimitParabola(low_lim_ec[sector],phi_deg) && costheta<ECLimitParabola(up_lim_ec[sector],phi_deg) &&
+      costheta<ECLimitLine(rightside_lim_ec[sector],phi_deg) && costheta<ECLimitLine(leftside_lim_ec[sector],phi_deg);
+  }
 
   return status;
 }
 
 // ----------------------------------------------------------------------------------------------------
 
-bool Fiducial::Pi_phot_fid_united(double beam_en, TVector3 V3_pi_phot, int q_pi_phot){
+bool Fiducial::Pi_phot_fid_united(double beam_en, TVector3 V3_pi_phot, int q_pi_phot) const{
 
   bool status = false;
   Float_t pi_cphil=0,pi_cphir=0,pi_phimin=0,pi_phimax=0;
@@ -3019,7 +3046,7 @@ bool Fiducial::Pi_phot_fid_united(double beam_en, TVector3 V3_pi_phot, int q_pi_
 
 // ----------------------------------------------------------------------------------------------------
 
-bool Fiducial::Pi_phot_fid_unitedExtra(double beam_en, TVector3 V3_pi_phot, int q_pi_phot){
+bool Fiducial::Pi_phot_fid_unitedExtra(double beam_en, TVector3 V3_pi_phot, int q_pi_phot) const{
 
   bool status = true;
   if(q_pi_phot==0) status=Phot_fidExtra(V3_pi_phot);
@@ -13,39 +13,66 @@
 #include <iomanip>
 #include <vector>
 #include <map>
+#include <memory>
+#include "utils/FiducialGrid.h"
 
 namespace e4nu {
 
   struct Fiducial {
 
+    // The Init*, Set* and EnableGrid methods configure the cuts. The cut methods are const and only read
+    // the parameters (FiducialGrid cells are atomic), so one configured instance can be shared by several threads
     void InitPiMinusFit(const double EBeam ) ; 
     void InitEClimits();
     void SetConstants(int in_TorusCurrent, int target_pdg, double in_en_beam);
     bool SetFiducialCutParameters(double beam_en);
-    Bool_t GetEPhiLimits(double beam_en, Float_t momentum, Float_t theta, Int_t sector,Float_t *EPhiMin, Float_t *EPhiMax);
-    Bool_t EFiducialCut(double beam_en, TVector3 momentum);
-    Bool_t PFiducialCut(double beam_en, TVector3 momentum);
-    Bool_t PiplFiducialCut(double beam_en, TVector3 momentum,Float_t *philow,Float_t *phiup);
-    Bool_t PimiFiducialCut(double beam_en, TVector3 momentum, Float_t *pimi_philow, Float_t *pimi_phiup);
-    bool Phot_fid(TVector3 V3_phot);
-    bool Pi_phot_fid_united(double beam_en, TVector3 V3_pi_phot, int q_pi_phot);
+    Bool_t GetEPhiLimits(double beam_en, Float_t momentum, Float_t theta, Int_t sector,Float_t *EPhiMin, Float_t *EPhiMax) const;
+    Bool_t EFiducialCut(double beam_en, TVector3 momentum) const;
+    Bool_t EFiducialCut1GeV(double beam_en, TVector3 momentum) const;
+    Bool_t EFiducialCut2GeV(double beam_en, TVector3 momentum) const;
+    Bool_t EFiducialCut4GeV(double beam_en, TVector3 momentum) const;
+    Bool_t PFiducialCut(double beam_en, TVector3 momentum) const;
+    Bool_t PiplFiducialCut(double beam_en, TVector3 momentum,Float_t *philow,Float_t *phiup) const;
+    Bool_t PimiFiducialCut(double beam_en, TVector3 momentum, Float_t *pimi_philow, Float_t *pimi_phiup) const;
+    bool Phot_fid(TVector3 V3_phot) const;
+    bool Pi_phot_fid_united(double beam_en, TVector3 V3_pi_phot, int q_pi_phot) const;
 
     // --------------------------------------------------------------------------
 
     // apapadop // Nov 11 2020 // Narrow band 30 deg in phi and either accepting ALL theta or theta_pos > 12 deg (piplus & protons) and theta_pi- > 30
 
-    double GetPhi(TVector3 momentum);
-    double GetTheta(TVector3 momentum);
+    double GetPhi(TVector3 momentum) const;
+    double GetTheta(TVector3 momentum) const;
 
     // -------------------------------------------------------------------------- 
 
     // apapadop // Nov 23 2020 // Narrow band 30 deg in phi and either accepting ALL theta or theta_pos > 12 deg (piplus & protons) and theta_pi- > 30
-    Bool_t FiducialCut( const int pdg, const double beam_en, TVector3 momentum, const bool is_data ) ; 
-    Bool_t PFiducialCutExtra(double beam_en, TVector3 momentum);
-    Bool_t PiplFiducialCutExtra(double beam_en, TVector3 momentum);
-    Bool_t PimiFiducialCutExtra(double beam_en, TVector3 momentum);
-    bool Phot_fidExtra(TVector3 V3_phot);
-    bool Pi_phot_fid_unitedExtra(double beam_en, TVector3 V3_pi_phot, int q_pi_phot);
+    Bool_t FiducialCut( const int pdg, const double beam_en, TVector3 momentum, const bool is_data ) const ; 
+    // Same cut without the grid, with momentum in the detector frame (after the MC phi flip)
+    Bool_t DetectorFiducialCut( const int pdg, const double beam_en, const TVector3 & momentum ) const ; 
+    // Same cuts for n momenta given as arrays (i.e. all the rotated copies of a particle, see RotationKernel)
+    // The MC phi flip and the grid lookup are done in loops over the arrays, and the cut kernel is selected once
+    void FiducialCutBatch( const int pdg, const double beam_en, const unsigned int n, const double * px, const double * py, const double * pz,
+			   bool * out_mask, const bool is_data ) const ; 
+    void DetectorFiducialCutBatch( const int pdg, const double beam_en, const unsigned int n, const double * px, const double * py, const double * pz,
+				   bool * out_mask ) const ; 
+    // FiducialCut uses a precomputed acceptance grid for en_beam, and the exact cut for the boundary cells (see FiducialGrid)
+    void EnableGrid( const std::string cache_file = "" ) ; 
+    Bool_t PFiducialCutExtra(double beam_en, TVector3 momentum) const;
+    Bool_t PiplFiducialCutExtra(double beam_en, TVector3 momentum) const;
+    Bool_t PimiFiducialCutExtra(double beam_en, TVector3 momentum) const;
+    bool Phot_fidExtra(TVector3 V3_phot) const;
+    bool Pi_phot_fid_unitedExtra(double beam_en, TVector3 V3_pi_phot, int q_pi_phot) const;
+
+    // Cut kernels for each particle, selected once for en_beam and fTorusCurrent in SetConstants
+    // DetectorFiducialCut uses them when beam_en == en_beam
+    typedef Bool_t (Fiducial::*FiducialKernel)(double beam_en, TVector3 momentum) const;
+    enum KernelID { kElectronKernel = 0, kProtonKernel, kPiPlusKernel, kPiMinusKernel, kPhotonKernel, kNKernels } ;
+    void SetKernels(void) ;
+    FiducialKernel GetKernel( const int pdg, const double beam_en ) const ; // nullptr if there is no kernel
+    Bool_t PiPlusFiducialCut(double beam_en, TVector3 momentum) const { return Pi_phot_fid_united( beam_en, momentum, 1 ) ; }
+    Bool_t PiMinusFiducialCut(double beam_en, TVector3 momentum) const { return Pi_phot_fid_united( beam_en, momentum, -1 ) ; }
+    Bool_t PhotonFiducialCut(double beam_en, TVector3 momentum) const { return Pi_phot_fid_united( beam_en, momentum, 0 ) ; }
 
     // -------------------------------------------------------------------------- 
 
@@ -53,10 +80,17 @@ namespace e4nu {
     std::string ftarget_pdg;
     double en_beam;
 
-    std::unique_ptr<TF1> myPiMinusFit;
+    // pi- minimum theta, set in InitPiMinusFit. 0 : not set, 1 : 1.161 GeV, 2 : 2.261 and 4.461 GeV
+    int fPiMinusFit = 0 ;
+    double GetPiMinusThetaMin( const double mom ) const ;
+    std::unique_ptr<FiducialGrid> fGrid ; 
+    FiducialKernel fKernels[kNKernels] = {} ;
 
-    std::unique_ptr<TF1> up_lim1_ec, up_lim2_ec,up_lim3_ec,up_lim4_ec, up_lim5_ec,up_lim6_ec,low_lim1_ec,low_lim2_ec,low_lim3_ec, low_lim4_ec,low_lim5_ec,low_lim6_ec;
-    std::unique_ptr<TF1> leftside_lim1_ec, leftside_lim2_ec,leftside_lim3_ec, leftside_lim4_ec,leftside_lim5_ec, leftside_lim6_ec,rightside_lim1_ec, rightside_lim2_ec,rightside_lim3_ec, rightside_lim4_ec,rightside_lim5_ec, rightside_lim6_ec;
+    // EC limits of each sector for Phot_fid, set in InitEClimits
+    // up and low : [0]+(x-[1])*(x-[1])*[2], leftside and rightside : [0]*(x+[1])+[2]
+    double up_lim_ec[6][3] = {}, low_lim_ec[6][3] = {}, leftside_lim_ec[6][3] = {}, rightside_lim_ec[6][3] = {} ;
+    static double ECLimitParabola( const double * par, const double x ) { return par[0]+(x-par[1])*(x-par[1])*par[2] ; }
+    static double ECLimitLine( const double * par, const double x ) { return par[0]*(x+par[1])+par[2] ; }
 
     //4.4 GeV parameters
     //e- parameters
@@ -181,6 +215,8 @@ namespace e4nu {
     double fgPar_1gev_1500_Efid_Theta_S3[4][8];
     double fgPar_1gev_1500_Efid_Theta_S4[2][8];
     double fgPar_1gev_1500_Efid_Theta_S5[8][8];
+    // Efid coefficients for fTorusCurrent, filled in SetFiducialCutParameters
+    double fgPar_1gev_Efid[6][5][6] = {} ;
 
     //proton parameters
     double fgPar_1gev_750_Pfid[6][5][6];
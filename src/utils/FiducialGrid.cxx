@@ -0,0 +1,239 @@
+/**
+ * This class classifies the fiducial acceptance on a grid in (p, cos theta, phi)
+ **/
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cmath>
+#include <algorithm>
+#include "TMath.h"
+#include "utils/FiducialGrid.h"
+#include "utils/Fiducial.h"
+#include "utils/Serialization.h"
+#include "utils/Utils.h"
+#include "conf/ParticleI.h"
+
+using namespace e4nu ;
+
+namespace {
+  const int kGridPdgs[e4nu::FiducialGrid::kNPdgs] = { e4nu::conf::kPdgElectron, e4nu::conf::kPdgProton, e4nu::conf::kPdgPiP, 
+						      e4nu::conf::kPdgPiM, e4nu::conf::kPdgPhoton } ; 
+  const unsigned int kNNodes = ( e4nu::FiducialGrid::kMomentumBins + 1 ) * ( e4nu::FiducialGrid::kCosThetaBins + 1 ) * ( e4nu::FiducialGrid::kPhiBins + 1 ) ;
+  const unsigned int kNCells = e4nu::FiducialGrid::kMomentumBins * e4nu::FiducialGrid::kCosThetaBins * e4nu::FiducialGrid::kPhiBins ;
+}
+
+FiducialGrid::FiducialGrid( const Fiducial * fiducial, const double EBeam, const int torus_current, const std::string cache_file ) :
+  kFiducial( fiducial ), kEBeam( EBeam ), kTorusCurrent( torus_current ), kCacheFile( cache_file ), kIsModified( false ) {
+  for( unsigned int i = 0 ; i < kNPdgs ; ++i ) { 
+    kNodes[i] = std::vector<std::atomic<unsigned char>>( kNNodes ) ; 
+    kCells[i] = std::vector<std::atomic<unsigned char>>( kNCells ) ; 
+    for( unsigned int j = 0 ; j < kNNodes ; ++j ) kNodes[i][j].store( 0, std::memory_order_relaxed ) ; 
+    for( unsigned int j = 0 ; j < kNCells ; ++j ) kCells[i][j].store( kUnknown, std::memory_order_relaxed ) ; 
+  }
+  if( kCacheFile.size() ) { 
+    kCutFingerprint = ComputeCutFingerprint() ; 
+    this->ReadCache() ; 
+  }
+}
+
+FiducialGrid::~FiducialGrid() {
+  if( kCacheFile.size() && kIsModified ) this->WriteCache() ; 
+}
+
+int FiducialGrid::GetPdgIndex( const int pdg ) const { 
+  for( unsigned int i = 0 ; i < kNPdgs ; ++i ) if( kGridPdgs[i] == pdg ) return i ; 
+  return -1 ; 
+}
+
+bool FiducialGrid::IsDetected( const unsigned int pdg_id, const double momentum, const double cos_theta, const double phi ) const { 
+  TVector3 v ; 
+  v.SetMagThetaPhi( momentum, std::acos( cos_theta ), phi * TMath::DegToRad() ) ; 
+  return kFiducial->DetectorFiducialCut( kGridPdgs[pdg_id], kEBeam, v ) ; 
+}
+
+bool FiducialGrid::GetNode( const unsigned int pdg_id, const unsigned int mom_id, const unsigned int cos_id, const unsigned int phi_id ) { 
+  std::atomic<unsigned char> & node = kNodes[pdg_id][ ( mom_id * ( kCosThetaBins + 1 ) + cos_id ) * ( kPhiBins + 1 ) + phi_id ] ; 
+  unsigned char status = node.load( std::memory_order_relaxed ) ; 
+  if( status == 0 ) { 
+    // Threads computing the same node store the same value
+    double momentum = kEBeam * mom_id / kMomentumBins ; 
+    double cos_theta = -1 + 2. * cos_id / kCosThetaBins ; 
+    double phi = -30 + 360. * phi_id / kPhiBins ; 
+    status = IsDetected( pdg_id, momentum, cos_theta, phi ) ? 2 : 1 ; 
+    node.store( status, std::memory_order_relaxed ) ; 
+  }
+  return status == 2 ; 
+}
+
+FiducialGrid::CellStatus FiducialGrid::ComputeCell( const unsigned int pdg_id, const unsigned int mom_id, const unsigned int cos_id, const unsigned int phi_id ) { 
+  bool is_detected = GetNode( pdg_id, mom_id, cos_id, phi_id ) ; 
+  for( unsigned int corner = 1 ; corner < 8 ; ++corner ) { 
+    if( GetNode( pdg_id, mom_id + ( corner & 1 ), cos_id + ( ( corner >> 1 ) & 1 ), phi_id + ( ( corner >> 2 ) & 1 ) ) != is_detected ) return kBoundary ; 
+  }
+  double momentum = kEBeam * ( mom_id + 0.5 ) / kMomentumBins ; 
+  double cos_theta = -1 + 2. * ( cos_id + 0.5 ) / kCosThetaBins ; 
+  double phi = -30 + 360. * ( phi_id + 0.5 ) / kPhiBins ; 
+  if( IsDetected( pdg_id, momentum, cos_theta, phi ) != is_detected ) return kBoundary ; 
+
+  // The corners and the centre can miss gaps of 1-2 degrees. The cell is also scanned in steps of kRefineStep in theta and phi
+  // At small angles a cos theta bin spans several degrees in theta
+  double theta_min = std::acos( -1 + 2. * ( cos_id + 1 ) / kCosThetaBins ) * TMath::RadToDeg() ; 
+  double theta_max = std::acos( -1 + 2. * cos_id / kCosThetaBins ) * TMath::RadToDeg() ; 
+  double phi_min = -30 + 360. * phi_id / kPhiBins ; 
+  unsigned int n_theta = std::max( (unsigned int) std::ceil( ( theta_max - theta_min ) / kRefineStep ), 1u ) ; 
+  unsigned int n_phi = std::max( (unsigned int) std::ceil( 360. / kPhiBins / kRefineStep ), 1u ) ; 
+  for( unsigned int i = 0 ; i < 3 ; ++i ) { 
+    momentum = kEBeam * ( mom_id + 0.5 * i ) / kMomentumBins ; 
+    for( unsigned int j = 0 ; j <= n_theta ; ++j ) { 
+      cos_theta = std::cos( ( theta_min + ( theta_max - theta_min ) * j / n_theta ) * TMath::DegToRad() ) ; 
+      for( unsigned int k = 0 ; k <= n_phi ; ++k ) { 
+	phi = phi_min + 360. / kPhiBins * k / n_phi ; 
+	if( IsDetected( pdg_id, momentum, cos_theta, phi ) != is_detected ) return kBoundary ; 
+      }
+    }
+  }
+  return is_detected ? kInside : kOutside ; 
+}
+
+unsigned int FiducialGrid::Validate( const unsigned int n_points ) { 
+  unsigned int n_mismatches = 0 ; 
+  for( unsigned int pdg_id = 0 ; pdg_id < kNPdgs ; ++pdg_id ) { 
+    unsigned int n_checked = 0, n_wrong = 0 ; 
+    // Middle of each scan bin, so that the points are not on the grid nodes
+    for( unsigned int i = 0 ; i < n_points ; ++i ) { 
+      double momentum = kEBeam * ( i + 0.5 ) / n_points ; 
+      for( unsigned int j = 0 ; j < n_points ; ++j ) { 
+	double cos_theta = -1 + 2. * ( j + 0.5 ) / n_points ; 
+	for( unsigned int k = 0 ; k < n_points ; ++k ) { 
+	  double phi = -30 + 360. * ( k + 0.5 ) / n_points ; 
+	  CellStatus status = GetCellStatus( pdg_id, momentum, cos_theta, phi ) ; 
+	  if( status != kInside && status != kOutside ) continue ; 
+	  ++n_checked ; 
+	  if( IsDetected( pdg_id, momentum, cos_theta, phi ) != ( status == kInside ) ) ++n_wrong ; 
+	}
+      }
+    }
+    std::cout << " Fiducial grid check for " << kGridPdgs[pdg_id] << " : " << n_wrong << " mismatches in " << n_checked << " points" << std::endl;
+    if( n_wrong ) std::cout << " WARN : The fiducial grid differs from the exact cut for " << kGridPdgs[pdg_id] << std::endl;
+    n_mismatches += n_wrong ; 
+  }
+  return n_mismatches ; 
+}
+
+FiducialGrid::CellStatus FiducialGrid::GetStatus( const int pdg, const TVector3 & momentum ) { 
+  int pdg_id = GetPdgIndex( pdg ) ; 
+  if( pdg_id < 0 ) return kBoundary ; 
+
+  double mom = momentum.Mag() ; 
+  if( mom >= kEBeam || mom <= 0 ) return kBoundary ; 
+  return GetCellStatus( pdg_id, mom, momentum.CosTheta(), momentum.Phi() * TMath::RadToDeg() ) ; 
+}
+
+void FiducialGrid::GetStatus( const int pdg, const unsigned int n, const double * px, const double * py, const double * pz, unsigned char * status ) { 
+  int pdg_id = GetPdgIndex( pdg ) ; 
+  if( pdg_id < 0 ) { 
+    std::fill( status, status + n, (unsigned char) kBoundary ) ; 
+    return ; 
+  }
+
+  std::vector<double> mom( n ), cos_theta( n ), phi( n ) ; 
+  for( unsigned int i = 0 ; i < n ; ++i ) mom[i] = std::sqrt( px[i] * px[i] + py[i] * py[i] + pz[i] * pz[i] ) ; 
+  for( unsigned int i = 0 ; i < n ; ++i ) cos_theta[i] = mom[i] > 0 ? pz[i] / mom[i] : 1. ; 
+  // Same convention as TVector3::Phi
+  for( unsigned int i = 0 ; i < n ; ++i ) phi[i] = px[i] == 0 && py[i] == 0 ? 0 : std::atan2( py[i], px[i] ) * TMath::RadToDeg() ; 
+
+  for( unsigned int i = 0 ; i < n ; ++i ) { 
+    if( mom[i] >= kEBeam || mom[i] <= 0 ) status[i] = kBoundary ; 
+    else status[i] = GetCellStatus( pdg_id, mom[i], cos_theta[i], phi[i] ) ; 
+  }
+}
+
+FiducialGrid::CellStatus FiducialGrid::GetCellStatus( const unsigned int pdg_id, const double mom, const double cos_theta, double phi ) { 
+  if( phi < -30 ) phi += 360 ; 
+
+  unsigned int mom_id = std::min( (unsigned int) ( mom / kEBeam * kMomentumBins ), kMomentumBins - 1 ) ; 
+  unsigned int cos_id = std::min( (unsigned int) ( ( cos_theta + 1 ) / 2 * kCosThetaBins ), kCosThetaBins - 1 ) ; 
+  unsigned int phi_id = std::min( (unsigned int) std::max( ( phi + 30 ) / 360 * kPhiBins, 0. ), kPhiBins - 1 ) ; 
+
+  std::atomic<unsigned char> & cell = kCells[pdg_id][ ( mom_id * kCosThetaBins + cos_id ) * kPhiBins + phi_id ] ; 
+  unsigned char status = cell.load( std::memory_order_relaxed ) ; 
+  if( status == kUnknown ) { 
+    status = ComputeCell( pdg_id, mom_id, cos_id, phi_id ) ; 
+    cell.store( status, std::memory_order_relaxed ) ; 
+    kIsModified = true ; 
+  }
+  return (CellStatus) status ; 
+}
+
+unsigned long FiducialGrid::ComputeCutFingerprint(void) const { 
+  // The points are between the grid nodes, so that they probe the inside of the cells
+  const unsigned int n_mom = 8, n_cos = 32, n_phi = 64 ; 
+  unsigned long hash = 0 ; 
+  for( unsigned int pdg_id = 0 ; pdg_id < kNPdgs ; ++pdg_id ) { 
+    unsigned long bits = 0 ; 
+    unsigned int n_bits = 0 ; 
+    for( unsigned int i = 0 ; i < n_mom ; ++i ) { 
+      double momentum = kEBeam * ( i + 0.37 ) / n_mom ; 
+      for( unsigned int j = 0 ; j < n_cos ; ++j ) { 
+	double cos_theta = -1 + 2. * ( j + 0.61 ) / n_cos ; 
+	for( unsigned int k = 0 ; k < n_phi ; ++k ) { 
+	  double phi = -30 + 360. * ( k + 0.29 ) / n_phi ; 
+	  bits = ( bits << 1 ) | ( IsDetected( pdg_id, momentum, cos_theta, phi ) ? 1 : 0 ) ; 
+	  if( ++n_bits == 64 ) { 
+	    hash = utils::HashEntry( hash ^ bits ) ; 
+	    bits = 0 ; 
+	    n_bits = 0 ; 
+	  }
+	}
+      }
+    }
+  }
+  return hash ; 
+}
+
+std::string FiducialGrid::GetCacheTag(void) const { 
+  std::stringstream tag ; 
+  tag << kCacheVersion << ";" << std::hex << kCutFingerprint << std::dec << ";" << kEBeam << ";" << kTorusCurrent << ";" << kMomentumBins << ";" << kCosThetaBins << ";" << kPhiBins << ";" << kNPdgs << ";" << (double) kRefineStep ; 
+  return tag.str() ; 
+}
+
+bool FiducialGrid::ReadCache(void) { 
+  std::ifstream in( kCacheFile.c_str(), std::ios::binary ) ; 
+  if( ! in.is_open() ) return false ; 
+
+  std::string magic, tag ; 
+  if( ! ( utils::ReadBinary( in, magic ) && magic == "E4NUFGRD" && utils::ReadBinary( in, tag ) && tag == GetCacheTag() ) ) { 
+    std::cout << " WARN : Fiducial grid cache " << kCacheFile << " was created with a different configuration. It will be overwritten " << std::endl;
+    kIsModified = true ; 
+    return false ; 
+  }
+
+  std::vector<unsigned char> cells ; 
+  for( unsigned int i = 0 ; i < kNPdgs ; ++i ) { 
+    if( ! utils::ReadBinary( in, cells ) || cells.size() != kNCells ) { 
+      std::cout << " WARN : Fiducial grid cache " << kCacheFile << " is corrupted. It will be overwritten " << std::endl;
+      for( unsigned int k = 0 ; k < kNPdgs ; ++k ) for( unsigned int j = 0 ; j < kNCells ; ++j ) kCells[k][j].store( kUnknown, std::memory_order_relaxed ) ; 
+      kIsModified = true ; 
+      return false ; 
+    }
+    for( unsigned int j = 0 ; j < kNCells ; ++j ) kCells[i][j].store( cells[j], std::memory_order_relaxed ) ; 
+  }
+  std::cout << " Fiducial grid loaded from " << kCacheFile << std::endl;
+  return true ; 
+}
+
+bool FiducialGrid::WriteCache(void) const { 
+  std::ofstream out( kCacheFile.c_str(), std::ios::binary ) ; 
+  if( ! out.is_open() ) { 
+    std::cout << " WARN : Cannot open fiducial grid cache " << kCacheFile << std::endl;
+    return false ; 
+  }
+  utils::WriteBinary( out, std::string( "E4NUFGRD" ) ) ; 
+  utils::WriteBinary( out, GetCacheTag() ) ; 
+  std::vector<unsigned char> cells( kNCells ) ; 
+  for( unsigned int i = 0 ; i < kNPdgs ; ++i ) { 
+    for( unsigned int j = 0 ; j < kNCells ; ++j ) cells[j] = kCells[i][j].load( std::memory_order_relaxed ) ; 
+    utils::WriteBinary( out, cells ) ; 
+  }
+  return ! out.fail() ; 
+}
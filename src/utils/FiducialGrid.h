@@ -0,0 +1,79 @@
+/**
+ * This class classifies the fiducial acceptance of electrons, protons, pions and photons on a grid in
+ * (p, cos theta, phi). The phi bins are aligned with the sectors (kPhiBinsPerSector bins in each sector)
+ * 
+ * A cell is inside (outside) the acceptance if the exact fiducial cut passes (fails) at its 8 corners, at its centre
+ * and on a scan of the cell in steps of kRefineStep degrees in theta and phi (at the central momentum and at both momentum edges)
+ * Otherwise it is a boundary cell, and the exact cut has to be evaluated. The cells are classified the first time
+ * they are used. Fiducial features narrower than kRefineStep, or changing faster than the scanned momenta, can be missed.
+ * Validate compares the grid with the exact cut on a dense scan
+ *
+ * The grid is built for one beam energy and torus current. If a cache file is given, the classified cells are
+ * read from it at construction (if the beam energy, torus current, binning and fiducial cuts agree) and stored in it at deletion
+ * The fiducial cuts are compared with a fingerprint of the exact cut on a fixed set of points, and with kCacheVersion
+ **/
+
+#ifndef _FIDUCIAL_GRID_H_
+#define _FIDUCIAL_GRID_H_
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include "TVector3.h"
+
+namespace e4nu {
+
+  struct Fiducial ; 
+
+  class FiducialGrid {
+  public :
+    FiducialGrid( const Fiducial * fiducial, const double EBeam, const int torus_current, const std::string cache_file = "" ) ;
+    virtual ~FiducialGrid() ;
+
+    enum CellStatus { kUnknown = 0, kOutside, kInside, kBoundary } ;
+
+    // Status of the cell containing momentum, in the detector frame (after the MC phi flip). It is thread safe
+    // Momenta above EBeam and particles without fiducial cut are kBoundary
+    CellStatus GetStatus( const int pdg, const TVector3 & momentum ) ;
+    // Same for n momenta given as arrays. The cell coordinates are computed in separate loops over the arrays
+    void GetStatus( const int pdg, const unsigned int n, const double * px, const double * py, const double * pz, unsigned char * status ) ;
+
+    double GetEBeam(void) const { return kEBeam ; }
+
+    // Compares the inside and outside cells with the exact cut at n_points^3 points per particle, between the grid nodes
+    // It prints the number of mismatches of each particle and returns the total
+    unsigned int Validate( const unsigned int n_points ) ;
+
+    static const unsigned int kMomentumBins = 50 ; // Between 0 and EBeam
+    static const unsigned int kCosThetaBins = 100 ;
+    static const unsigned int kPhiBinsPerSector = 30 ; // 2 degrees
+    static const unsigned int kPhiBins = 6 * kPhiBinsPerSector ;
+    static const unsigned int kNPdgs = 5 ;
+    static constexpr double kRefineStep = 0.5 ; // degrees
+    static const unsigned int kCacheVersion = 2 ; // Increase it when the fiducial cuts change, so that the old caches are rebuilt
+
+  private :
+    int GetPdgIndex( const int pdg ) const ;
+    CellStatus GetCellStatus( const unsigned int pdg_id, const double mom, const double cos_theta, double phi ) ; // phi in degrees
+    bool IsDetected( const unsigned int pdg_id, const double momentum, const double cos_theta, const double phi ) const ; // phi in degrees
+    bool GetNode( const unsigned int pdg_id, const unsigned int mom_id, const unsigned int cos_id, const unsigned int phi_id ) ;
+    CellStatus ComputeCell( const unsigned int pdg_id, const unsigned int mom_id, const unsigned int cos_id, const unsigned int phi_id ) ;
+    std::string GetCacheTag(void) const ;
+    unsigned long ComputeCutFingerprint(void) const ; // Hash of the exact cut on a fixed set of points
+    bool ReadCache(void) ;
+    bool WriteCache(void) const ;
+
+    const Fiducial * kFiducial = nullptr ;
+    double kEBeam = 0 ;
+    int kTorusCurrent = 0 ;
+    std::string kCacheFile ;
+    unsigned long kCutFingerprint = 0 ;
+    std::atomic<bool> kIsModified ;
+
+    // Per particle. Nodes : 0 unknown, 1 outside, 2 inside. Cells : CellStatus
+    std::vector<std::atomic<unsigned char>> kNodes[kNPdgs] ;
+    std::vector<std::atomic<unsigned char>> kCells[kNPdgs] ;
+  };
+}
+
+#endif
@@ -0,0 +1,77 @@
+/**
+ * This class computes the fiducial acceptance of particles rotated around an axis
+ **/
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include "TMath.h"
+#include "utils/OrbitAcceptance.h"
+#include "utils/RotationKernel.h"
+
+using namespace e4nu ;
+
+OrbitAcceptance::OrbitAcceptance( const Fiducial * fiducial, const double EBeam, const bool is_data ) :
+  kFiducial( fiducial ), kEBeam( EBeam ), kIsData( is_data ) {;}
+
+bool OrbitAcceptance::IsDetected( const int pdg, const TVector3 & momentum, const TVector3 & unit_axis, const double angle ) const {
+  TVector3 rotated = RotationKernel::Rotate( momentum, unit_axis, std::cos( angle ), std::sin( angle ) ) ;
+  return kFiducial->FiducialCut( pdg, kEBeam, rotated, kIsData ) ;
+}
+
+void OrbitAcceptance::GetOrbit( const int pdg, const TVector3 & momentum, const TVector3 & axis, Orbit & orbit ) const {
+  orbit.edges.clear() ;
+  double step = 2 * TMath::Pi() / kGridPoints ;
+  TVector3 unit_axis = axis.Mag() > 0 ? axis.Unit() : TVector3( 0, 0, 0 ) ;
+
+  // The grid is rotated at once
+  std::vector<double> grid( kGridPoints ) ;
+  for( unsigned int i = 0 ; i < kGridPoints ; ++i ) grid[i] = i * step ;
+  RotationKernel kernel( axis, std::vector<TVector3>( 1, momentum ) ) ;
+  kernel.Rotate( grid ) ;
+  std::unique_ptr<bool[]> grid_status( new bool[kGridPoints] ) ;
+  kFiducial->FiducialCutBatch( pdg, kEBeam, kGridPoints, kernel.GetX( 0 ), kernel.GetY( 0 ), kernel.GetZ( 0 ), grid_status.get(), kIsData ) ;
+
+  bool first_status = grid_status[0] ;
+  orbit.is_detected_at_zero = first_status ;
+
+  bool status = first_status ;
+  for( unsigned int i = 1 ; i <= kGridPoints ; ++i ) {
+    // The last point is 2pi, which has the status of 0
+    bool next_status = i < kGridPoints ? grid_status[i] : first_status ;
+    if( next_status != status ) {
+      // Bisection of the edge
+      double low = ( i - 1 ) * step, high = i * step ;
+      while( high - low > kTolerance ) {
+	double mid = 0.5 * ( low + high ) ;
+	if( IsDetected( pdg, momentum, unit_axis, mid ) == status ) low = mid ;
+	else high = mid ;
+      }
+      orbit.edges.push_back( 0.5 * ( low + high ) ) ;
+    }
+    status = next_status ;
+  }
+}
+
+void OrbitAcceptance::GetSegments( const std::vector<int> & pdgs, const std::vector<TVector3> & momenta, const TVector3 & axis,
+				   std::vector<std::pair<unsigned long,double>> & segments ) const {
+  segments.clear() ;
+  // All the edges, with the particle index
+  unsigned long mask = 0 ;
+  std::vector<std::pair<double,unsigned int>> edges ;
+  Orbit orbit ;
+  for( unsigned int i = 0 ; i < pdgs.size() && i < 64 ; ++i ) {
+    GetOrbit( pdgs[i], momenta[i], axis, orbit ) ;
+    if( orbit.is_detected_at_zero ) mask |= 1UL << i ;
+    for( unsigned int j = 0 ; j < orbit.edges.size() ; ++j ) edges.push_back( std::make_pair( orbit.edges[j], i ) ) ;
+  }
+  std::sort( edges.begin(), edges.end() ) ;
+
+  // Each edge changes the status of one particle
+  double start = 0 ;
+  for( unsigned int i = 0 ; i < edges.size() ; ++i ) {
+    if( edges[i].first > start ) segments.push_back( std::make_pair( mask, edges[i].first - start ) ) ;
+    mask ^= 1UL << edges[i].second ;
+    start = edges[i].first ;
+  }
+  segments.push_back( std::make_pair( mask, 2 * TMath::Pi() - start ) ) ;
+}
@@ -0,0 +1,50 @@
+/**
+ * This class computes the fiducial acceptance of particles rotated around an axis (i.e. q3)
+ * The acceptance of a particle along the rotation orbit is a union of angular intervals
+ * bounded by the fiducial cut edges. The edges are located by evaluating the fiducial cut on a coarse grid
+ * of rotation angles and bisecting each change of status down to kTolerance
+ *
+ * For a list of particles, the orbit is divided in segments with the same detected particles.
+ * The segment length over 2pi is the exact probability of the corresponding combination
+ * Acceptance intervals narrower than the grid step can be missed
+ **/
+
+#ifndef _ORBIT_ACCEPTANCE_H_
+#define _ORBIT_ACCEPTANCE_H_
+
+#include <vector>
+#include <utility>
+#include "TVector3.h"
+#include "utils/Fiducial.h"
+
+namespace e4nu {
+
+  class OrbitAcceptance {
+  public :
+    OrbitAcceptance( const Fiducial * fiducial, const double EBeam, const bool is_data ) ;
+
+    // Status of one particle along the orbit : status at angle 0 and sorted angles in (0,2pi) where the status changes
+    struct Orbit {
+      bool is_detected_at_zero = false ;
+      std::vector<double> edges ;
+    } ;
+    void GetOrbit( const int pdg, const TVector3 & momentum, const TVector3 & axis, Orbit & orbit ) const ;
+
+    // Segments of the orbit for a list of particles (up to 64). Each segment is stored as
+    // ( detected particles mask, length in radians ). Bit i corresponds to particle i
+    void GetSegments( const std::vector<int> & pdgs, const std::vector<TVector3> & momenta, const TVector3 & axis,
+		      std::vector<std::pair<unsigned long,double>> & segments ) const ;
+
+    static const unsigned int kGridPoints = 180 ; // 2 degrees
+    static constexpr double kTolerance = 1E-6 ; // radians
+
+  private :
+    bool IsDetected( const int pdg, const TVector3 & momentum, const TVector3 & unit_axis, const double angle ) const ;
+
+    const Fiducial * kFiducial = nullptr ;
+    double kEBeam = 0 ;
+    bool kIsData = false ;
+  };
+}
+
+#endif
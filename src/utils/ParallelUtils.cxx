@@ -0,0 +1,33 @@
+/**
+ * This file contains utils to run independent tasks in parallel
+ **/
+#include <thread>
+#include <atomic>
+#include <vector>
+#include "utils/ParallelUtils.h"
+
+using namespace e4nu;
+
+void utils::ParallelFor( const unsigned int n, const unsigned int n_threads, const std::function<void(unsigned int)> & task ) {
+  if( n_threads <= 1 || n <= 1 ) {
+    for( unsigned int i = 0 ; i < n ; ++i ) task( i ) ;
+    return ;
+  }
+
+  std::atomic<unsigned int> next( 0 ) ;
+  auto worker = [&]() {
+    for( unsigned int i = next++ ; i < n ; i = next++ ) task( i ) ;
+  } ;
+
+  unsigned int n_workers = n_threads < n ? n_threads : n ;
+  std::vector<std::thread> threads ;
+  for( unsigned int i = 1 ; i < n_workers ; ++i ) threads.push_back( std::thread( worker ) ) ;
+  worker() ;
+  for( unsigned int i = 0 ; i < threads.size() ; ++i ) threads[i].join() ;
+}
+
+unsigned int utils::GetNThreads( const unsigned int n_threads ) {
+  if( n_threads > 0 ) return n_threads ;
+  unsigned int n_cores = std::thread::hardware_concurrency() ;
+  return n_cores > 0 ? n_cores : 1 ;
+}
@@ -0,0 +1,24 @@
+/**
+ * This file contains utils to run independent tasks in parallel
+ * The tasks are claimed one by one from a shared counter, so that threads
+ * which finish cheap tasks take over the remaining ones
+ **/
+
+#ifndef _PARALLEL_UTILS_H_
+#define _PARALLEL_UTILS_H_
+
+#include <functional>
+
+namespace e4nu {
+  namespace utils
+  {
+    // Calls task(i) for i in [0,n) using n_threads threads (including the calling thread)
+    // The tasks must be independent. Results should be stored per task, so that they don't depend on the scheduling
+    void ParallelFor( const unsigned int n, const unsigned int n_threads, const std::function<void(unsigned int)> & task ) ;
+
+    // Number of threads for a configured value. 0 means all the available cores
+    unsigned int GetNThreads( const unsigned int n_threads ) ;
+  }
+}
+
+#endif
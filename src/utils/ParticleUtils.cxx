@@ -6,7 +6,6 @@
 #include "utils/ParticleUtils.h"
 #include "conf/ParticleI.h"
 #include <TMath.h>
-#include <TRandom3.h>
 
 using namespace e4nu ; 
 
@@ -33,12 +32,12 @@ double utils::GetParticleMass( const int pdg ) {
   return mass ; 
 }
 
-void utils::ApplyResolution( const int pdg, TLorentzVector & mom, const double EBeam ) {
+void utils::ApplyResolution( const int pdg, TLorentzVector & mom, const double EBeam, const CounterRNG & rng, const unsigned int counter ) {
   double res = utils::GetParticleResolucion( pdg, EBeam ) ;
   double p = mom.P() ;
   double M = GetParticleMass( pdg ) ;
   
-  double SmearedP = gRandom->Gaus(p,res*p);
+  double SmearedP = rng.Gaus(counter,p,res*p);
   double SmearedE = sqrt( pow( SmearedP,2 ) + pow( M,2 ) ) ; 
 
   mom.SetPxPyPzE( SmearedP/p * mom.Px(), SmearedP/p * mom.Py(), SmearedP/p * mom.Pz(), SmearedE ) ; 
@@ -9,11 +9,13 @@
 #include <iostream>
 #include <string> 
 #include "TLorentzVector.h"
+#include "utils/CounterRNG.h"
 
 namespace e4nu { 
   namespace utils
     {
-      void ApplyResolution( const int pdg, TLorentzVector & mom, const double EBeam ) ; 
+      // The smearing uses the Gaussian number counter of the event stream rng
+      void ApplyResolution( const int pdg, TLorentzVector & mom, const double EBeam, const CounterRNG & rng, const unsigned int counter ) ; 
       double GetParticleResolucion( const int particle_pdg, const double EBeam ) ; 
       double GetParticleMass( const int pdg ) ; 
       int GetParticleCharge( const int pdg ) ;
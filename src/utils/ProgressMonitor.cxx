@@ -0,0 +1,77 @@
+/**
+ * This class reports the progress of the event loop
+ **/
+#include <iostream>
+#include <iomanip>
+#include <unistd.h>
+#include "utils/ProgressMonitor.h"
+
+using namespace e4nu ;
+
+ProgressMonitor::ProgressMonitor( const unsigned int total_events, const unsigned int print_interval,
+				  const std::string stats_file, const double stats_interval, const unsigned int first_event ) :
+  kTotalEvents( total_events ), kFirstEvent( first_event ), kPrintInterval( print_interval ), kStatsInterval( stats_interval ) {
+  kLastPrintEvents = first_event ;
+  kStart = std::chrono::steady_clock::now() ;
+  if( kStatsInterval > 0 && stats_file.size() ) {
+    kStatsFile.open( stats_file.c_str(), std::ios::app ) ;
+    if( ! kStatsFile.is_open() ) std::cout << " WARN : Cannot open stats file " << stats_file << std::endl;
+  }
+}
+
+ProgressMonitor::~ProgressMonitor() {
+  if( kStatsFile.is_open() ) kStatsFile.close() ;
+}
+
+double ProgressMonitor::GetElapsedTime(void) const {
+  return std::chrono::duration<double>( std::chrono::steady_clock::now() - kStart ).count() ;
+}
+
+bool ProgressMonitor::IsReportDue( const unsigned int n_events ) {
+  kPrintDue = kPrintInterval > 0 && n_events % kPrintInterval == 0 ;
+  // The clock is only checked every 1024 events
+  kStatsDue = false ;
+  if( kStatsFile.is_open() && n_events % 1024 == 0 ) kStatsDue = GetElapsedTime() - kLastStatsTime >= kStatsInterval ;
+  return kPrintDue || kStatsDue ;
+}
+
+void ProgressMonitor::Report( const unsigned int n_events, const unsigned int n_selected, const unsigned long holder_size, const bool is_last ) {
+  double time = GetElapsedTime() ;
+  double rate = time > 0 && n_events > kFirstEvent ? ( n_events - kFirstEvent ) / time : 0 ;
+  double selected_rate = time > 0 ? n_selected / time : 0 ;
+  double eta = rate > 0 && kTotalEvents > n_events ? ( kTotalEvents - n_events ) / rate : 0 ;
+  double memory = GetResidentMemory() ;
+
+  if( kPrintDue || is_last ) {
+    // Rates since the previous line
+    double dt = time - kLastPrintTime ;
+    double recent_rate = dt > 0 ? ( n_events - kLastPrintEvents ) / dt : rate ;
+    double recent_selected_rate = dt > 0 ? ( n_selected - kLastPrintSelected ) / dt : selected_rate ;
+    int percentage = kTotalEvents > 0 ? int( 100. * n_events / kTotalEvents ) : 100 ;
+    std::cout << " Event " << n_events << "/" << kTotalEvents << " (" << percentage << " %) : "
+	      << std::fixed << std::setprecision(0) << recent_rate << " events/s, " << recent_selected_rate << " selected/s, ETA "
+	      << eta << " s, RSS " << memory << " MB, holder " << holder_size << " events" << std::defaultfloat << std::endl;
+    kLastPrintTime = time ;
+    kLastPrintEvents = n_events ;
+    kLastPrintSelected = n_selected ;
+  }
+
+  if( kStatsFile.is_open() && ( kStatsDue || is_last ) ) {
+    kStatsFile << "{\"time\":" << time << ",\"events\":" << n_events << ",\"total_events\":" << kTotalEvents
+	       << ",\"selected\":" << n_selected << ",\"events_per_s\":" << rate << ",\"selected_per_s\":" << selected_rate
+	       << ",\"eta_s\":" << eta << ",\"rss_mb\":" << memory << ",\"holder_events\":" << holder_size
+	       << ",\"done\":" << ( is_last ? "true" : "false" ) << "}" << std::endl;
+    kLastStatsTime = time ;
+  }
+  kPrintDue = false ;
+  kStatsDue = false ;
+}
+
+double ProgressMonitor::GetResidentMemory(void) {
+  // Second field of /proc/self/statm is the number of resident pages
+  std::ifstream statm( "/proc/self/statm" ) ;
+  if( ! statm.is_open() ) return 0 ;
+  unsigned long size = 0, resident = 0 ;
+  statm >> size >> resident ;
+  return resident * (double) sysconf( _SC_PAGESIZE ) / ( 1024. * 1024. ) ;
+}
@@ -0,0 +1,50 @@
+/**
+ * This class reports the progress of the event loop
+ * Every kPrintInterval events, a single line is printed with the event rate, the selected event rate,
+ * the ETA, the resident memory and the number of events stored in the analysis holder
+ * Every kStatsInterval seconds, the same numbers are appended as a JSON line to the stats file
+ **/
+
+#ifndef _PROGRESS_MONITOR_H_
+#define _PROGRESS_MONITOR_H_
+
+#include <string>
+#include <fstream>
+#include <chrono>
+
+namespace e4nu {
+
+  class ProgressMonitor {
+  public :
+    // first_event is used when the loop does not start from 0 (i.e. resumed runs)
+    ProgressMonitor( const unsigned int total_events, const unsigned int print_interval,
+		     const std::string stats_file, const double stats_interval, const unsigned int first_event = 0 ) ;
+    virtual ~ProgressMonitor() ;
+
+    // Cheap check, called for every event
+    bool IsReportDue( const unsigned int n_events ) ;
+    void Report( const unsigned int n_events, const unsigned int n_selected, const unsigned long holder_size, const bool is_last = false ) ;
+
+    // Resident memory in MB. It returns 0 if it is not available
+    static double GetResidentMemory(void) ;
+
+  private :
+    double GetElapsedTime(void) const ;
+
+    unsigned int kTotalEvents = 0 ;
+    unsigned int kFirstEvent = 0 ;
+    unsigned int kPrintInterval = 0 ;
+    double kStatsInterval = 0 ;
+    std::ofstream kStatsFile ;
+
+    std::chrono::steady_clock::time_point kStart ;
+    bool kPrintDue = false ;
+    bool kStatsDue = false ;
+    double kLastStatsTime = 0 ;
+    double kLastPrintTime = 0 ;
+    unsigned int kLastPrintEvents = 0 ;
+    unsigned int kLastPrintSelected = 0 ;
+  };
+}
+
+#endif
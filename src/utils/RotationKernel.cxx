@@ -0,0 +1,68 @@
+/**
+ * This class rotates a list of momenta around a fixed axis for a list of angles
+ **/
+#include <cmath>
+#include "utils/RotationKernel.h"
+
+using namespace e4nu ;
+
+RotationKernel::RotationKernel( const TVector3 & axis, const std::vector<TVector3> & momenta ) {
+  this->SetAxis( axis ) ;
+  this->SetMomenta( momenta ) ;
+}
+
+void RotationKernel::SetAxis( const TVector3 & axis ) {
+  double mag = axis.Mag() ;
+  kAxis = mag > 0 ? axis * ( 1. / mag ) : TVector3( 0, 0, 0 ) ;
+}
+
+void RotationKernel::SetMomenta( const std::vector<TVector3> & momenta ) {
+  unsigned int n = momenta.size() ;
+  kParX.resize( n ) ; kParY.resize( n ) ; kParZ.resize( n ) ;
+  kPerpX.resize( n ) ; kPerpY.resize( n ) ; kPerpZ.resize( n ) ;
+  kCrossX.resize( n ) ; kCrossY.resize( n ) ; kCrossZ.resize( n ) ;
+  for( unsigned int i = 0 ; i < n ; ++i ) {
+    TVector3 par = kAxis * momenta[i].Dot( kAxis ) ;
+    TVector3 perp = momenta[i] - par ;
+    TVector3 cross = kAxis.Cross( perp ) ;
+    kParX[i] = par.X() ; kParY[i] = par.Y() ; kParZ[i] = par.Z() ;
+    kPerpX[i] = perp.X() ; kPerpY[i] = perp.Y() ; kPerpZ[i] = perp.Z() ;
+    kCrossX[i] = cross.X() ; kCrossY[i] = cross.Y() ; kCrossZ[i] = cross.Z() ;
+  }
+}
+
+void RotationKernel::Rotate( const std::vector<double> & angles ) {
+  unsigned int n_angles = angles.size() ;
+  kCos.resize( n_angles ) ;
+  kSin.resize( n_angles ) ;
+  for( unsigned int j = 0 ; j < n_angles ; ++j ) {
+    kCos[j] = std::cos( angles[j] ) ;
+    kSin[j] = std::sin( angles[j] ) ;
+  }
+
+  unsigned int n_particles = kParX.size() ;
+  kX.resize( n_particles * n_angles ) ;
+  kY.resize( n_particles * n_angles ) ;
+  kZ.resize( n_particles * n_angles ) ;
+  const double * c = kCos.data() ;
+  const double * s = kSin.data() ;
+  for( unsigned int i = 0 ; i < n_particles ; ++i ) {
+    double * x = kX.data() + i * n_angles ;
+    double * y = kY.data() + i * n_angles ;
+    double * z = kZ.data() + i * n_angles ;
+    const double par_x = kParX[i], par_y = kParY[i], par_z = kParZ[i] ;
+    const double perp_x = kPerpX[i], perp_y = kPerpY[i], perp_z = kPerpZ[i] ;
+    const double cross_x = kCrossX[i], cross_y = kCrossY[i], cross_z = kCrossZ[i] ;
+    for( unsigned int j = 0 ; j < n_angles ; ++j ) {
+      x[j] = par_x + perp_x * c[j] + cross_x * s[j] ;
+      y[j] = par_y + perp_y * c[j] + cross_y * s[j] ;
+      z[j] = par_z + perp_z * c[j] + cross_z * s[j] ;
+    }
+  }
+}
+
+TVector3 RotationKernel::Rotate( const TVector3 & v, const TVector3 & unit_axis, const double cos, const double sin ) {
+  TVector3 par = unit_axis * v.Dot( unit_axis ) ;
+  TVector3 perp = v - par ;
+  return par + perp * cos + unit_axis.Cross( perp ) * sin ;
+}
@@ -0,0 +1,59 @@
+/**
+ * This class rotates a list of momenta around a fixed axis (i.e. q3) for a list of angles
+ * Each momentum is decomposed once in the Rodrigues basis of the axis :
+ *   v(angle) = v_par + v_perp * cos(angle) + ( axis x v_perp ) * sin(angle)
+ * The sine and cosine of each angle are computed once for all the particles
+ * The rotated momenta are stored as structure of arrays, with index particle * n_angles + angle,
+ * so that the loop over angles is contiguous and can be vectorised by the compiler
+ *
+ * The rotation is the same as TVector3::Rotate(angle,axis). A null axis gives the identity
+ **/
+
+#ifndef _ROTATION_KERNEL_H_
+#define _ROTATION_KERNEL_H_
+
+#include <vector>
+#include "TVector3.h"
+
+namespace e4nu {
+
+  class RotationKernel {
+  public :
+    RotationKernel() {;}
+    RotationKernel( const TVector3 & axis, const std::vector<TVector3> & momenta ) ;
+
+    void SetAxis( const TVector3 & axis ) ;
+    void SetMomenta( const std::vector<TVector3> & momenta ) ;
+
+    // Rotates all the momenta for all the angles
+    void Rotate( const std::vector<double> & angles ) ;
+
+    unsigned int GetNParticles(void) const { return kParX.size() ; }
+    unsigned int GetNAngles(void) const { return kCos.size() ; }
+    TVector3 GetRotated( const unsigned int particle, const unsigned int angle ) const {
+      unsigned int i = particle * kCos.size() + angle ;
+      return TVector3( kX[i], kY[i], kZ[i] ) ;
+    }
+    // Rotated components of a particle for all the angles (i.e. for Fiducial::FiducialCutBatch)
+    const double * GetX( const unsigned int particle ) const { return kX.data() + particle * kCos.size() ; }
+    const double * GetY( const unsigned int particle ) const { return kY.data() + particle * kCos.size() ; }
+    const double * GetZ( const unsigned int particle ) const { return kZ.data() + particle * kCos.size() ; }
+
+    // Single rotation of v around a unit axis, for a precomputed cosine and sine
+    static TVector3 Rotate( const TVector3 & v, const TVector3 & unit_axis, const double cos, const double sin ) ;
+
+  private :
+    TVector3 kAxis ; // Unit axis, or null
+
+    // Rodrigues basis of each particle
+    std::vector<double> kParX, kParY, kParZ ;
+    std::vector<double> kPerpX, kPerpY, kPerpZ ;
+    std::vector<double> kCrossX, kCrossY, kCrossZ ;
+
+    // Angles and rotated momenta
+    std::vector<double> kCos, kSin ;
+    std::vector<double> kX, kY, kZ ;
+  };
+}
+
+#endif
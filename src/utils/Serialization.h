@@ -0,0 +1,123 @@
+/**
+ * This file contains helpers to write and read analysis state in binary format
+ * They are used for the analysis checkpoints. The format is not portable across architectures
+ **/
+
+#ifndef _SERIALIZATION_H_
+#define _SERIALIZATION_H_
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+#include <type_traits>
+#include "TLorentzVector.h"
+
+namespace e4nu {
+  namespace utils
+  {
+    // Declarations, so that nested containers find every overload
+    template <class T> void WriteBinary( std::ostream & out, const std::vector<T> & value ) ;
+    template <class T> bool ReadBinary( std::istream & in, std::vector<T> & value ) ;
+    template <class T1, class T2> void WriteBinary( std::ostream & out, const std::pair<T1,T2> & value ) ;
+    template <class T1, class T2> bool ReadBinary( std::istream & in, std::pair<T1,T2> & value ) ;
+    template <class K, class T> void WriteBinary( std::ostream & out, const std::map<K,T> & value ) ;
+    template <class K, class T> bool ReadBinary( std::istream & in, std::map<K,T> & value ) ;
+    inline void WriteBinary( std::ostream & out, const std::string & value ) ;
+    inline bool ReadBinary( std::istream & in, std::string & value ) ;
+    inline void WriteBinary( std::ostream & out, const TLorentzVector & value ) ;
+    inline bool ReadBinary( std::istream & in, TLorentzVector & value ) ;
+
+    template <class T>
+      void WriteBinary( std::ostream & out, const T & value ) {
+      static_assert( std::is_trivially_copyable<T>::value, "Only trivially copyable types can be written directly" ) ;
+      out.write( reinterpret_cast<const char*>( &value ), sizeof(T) ) ;
+    }
+
+    template <class T>
+      bool ReadBinary( std::istream & in, T & value ) {
+      static_assert( std::is_trivially_copyable<T>::value, "Only trivially copyable types can be read directly" ) ;
+      in.read( reinterpret_cast<char*>( &value ), sizeof(T) ) ;
+      return in.good() ;
+    }
+
+    inline void WriteBinary( std::ostream & out, const std::string & value ) {
+      WriteBinary( out, (unsigned long) value.size() ) ;
+      out.write( value.data(), value.size() ) ;
+    }
+
+    inline bool ReadBinary( std::istream & in, std::string & value ) {
+      unsigned long size = 0 ;
+      if( ! ReadBinary( in, size ) ) return false ;
+      value.resize( size ) ;
+      in.read( &value[0], size ) ;
+      return in.good() ;
+    }
+
+    inline void WriteBinary( std::ostream & out, const TLorentzVector & value ) {
+      WriteBinary( out, value.Px() ) ; WriteBinary( out, value.Py() ) ;
+      WriteBinary( out, value.Pz() ) ; WriteBinary( out, value.E() ) ;
+    }
+
+    inline bool ReadBinary( std::istream & in, TLorentzVector & value ) {
+      double px = 0, py = 0, pz = 0, E = 0 ;
+      if( ! ( ReadBinary( in, px ) && ReadBinary( in, py ) && ReadBinary( in, pz ) && ReadBinary( in, E ) ) ) return false ;
+      value.SetPxPyPzE( px, py, pz, E ) ;
+      return true ;
+    }
+
+    template <class T>
+      void WriteBinary( std::ostream & out, const std::vector<T> & value ) {
+      WriteBinary( out, (unsigned long) value.size() ) ;
+      for( unsigned long i = 0 ; i < value.size() ; ++i ) WriteBinary( out, value[i] ) ;
+    }
+
+    template <class T>
+      bool ReadBinary( std::istream & in, std::vector<T> & value ) {
+      unsigned long size = 0 ;
+      if( ! ReadBinary( in, size ) ) return false ;
+      value.resize( size ) ;
+      for( unsigned long i = 0 ; i < size ; ++i ) {
+	if( ! ReadBinary( in, value[i] ) ) return false ;
+      }
+      return true ;
+    }
+
+    template <class T1, class T2>
+      void WriteBinary( std::ostream & out, const std::pair<T1,T2> & value ) {
+      WriteBinary( out, value.first ) ;
+      WriteBinary( out, value.second ) ;
+    }
+
+    template <class T1, class T2>
+      bool ReadBinary( std::istream & in, std::pair<T1,T2> & value ) {
+      return ReadBinary( in, value.first ) && ReadBinary( in, value.second ) ;
+    }
+
+    template <class K, class T>
+      void WriteBinary( std::ostream & out, const std::map<K,T> & value ) {
+      WriteBinary( out, (unsigned long) value.size() ) ;
+      for( auto it = value.begin() ; it != value.end() ; ++it ) {
+	WriteBinary( out, it->first ) ;
+	WriteBinary( out, it->second ) ;
+      }
+    }
+
+    template <class K, class T>
+      bool ReadBinary( std::istream & in, std::map<K,T> & value ) {
+      unsigned long size = 0 ;
+      if( ! ReadBinary( in, size ) ) return false ;
+      value.clear() ;
+      for( unsigned long i = 0 ; i < size ; ++i ) {
+	K key ;
+	T element ;
+	if( ! ( ReadBinary( in, key ) && ReadBinary( in, element ) ) ) return false ;
+	value[key] = element ;
+      }
+      return true ;
+    }
+  }
+}
+
+#endif
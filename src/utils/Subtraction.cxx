@@ -8,7 +8,6 @@
 #include <TMath.h>
 #include <TLorentzVector.h>
 #include <TVectorT.h>
-#include <TRandom3.h>
 #include <TF1.h>
 #include <TGraph.h>
 #include "utils/Subtraction.h"
@@ -16,40 +15,36 @@
 
 using namespace e4nu ; 
 
+// Each *_rot_func rotates its particles once with the generic engine (RotateSubsets)
+// The probabilities are computed in the corresponding *_count_func. The sub-topology probabilities
+// are computed from the same counts, projected on the sub-topology particles (ProjectCounts)
+
 void Subtraction::prot3_rot_func(TVector3  V3prot[3],TVector3  V3prot_uncorr[3],TLorentzVector V4el,double Ecal_3pto2p[][2],
 				 double  pmiss_perp_3pto2p[][2],double  P3pto2p[][2],double N_p1[3],double Ecal_3pto1p[3],
 				 double pmiss_perp_3pto1p[3], double *N_p3det){
 
+  const bool is_proton[3]={true,true,true};
+  const int q[3]={1,1,1};
+  double counts[8];
+  RotateSubsets<3>(V3prot_uncorr,is_proton,q,counts);
+  prot3_count_func(counts,V3prot,V4el,Ecal_3pto2p,pmiss_perp_3pto2p,P3pto2p,N_p1,Ecal_3pto1p,pmiss_perp_3pto1p,N_p3det);
+}
+
+void Subtraction::prot3_count_func(const double counts[8], TVector3 V3prot[3], TLorentzVector V4el, double Ecal_3pto2p[][2], double pmiss_perp_3pto2p[][2],
+				   double P3pto2p[][2], double N_p1[3], double Ecal_3pto1p[3], double pmiss_perp_3pto1p[3], double *N_p3det){
+
   double m_prot=conf::kProtonMass;
   const int N_3p=3, N_2p=2;
   double N_p2[N_3p]={0},N_p1det[3][N_3p]={0};
-  TVector3 V3_3p_rot[N_3p],V3_2p_rot[N_3p],V3_prot_el_3pto2p[N_2p],V3_prot_el_3pto1p[N_3p];
-  double rot_angle;
-  double N_pthree=0;
-  bool prot_stat[N_3p];
+  TVector3 V3_prot_el_3pto2p[N_2p],V3_prot_el_3pto1p[N_3p];
   int count =0;
 
-  for(int g=0; g<N_tot; g++){
-    rot_angle = gRandom->Uniform(0,2*TMath::Pi());
-
-    for(int i=0;i<N_3p;i++) {
-      V3_3p_rot[i]= V3prot_uncorr[i];
-      V3_3p_rot[i].Rotate(rot_angle,V3q);
-    }
-
-
-    for(int ind_p=0;ind_p<N_3p;ind_p++) prot_stat[ind_p]=PFiducialCut(fbeam_en, V3_3p_rot[ind_p]);
-
-    if( prot_stat[0]  && !prot_stat[1]  && !prot_stat[2])  N_p1[0]=N_p1[0]+1;
-    if(!prot_stat[0] &&   prot_stat[1]  && !prot_stat[2])  N_p1[1]=N_p1[1]+1;
-    if(!prot_stat[0] &&  !prot_stat[1]  &&  prot_stat[2])  N_p1[2]=N_p1[2]+1;
-    if( prot_stat[0]  &&  prot_stat[1]  &&  prot_stat[2])  N_pthree=N_pthree+1;
-
-    if(prot_stat[0] && prot_stat[1] && !prot_stat[2])   N_p2[0]=N_p2[0]+1;
-    if(prot_stat[0] && !prot_stat[1] && prot_stat[2])   N_p2[1]=N_p2[1]+1;
-    if(!prot_stat[0] && prot_stat[1] && prot_stat[2])   N_p2[2]=N_p2[2]+1;
-
-  }//for loop of 3p rotations ends
+  // Bit i is proton i
+  for(int j=0;j<N_3p;j++) N_p1[j]=N_p1[j]+counts[1<<j];
+  double N_pthree=counts[7];
+  N_p2[0]=counts[1|2];
+  N_p2[1]=counts[1|4];
+  N_p2[2]=counts[2|4];
 
    //-----------------------------------------  3p to 1p  -----------------------------------------------------------------------
   for(int j=0;j<N_3p;j++)    { //looping through 1p combinations out of 3protons
@@ -65,20 +60,10 @@ void Subtraction::prot3_rot_func(TVector3  V3prot[3],TVector3  V3prot_uncorr[3],
     for(int ind2=0;ind2<N_3p;ind2++){
       if(ind1!=ind2 && ind1<ind2){
 
-	for(int g1=0; g1<N_tot; g1++){
-
-	  rot_angle=gRandom->Uniform(0,2*TMath::Pi());
-
-	  V3_2p_rot[ind1]=V3prot_uncorr[ind1];
-	  V3_2p_rot[ind2]=V3prot_uncorr[ind2];
-	  V3_2p_rot[ind1].Rotate(rot_angle,V3q);
-	  V3_2p_rot[ind2].Rotate(rot_angle,V3q);
-
-	  if(PFiducialCut(fbeam_en, V3_2p_rot[ind1])  && !PFiducialCut(fbeam_en, V3_2p_rot[ind2])) N_p1det[count][0]=N_p1det[count][0]+1;
-	  if(!PFiducialCut(fbeam_en, V3_2p_rot[ind1]) && PFiducialCut(fbeam_en, V3_2p_rot[ind2]))  N_p1det[count][1]=N_p1det[count][1]+1;
-	  if(PFiducialCut(fbeam_en, V3_2p_rot[ind1])  && PFiducialCut(fbeam_en, V3_2p_rot[ind2]))  N_p1det[count][2]=N_p1det[count][2]+1;
-	}
-
+	unsigned int pair=(1<<ind1)|(1<<ind2);
+	N_p1det[count][0]=CountStatus<3>(counts,pair,1<<ind1);
+	N_p1det[count][1]=CountStatus<3>(counts,pair,1<<ind2);
+	N_p1det[count][2]=CountStatus<3>(counts,pair,pair);
 
 	if( N_p1det[count][2]!=0   && N_pthree!=0){
 
@@ -106,24 +91,23 @@ void Subtraction::prot3_rot_func(TVector3  V3prot[3],TVector3  V3prot_uncorr[3],
 
 void  Subtraction::prot2_rot_func(TVector3  V3prot[2],TVector3  V3prot_uncorr[2],TLorentzVector V4el,double Ecal_2pto1p[2],double  pmiss_perp_2pto1p[2],double  P2pto1p[2], double *Nboth){
 
+  const bool is_proton[2]={true,true};
+  const int q[2]={1,1};
+  double counts[4];
+  RotateSubsets<2>(V3prot_uncorr,is_proton,q,counts);
+  prot2_count_func(counts,V3prot,V4el,Ecal_2pto1p,pmiss_perp_2pto1p,P2pto1p,Nboth);
+}
 
-  const int N2=2;
-  double rot_angle, N_p2to1[N2]={0},m_prot=0.9382720813;
-  TVector3 V3_2prot[N2], V3_prot_el_2pto1p[N2];
-  double N_2=0;
-
-  for(int g1=0; g1<N_tot; g1++){
-    rot_angle = gRandom->Uniform(0,2*TMath::Pi());
+void  Subtraction::prot2_count_func(const double counts[4], TVector3 V3prot[2], TLorentzVector V4el, double Ecal_2pto1p[2], double pmiss_perp_2pto1p[2], double P2pto1p[2], double *Nboth){
 
-    V3_2prot[0]=V3prot_uncorr[0];
-    V3_2prot[1]=V3prot_uncorr[1];
-    V3_2prot[0].Rotate(rot_angle,V3q);
-    V3_2prot[1].Rotate(rot_angle,V3q);
+  const int N2=2;
+  double N_p2to1[N2]={0},m_prot=0.9382720813;
+  TVector3 V3_prot_el_2pto1p[N2];
 
-    if(PFiducialCut(fbeam_en, V3_2prot[0])  && !PFiducialCut(fbeam_en, V3_2prot[1])) N_p2to1[0]=N_p2to1[0]+1;
-    if(!PFiducialCut(fbeam_en, V3_2prot[0]) && PFiducialCut(fbeam_en, V3_2prot[1]))  N_p2to1[1]=N_p2to1[1]+1;
-    if(PFiducialCut(fbeam_en, V3_2prot[0])  && PFiducialCut(fbeam_en, V3_2prot[1]))  N_2=N_2+1;
-  }
+  // Bit i is proton i
+  N_p2to1[0]=counts[1];
+  N_p2to1[1]=counts[2];
+  double N_2=counts[3];
 
   //-----------------------------------------  2p to 1p  -----------------------------------------------------------------------
   V3_prot_el_2pto1p[0]=V4el.Vect()+ V3prot[0];
@@ -150,65 +134,42 @@ void  Subtraction::prot2_rot_func(TVector3  V3prot[2],TVector3  V3prot_uncorr[2]
 
 void Subtraction::prot1_pi1_rot_func(TVector3  V3prot,TVector3 V3pi, int q_pi, double *N_pi_p,double *N_nopi_p){
 
-  double rotation_ang;
-  TVector3 V3_pi_rot, V3_p_rot;
-  bool pi_stat=true;
-
-  double Npi_p = 0;
-  double Nnopi_p = 0;
-
-  for(int g=0; g<N_tot; g++){
-
-    rotation_ang=gRandom->Uniform(0,2*TMath::Pi());
-    V3_p_rot= V3prot;
-    V3_p_rot.Rotate(rotation_ang,V3q);
-
-
-    V3_pi_rot=V3pi;
-    V3_pi_rot.Rotate(rotation_ang,V3q);
-    pi_stat=Pi_phot_fid_united(fbeam_en, V3_pi_rot,q_pi);
-
+  const TVector3 V3[2]={V3prot,V3pi};
+  const bool is_proton[2]={true,false};
+  const int q[2]={1,q_pi};
+  double counts[4];
+  RotateSubsets<2>(V3,is_proton,q,counts);
+  prot1_pi1_count_func(counts,N_pi_p,N_nopi_p);
+}
 
-    if(PFiducialCut(fbeam_en, V3_p_rot)  && pi_stat) Npi_p=Npi_p+1;
-    if(PFiducialCut(fbeam_en, V3_p_rot)  && !pi_stat) Nnopi_p=Nnopi_p+1;
+void Subtraction::prot1_pi1_count_func(const double counts[4], double *N_pi_p, double *N_nopi_p){
 
-  }
-  *N_pi_p=Npi_p;
-  *N_nopi_p=Nnopi_p;
+  // Bit 0 is the proton, bit 1 the pion
+  *N_pi_p=counts[1|2];
+  *N_nopi_p=counts[1];
 }
 
 
 void Subtraction::prot1_pi2_rot_func(TVector3  V3prot,TVector3 V3pi[2], int q_pi[2], double *P_1p0pi,double P_1p1pi[2]){
 
-  const int N_pi=2;
-  double rotation_ang;
-  TVector3 V3_rot_pi[2], V3_p_rot;
-  bool status_pi[2]={true};
-
-  double N_all = 0;
-  double Nnopi = 0,N_1p1pi[2]={0};
-
-  for(int g=0; g<N_tot; g++){
-
-    rotation_ang=gRandom->Uniform(0,2*TMath::Pi());
-    V3_p_rot= V3prot;
-
-    V3_p_rot.Rotate(rotation_ang,V3q);
-
-    for(int i=0;i<N_pi;i++){
-
-      V3_rot_pi[i]=V3pi[i];
-      V3_rot_pi[i].Rotate(rotation_ang,V3q);
-      status_pi[i]=Pi_phot_fid_united(fbeam_en, V3_rot_pi[i],q_pi[i]);
+  const TVector3 V3[3]={V3prot,V3pi[0],V3pi[1]};
+  const bool is_proton[3]={true,false,false};
+  const int q[3]={1,q_pi[0],q_pi[1]};
+  double counts[8];
+  RotateSubsets<3>(V3,is_proton,q,counts);
+  prot1_pi2_count_func(counts,P_1p0pi,P_1p1pi);
+}
 
-    }
+void Subtraction::prot1_pi2_count_func(const double counts[8], double *P_1p0pi, double P_1p1pi[2]){
 
-    if(PFiducialCut(fbeam_en, V3_p_rot)  && status_pi[0]  && !status_pi[1] ) N_1p1pi[0]=N_1p1pi[0]+1;
-    if(PFiducialCut(fbeam_en, V3_p_rot)  && !status_pi[0]  && status_pi[1] ) N_1p1pi[1]=N_1p1pi[1]+1;
-    if(PFiducialCut(fbeam_en, V3_p_rot)  && status_pi[0]  && status_pi[1] ) N_all=N_all+1;
-    if(PFiducialCut(fbeam_en, V3_p_rot)  && !status_pi[0]  && !status_pi[1]) Nnopi=Nnopi+1;
+  const int N_pi=2;
+  double N_1p1pi[2]={0};
 
-  }
+  // Bit 0 is the proton, bit 1+i the pion i
+  N_1p1pi[0]=counts[1|2];
+  N_1p1pi[1]=counts[1|4];
+  double N_all=counts[1|2|4];
+  double Nnopi=counts[1];
 
 
   if(N_all!=0){
@@ -220,7 +181,10 @@ void Subtraction::prot1_pi2_rot_func(TVector3  V3prot,TVector3 V3pi[2], int q_pi
 
     for(int h=0;h<N_pi;h++){
 
-      prot1_pi1_rot_func(V3prot,V3pi[h],q_pi[h],&N_pi_p,&N_nopi_p);
+      const unsigned int index[2]={0,(unsigned int)(1+h)};
+      double sub_counts[4];
+      ProjectCounts<3,2>(counts,index,sub_counts);
+      prot1_pi1_count_func(sub_counts,&N_pi_p,&N_nopi_p);
       if(N_pi_p!=0) P_1p1pi[h]=(N_1p1pi[h]/N_all)*(N_nopi_p/N_pi_p);
       else  P_1p1pi[h]=0;
     }
@@ -236,37 +200,32 @@ void Subtraction::prot1_pi2_rot_func(TVector3  V3prot,TVector3 V3pi[2], int q_pi
 
 void Subtraction::prot1_pi3_rot_func(TVector3  V3prot,TVector3 V3pi[3], int q_pi[3], double *P_tot){
 
-  *P_tot=0;
-  const int N_pi=3;
-  double rotation_ang;
-  TVector3 V3_rot_pi[N_pi], V3_p_rot;
-  bool status_pi[N_pi]={true};
-  double N_all = 0;
-  double Nnopi = 0,N_1p1pi[3]={0},N_1p2pi[3]={0};
-
-  for(int g=0; g<N_tot; g++){
-
-    rotation_ang=gRandom->Uniform(0,2*TMath::Pi());
-    V3_p_rot= V3prot;
+  const TVector3 V3[4]={V3prot,V3pi[0],V3pi[1],V3pi[2]};
+  const bool is_proton[4]={true,false,false,false};
+  const int q[4]={1,q_pi[0],q_pi[1],q_pi[2]};
+  double counts[16];
+  RotateSubsets<4>(V3,is_proton,q,counts);
+  prot1_pi3_count_func(counts,P_tot);
+}
 
-    V3_p_rot.Rotate(rotation_ang,V3q);
+void Subtraction::prot1_pi3_count_func(const double counts[16], double *P_tot){
 
-    for(int i=0;i<N_pi;i++){
+  *P_tot=0;
+  const int N_pi=3;
+  double N_1p1pi[3]={0},N_1p2pi[3]={0};
 
-      V3_rot_pi[i]=V3pi[i];
-      V3_rot_pi[i].Rotate(rotation_ang,V3q);
-      status_pi[i]=Pi_phot_fid_united(fbeam_en, V3_rot_pi[i],q_pi[i]);
-    }
+  // Bit 0 is the proton, bit 1+i the pion i
+  N_1p1pi[0]=counts[1|2];
+  N_1p1pi[1]=counts[1|4];
+  N_1p1pi[2]=counts[1|8];
+  N_1p2pi[0]=counts[1|2|4];
+  N_1p2pi[1]=counts[1|2|8];
+  N_1p2pi[2]=counts[1|4|8];
+  double N_all=counts[1|2|4|8];
+  double Nnopi=counts[1];
 
-    if(PFiducialCut(fbeam_en, V3_p_rot)  && status_pi[0]  && !status_pi[1] && !status_pi[2]) N_1p1pi[0]=N_1p1pi[0]+1;
-    if(PFiducialCut(fbeam_en, V3_p_rot)  && !status_pi[0]  && status_pi[1] && !status_pi[2]) N_1p1pi[1]=N_1p1pi[1]+1;
-    if(PFiducialCut(fbeam_en, V3_p_rot)  && !status_pi[0]  && !status_pi[1] && status_pi[2]) N_1p1pi[2]=N_1p1pi[2]+1;
-    if(PFiducialCut(fbeam_en, V3_p_rot)  && status_pi[0]  && status_pi[1] && !status_pi[2]) N_1p2pi[0]=N_1p2pi[0]+1;
-    if(PFiducialCut(fbeam_en, V3_p_rot)  && status_pi[0]  && !status_pi[1] && status_pi[2]) N_1p2pi[1]=N_1p2pi[1]+1;
-    if(PFiducialCut(fbeam_en, V3_p_rot)  && !status_pi[0]  && status_pi[1] && status_pi[2]) N_1p2pi[2]=N_1p2pi[2]+1;
-    if(PFiducialCut(fbeam_en, V3_p_rot)  && status_pi[0]  && status_pi[1] && status_pi[2])  N_all=N_all+1;
-    if(PFiducialCut(fbeam_en, V3_p_rot)  && !status_pi[0]  && !status_pi[1] && !status_pi[2])Nnopi=Nnopi+1;
-  }
+  // Pion pairs, in the same order as N_1p2pi
+  const unsigned int pairs[3][2]={{1,2},{1,3},{2,3}};
 
   if(N_all!=0){
     //----------------------1p3pi->1p0pi
@@ -277,36 +236,25 @@ void Subtraction::prot1_pi3_rot_func(TVector3  V3prot,TVector3 V3pi[3], int q_pi
     //----------------------1p3pi->1p1pi->1p0pi
     double N_nopi_p = 0,N_pi_p=0;
     const int N2pi=2;
-    TVector3 V3_pion[N2pi];
-    int q_pion[N2pi];
 
     double  P_1p1pi=0,P_1p2pi=0;
 
     for(int h=0;h<N_pi;h++){
 
-      prot1_pi1_rot_func(V3prot,V3pi[h],q_pi[h],&N_pi_p,&N_nopi_p);
+      const unsigned int index_1pi[2]={0,(unsigned int)(1+h)};
+      double counts_1pi[4];
+      ProjectCounts<4,2>(counts,index_1pi,counts_1pi);
+      prot1_pi1_count_func(counts_1pi,&N_pi_p,&N_nopi_p);
       if(N_pi_p!=0) P_1p1pi=P_1p1pi+(N_1p1pi[h]/N_all)*(N_nopi_p/N_pi_p);
 
       //----------------------1p3pi->1p2pi->1p0pi
       double P_1p1pion[N2pi]={0},P_1p0pion=0;
 
-      if(h==0)   {
-	V3_pion[0]=   V3pi[0];   V3_pion[1]=V3pi[1];
-	q_pion[0]=    q_pi[0];    q_pion[1]=q_pi[1];
-
-      }
-      if(h==1)   {
-	V3_pion[0]=   V3pi[0];    V3_pion[1]=V3pi[2];
-	q_pion[0]=    q_pi[0];     q_pion[1]=q_pi[2];
-
-      }
-      if(h==2)   {
-	V3_pion[0]=   V3pi[1];   V3_pion[1]=V3pi[2];
-	q_pion[0]=    q_pi[1];    q_pion[1]=q_pi[2];
-
-      }
       //----------------------1p3pi->1p2pi->1p1pi->1p0pi
-      prot1_pi2_rot_func(V3prot,V3_pion, q_pion,&P_1p0pion,P_1p1pion);
+      const unsigned int index_2pi[3]={0,pairs[h][0],pairs[h][1]};
+      double counts_2pi[8];
+      ProjectCounts<4,3>(counts,index_2pi,counts_2pi);
+      prot1_pi2_count_func(counts_2pi,&P_1p0pion,P_1p1pion);
       P_1p2pi=P_1p2pi+(N_1p2pi[h]/N_all)*(P_1p0pion-P_1p1pion[0]-P_1p1pion[1]);
 
     }//for loop ends
@@ -323,41 +271,38 @@ void Subtraction::prot1_pi3_rot_func(TVector3  V3prot,TVector3 V3pi[3], int q_pi
 
 void Subtraction::prot2_pi1_rot_func(TVector3 V3_2prot_corr[2],TVector3 V3_2prot_uncorr[2],TVector3 V3_1pi, int q_pi, TLorentzVector V4_el, double Ecal_2p1pi_to2p0pi[2],double p_miss_perp_2p1pi_to2p0pi[2],double P_2p1pito2p0pi[2],double P_2p1pito1p1pi[2],double P_2p1pito1p0pi[2],double *P_tot){
 
+  const TVector3 V3[3]={V3_2prot_uncorr[0],V3_2prot_uncorr[1],V3_1pi};
+  const bool is_proton[3]={true,true,false};
+  const int q[3]={1,1,q_pi};
+  double counts[8];
+  RotateSubsets<3>(V3,is_proton,q,counts);
+  prot2_pi1_count_func(counts,V3_2prot_corr,V4_el,Ecal_2p1pi_to2p0pi,p_miss_perp_2p1pi_to2p0pi,P_2p1pito2p0pi,P_2p1pito1p1pi,P_2p1pito1p0pi,P_tot);
+}
+
+void Subtraction::prot2_pi1_count_func(const double counts[8], TVector3 V3_2prot_corr[2], TLorentzVector V4_el, double Ecal_2p1pi_to2p0pi[2],
+				       double p_miss_perp_2p1pi_to2p0pi[2], double P_2p1pito2p0pi[2], double P_2p1pito1p1pi[2], double P_2p1pito1p0pi[2], double *P_tot){
+
   const int N_2prot=2;
-  TVector3 V3_2p_rotated[N_2prot],V3_1pirot;
-  bool pi1_stat=true;
-  double N_2p_0pi=0,N_all=0,N_1p_1pi[N_2prot]={0},N_1p_0pi[N_2prot]={0};
+  double N_1p_1pi[N_2prot]={0},N_1p_0pi[N_2prot]={0};
   double P_2pto1p[N_2prot]={0},N_2p_det=0;
-  double   N_pidet=0,N_piundet=0,rot_angle;
+  double   N_pidet=0,N_piundet=0;
   *P_tot=0;
 
-
-  for(int g=0; g<N_tot; g++){
-
-    rot_angle=gRandom->Uniform(0,2*TMath::Pi());
-
-    V3_2p_rotated[0]=V3_2prot_uncorr[0];
-    V3_2p_rotated[1]=V3_2prot_uncorr[1];
-    V3_2p_rotated[0].Rotate(rot_angle,V3q);
-    V3_2p_rotated[1].Rotate(rot_angle,V3q);
-
-    V3_1pirot=V3_1pi;
-    V3_1pirot.Rotate(rot_angle,V3q);
-    pi1_stat=Pi_phot_fid_united(fbeam_en, V3_1pirot, q_pi);
-
-
-    if(PFiducialCut(fbeam_en, V3_2p_rotated[0]) && PFiducialCut(fbeam_en, V3_2p_rotated[1]) && !pi1_stat) N_2p_0pi=N_2p_0pi+1;
-    if(PFiducialCut(fbeam_en, V3_2p_rotated[0]) && !PFiducialCut(fbeam_en, V3_2p_rotated[1]) && pi1_stat) N_1p_1pi[0]=N_1p_1pi[0]+1;
-    if(!PFiducialCut(fbeam_en, V3_2p_rotated[0]) && PFiducialCut(fbeam_en, V3_2p_rotated[1]) && pi1_stat) N_1p_1pi[1]=N_1p_1pi[1]+1;
-    if(PFiducialCut(fbeam_en, V3_2p_rotated[0]) && !PFiducialCut(fbeam_en, V3_2p_rotated[1]) && !pi1_stat) N_1p_0pi[0]=N_1p_0pi[0]+1;
-    if(!PFiducialCut(fbeam_en, V3_2p_rotated[0]) && PFiducialCut(fbeam_en, V3_2p_rotated[1]) && !pi1_stat) N_1p_0pi[1]=N_1p_0pi[1]+1;
-    if(PFiducialCut(fbeam_en, V3_2p_rotated[0]) && PFiducialCut(fbeam_en, V3_2p_rotated[1]) && pi1_stat) N_all=N_all+1;
-  }
+  // Bit i is proton i, bit 2 the pion
+  double N_2p_0pi=counts[1|2];
+  N_1p_1pi[0]=counts[1|4];
+  N_1p_1pi[1]=counts[2|4];
+  N_1p_0pi[0]=counts[1];
+  N_1p_0pi[1]=counts[2];
+  double N_all=counts[1|2|4];
 
   //---------------------------------- 2p 1pi ->2p 0pi   ----------------------------------------------
   if(N_all!=0){
 
-    prot2_rot_func(V3_2prot_corr,V3_2prot_uncorr, V4_el,Ecal_2p1pi_to2p0pi,p_miss_perp_2p1pi_to2p0pi,P_2pto1p ,&N_2p_det);
+    const unsigned int index_2p[2]={0,1};
+    double counts_2p[4];
+    ProjectCounts<3,2>(counts,index_2p,counts_2p);
+    prot2_count_func(counts_2p,V3_2prot_corr,V4_el,Ecal_2p1pi_to2p0pi,p_miss_perp_2p1pi_to2p0pi,P_2pto1p,&N_2p_det);
 
     for(int z=0;z<N_2prot;z++){
 
@@ -365,7 +310,10 @@ void Subtraction::prot2_pi1_rot_func(TVector3 V3_2prot_corr[2],TVector3 V3_2prot
 
       //---------------------------------- 2p 1pi ->1p 1pi   ----------------------------------------------
 
-      prot1_pi1_rot_func(V3_2prot_uncorr[z],V3_1pi, q_pi, &N_pidet,&N_piundet);
+      const unsigned int index_1p1pi[2]={(unsigned int)z,2};
+      double counts_1p1pi[4];
+      ProjectCounts<3,2>(counts,index_1p1pi,counts_1p1pi);
+      prot1_pi1_count_func(counts_1p1pi,&N_pidet,&N_piundet);
       if(N_pidet!=0) P_2p1pito1p1pi[z]=(N_1p_1pi[z]/N_all)*(N_piundet/N_pidet);
       else P_2p1pito1p1pi[z]=0;
 
@@ -389,11 +337,18 @@ void Subtraction::prot2_pi1_rot_func(TVector3 V3_2prot_corr[2],TVector3 V3_2prot
 
 void Subtraction::prot2_pi2_rot_func(TVector3 V3_2prot_corr[2],TVector3 V3_2prot_uncorr[2],TVector3 V3_2pi[2], int q_pi[2], TLorentzVector V4_el, double Ecal_2p2pi[2],double p_miss_perp_2p2pi[2],double P_tot_2p[2]){
 
+  const TVector3 V3[4]={V3_2prot_uncorr[0],V3_2prot_uncorr[1],V3_2pi[0],V3_2pi[1]};
+  const bool is_proton[4]={true,true,false,false};
+  const int q[4]={1,1,q_pi[0],q_pi[1]};
+  double counts[16];
+  RotateSubsets<4>(V3,is_proton,q,counts);
+  prot2_pi2_count_func(counts,V3_2prot_corr,V4_el,Ecal_2p2pi,p_miss_perp_2p2pi,P_tot_2p);
+}
+
+void Subtraction::prot2_pi2_count_func(const double counts[16], TVector3 V3_2prot_corr[2], TLorentzVector V4_el, double Ecal_2p2pi[2], double p_miss_perp_2p2pi[2], double P_tot_2p[2]){
+
   const int N_2prot=2,N_2pi=2;
-  TVector3 V3_2p_rotated[N_2prot],V3_2pirot[N_2pi];
-  bool pi2_stat[N_2pi]={true};
-  double   rot_angle;
-  double N_2p_0pi=0,N_2p_1pi[N_2pi]={0},N_1p_2pi[N_2prot]={0},N_all=0,N_1p_1pi[N_2prot][N_2pi]={0},N_1p_0pi[N_2prot]={0};
+  double N_2p_1pi[N_2pi]={0},N_1p_2pi[N_2prot]={0},N_1p_1pi[N_2prot][N_2pi]={0},N_1p_0pi[N_2prot]={0};
   double   N_pidet=0,N_piundet=0;
   double P_2pto1p[N_2prot]={0},N_2p_det=0;
   double P_1p0pi=0,P_1p1pi[N_2pi]={0};
@@ -401,39 +356,27 @@ void Subtraction::prot2_pi2_rot_func(TVector3 V3_2prot_corr[2],TVector3 V3_2prot
   double P_2p2pito1p0pi[N_2prot]={0},P_2p2pito1p1pi[N_2prot]={0},P_2p2pito1p2pi[N_2prot]={0},P_2p2pito2p1pi[N_2prot]={0};
   P_tot_2p[0]=P_tot_2p[1]=0;
 
-  for(int g=0; g<N_tot; g++){
-
-    rot_angle=gRandom->Uniform(0,2*TMath::Pi());
-
-    for(int k=0; k<N_2pi; k++){
-
-      V3_2p_rotated[k]=V3_2prot_uncorr[k];
-      V3_2p_rotated[k].Rotate(rot_angle,V3q);
-
-
-      V3_2pirot[k]=V3_2pi[k];
-      V3_2pirot[k].Rotate(rot_angle,V3q);
-      pi2_stat[k]=Pi_phot_fid_united(fbeam_en, V3_2pirot[k], q_pi[k]);
-    }
-
-    if(PFiducialCut(fbeam_en, V3_2p_rotated[0]) && PFiducialCut(fbeam_en, V3_2p_rotated[1]) && pi2_stat[0]  && !pi2_stat[1])  N_2p_1pi[0]=N_2p_1pi[0]+1;
-    if(PFiducialCut(fbeam_en, V3_2p_rotated[0]) && PFiducialCut(fbeam_en, V3_2p_rotated[1]) && !pi2_stat[0]  && pi2_stat[1])  N_2p_1pi[1]=N_2p_1pi[1]+1;
-    if(PFiducialCut(fbeam_en, V3_2p_rotated[0]) && PFiducialCut(fbeam_en, V3_2p_rotated[1]) && !pi2_stat[0]  && !pi2_stat[1]) N_2p_0pi=N_2p_0pi+1;
-    if(PFiducialCut(fbeam_en, V3_2p_rotated[0]) && !PFiducialCut(fbeam_en, V3_2p_rotated[1]) && pi2_stat[0]  && pi2_stat[1])  N_1p_2pi[0]=N_1p_2pi[0]+1;
-    if(!PFiducialCut(fbeam_en, V3_2p_rotated[0]) && PFiducialCut(fbeam_en, V3_2p_rotated[1]) && pi2_stat[0]  && pi2_stat[1])  N_1p_2pi[1]=N_1p_2pi[1]+1;
-    if(PFiducialCut(fbeam_en, V3_2p_rotated[0]) && !PFiducialCut(fbeam_en, V3_2p_rotated[1]) && pi2_stat[0]  && !pi2_stat[1])  N_1p_1pi[0][0]=N_1p_1pi[0][0]+1;
-    if(PFiducialCut(fbeam_en, V3_2p_rotated[0]) && !PFiducialCut(fbeam_en, V3_2p_rotated[1]) && !pi2_stat[0]  && pi2_stat[1])  N_1p_1pi[0][1]=N_1p_1pi[0][1]+1;
-    if(!PFiducialCut(fbeam_en, V3_2p_rotated[0]) && PFiducialCut(fbeam_en, V3_2p_rotated[1]) && pi2_stat[0]  && !pi2_stat[1])  N_1p_1pi[1][0]=N_1p_1pi[1][0]+1;
-    if(!PFiducialCut(fbeam_en, V3_2p_rotated[0]) && PFiducialCut(fbeam_en, V3_2p_rotated[1]) && !pi2_stat[0]  && pi2_stat[1])  N_1p_1pi[1][1]=N_1p_1pi[1][1]+1;
-    if(PFiducialCut(fbeam_en, V3_2p_rotated[0]) && !PFiducialCut(fbeam_en, V3_2p_rotated[1]) && !pi2_stat[0]  && !pi2_stat[1])  N_1p_0pi[0]=N_1p_0pi[0]+1;
-    if(!PFiducialCut(fbeam_en, V3_2p_rotated[0]) && PFiducialCut(fbeam_en, V3_2p_rotated[1]) && !pi2_stat[0]  && !pi2_stat[1])  N_1p_0pi[1]=N_1p_0pi[1]+1;
-    if(PFiducialCut(fbeam_en, V3_2p_rotated[0]) && PFiducialCut(fbeam_en, V3_2p_rotated[1]) && pi2_stat[0]  && pi2_stat[1])  N_all=N_all+1;
-  }
+  // Bit i is proton i, bit 2+k the pion k
+  N_2p_1pi[0]=counts[1|2|4];
+  N_2p_1pi[1]=counts[1|2|8];
+  double N_2p_0pi=counts[1|2];
+  N_1p_2pi[0]=counts[1|4|8];
+  N_1p_2pi[1]=counts[2|4|8];
+  N_1p_1pi[0][0]=counts[1|4];
+  N_1p_1pi[0][1]=counts[1|8];
+  N_1p_1pi[1][0]=counts[2|4];
+  N_1p_1pi[1][1]=counts[2|8];
+  N_1p_0pi[0]=counts[1];
+  N_1p_0pi[1]=counts[2];
+  double N_all=counts[1|2|4|8];
 
 
   if(N_all!=0){
 
-    prot2_rot_func(V3_2prot_corr,V3_2prot_uncorr, V4_el,Ecal_2p2pi,p_miss_perp_2p2pi,P_2pto1p ,&N_2p_det);
+    const unsigned int index_2p[2]={0,1};
+    double counts_2p[4];
+    ProjectCounts<4,2>(counts,index_2p,counts_2p);
+    prot2_count_func(counts_2p,V3_2prot_corr,V4_el,Ecal_2p2pi,p_miss_perp_2p2pi,P_2pto1p,&N_2p_det);
 
     for(int z=0;z<N_2prot;z++){
       //---------------------------------- 2p 2pi ->1p 0pi   ----------------------------------------------
@@ -444,7 +387,10 @@ void Subtraction::prot2_pi2_rot_func(TVector3 V3_2prot_corr[2],TVector3 V3_2prot
 
       for(int k=0;k<N_2pi;k++){
 	N_pidet=N_piundet=0;
-	prot1_pi1_rot_func(V3_2prot_uncorr[z],V3_2pi[k], q_pi[k],&N_pidet,&N_piundet);
+	const unsigned int index_1p1pi[2]={(unsigned int)z,(unsigned int)(2+k)};
+	double counts_1p1pi[4];
+	ProjectCounts<4,2>(counts,index_1p1pi,counts_1p1pi);
+	prot1_pi1_count_func(counts_1p1pi,&N_pidet,&N_piundet);
 	if(N_pidet!=0) P_2p2pito1p1pi[z]=P_2p2pito1p1pi[z]+(N_1p_1pi[z][k]/N_all)*(N_piundet/N_pidet);
       }
 
@@ -455,18 +401,19 @@ void Subtraction::prot2_pi2_rot_func(TVector3 V3_2prot_corr[2],TVector3 V3_2prot
       //---------------------------------- 2p 2pi ->1p 2pi   ----------------------------------------------
 
       P_1p0pi=P_1p1pi[0]=P_1p1pi[1]=0;
-      prot1_pi2_rot_func(V3_2prot_uncorr[z],V3_2pi,q_pi,&P_1p0pi,P_1p1pi);
+      const unsigned int index_1p2pi[3]={(unsigned int)z,2,3};
+      double counts_1p2pi[8];
+      ProjectCounts<4,3>(counts,index_1p2pi,counts_1p2pi);
+      prot1_pi2_count_func(counts_1p2pi,&P_1p0pi,P_1p1pi);
       P_2p2pito1p2pi[z]=(N_1p_2pi[z]/N_all)*(P_1p0pi-P_1p1pi[0]-P_1p1pi[1]);
 
       //---------------------------------- 2p 2pi ->2p 1pi   ----------------------------------------------
 
       P_2p1pito2p0pi[0]=P_2p1pito2p0pi[1]=0; P_2p1pito1p1pi[0]=P_2p1pito1p1pi[1]=0; P_2p1pito1p0pi[0]=P_2p1pito1p0pi[1]=0;Ptot=0;
-      prot2_pi1_rot_func(V3_2prot_corr,V3_2prot_uncorr,V3_2pi[z], q_pi[z],V4_el,Ecal_2p2pi,p_miss_perp_2p2pi,P_2p1pito2p0pi, P_2p1pito1p1pi, P_2p1pito1p0pi,&Ptot);
-
-      // P_2p2pito2p1pi[z]=(N_2p_1pi[0]/N_all)*(-P_2p1pito2p0pi[z]- P_2p1pito1p1pi[z]+P_2p1pito1p0pi[z])+(N_2p_1pi[1]/N_all)*(-P_2p1pito2p0pi[z]- P_2p1pito1p1pi[z]+P_2p1pito1p0pi[z]);
-      //P_tot_2p[z]=-P_2p2pito1p0pi[z]+P_2p2pito1p1pi[z]+P_2p1pito2p0pi[z]+P_2p2pito1p2pi[z]+P_2p2pito2p1pi[z];
-
-      //P_2p2pito2p1pi[z]=(N_2p_1pi[z]/N_all)*(-P_2p1pito2p0pi[0]- P_2p1pito1p1pi[0]+P_2p1pito1p0pi[0])+(N_2p_1pi[z]/N_all)*(-P_2p1pito2p0pi[1]- P_2p1pito1p1pi[1]+P_2p1pito1p0pi[1]);
+      const unsigned int index_2p1pi[3]={0,1,(unsigned int)(2+z)};
+      double counts_2p1pi[8];
+      ProjectCounts<4,3>(counts,index_2p1pi,counts_2p1pi);
+      prot2_pi1_count_func(counts_2p1pi,V3_2prot_corr,V4_el,Ecal_2p2pi,p_miss_perp_2p2pi,P_2p1pito2p0pi, P_2p1pito1p1pi, P_2p1pito1p0pi,&Ptot);
 
       P_2p2pito2p1pi[0]= P_2p2pito2p1pi[0]+(N_2p_1pi[z]/N_all)*(-P_2p1pito2p0pi[0]- P_2p1pito1p1pi[0]+P_2p1pito1p0pi[0]);
       P_2p2pito2p1pi[1]= P_2p2pito2p1pi[1]+(N_2p_1pi[z]/N_all)*(-P_2p1pito2p0pi[1]- P_2p1pito1p1pi[1]+P_2p1pito1p0pi[1]);
@@ -487,15 +434,22 @@ void Subtraction::prot2_pi2_rot_func(TVector3 V3_2prot_corr[2],TVector3 V3_2prot
 
 void Subtraction::prot3_pi1_rot_func(TVector3 V3_3prot_corr[3],TVector3 V3_3prot_uncorr[3],TVector3 V3_pi, int q_pi, TLorentzVector V4_el, double Ecal_3p1pi[3],double p_miss_perp_3p1pi[3],double P_tot_3p[3]){
 
+  const TVector3 V3[4]={V3_3prot_uncorr[0],V3_3prot_uncorr[1],V3_3prot_uncorr[2],V3_pi};
+  const bool is_proton[4]={true,true,true,false};
+  const int q[4]={1,1,1,q_pi};
+  double counts[16];
+  RotateSubsets<4>(V3,is_proton,q,counts);
+  prot3_pi1_count_func(counts,V3_3prot_corr,V3_3prot_uncorr,V4_el,Ecal_3p1pi,p_miss_perp_3p1pi,P_tot_3p);
+}
+
+void Subtraction::prot3_pi1_count_func(const double counts[16], TVector3 V3_3prot_corr[3], TVector3 V3_3prot_uncorr[3], TLorentzVector V4_el, double Ecal_3p1pi[3], double p_miss_perp_3p1pi[3], double P_tot_3p[3]){
+
   const int N_3prot=3;
-  TVector3 V3_3p_rotated[N_3prot],V3_pirot;
-  bool pi_stat=true;
-  double   rot_angle;
 
-  double N_1p0pi[N_3prot]={0},N_all=0,N_1p1pi[N_3prot]={0},N_2p0pi[N_3prot]={0},N_2p1pi[N_3prot]={0},N_3p0pi=0;
+  double N_1p0pi[N_3prot]={0},N_1p1pi[N_3prot]={0},N_2p0pi[N_3prot]={0},N_2p1pi[N_3prot]={0};
   double  P_3p1pito1p0pi[N_3prot]={0},P_3p1pito1p1pi[N_3prot]={0};
   double   N_pidet=0,N_piundet=0;
-  TVector3 V3_2p_corr[N_3prot],V3_2p_uncorr[N_3prot];
+  TVector3 V3_2p_corr[N_3prot];
   double Ecal_2p[2],p_miss_perp_2p[2],P_2pto1p[2]={0},N_2p_det=0,P_3p1pito2p0pi[N_3prot]={0};
   int count=0;
   double N_p1[N_3prot]={0},N_p_three=0;
@@ -503,41 +457,28 @@ void Subtraction::prot3_pi1_rot_func(TVector3 V3_3prot_corr[3],TVector3 V3_3prot
   double Ecal_2p1pi[2],p_miss_perp_2p1pi[2],P_3p1pito2p1pi[N_3prot]={0};
   double P_2p1pito2p0pi[2]={0},P_2p1pito1p1pi[2]={0},P_2p1pito1p0pi[2]={0},Ptot=0;
 
-  for(int g=0; g<N_tot; g++){
-
-    rot_angle=gRandom->Uniform(0,2*TMath::Pi());
-    for(int k=0; k<N_3prot; k++){
-
-      V3_3p_rotated[k]=V3_3prot_uncorr[k];
-      V3_3p_rotated[k].Rotate(rot_angle,V3q);
-    }
-
-    V3_pirot=V3_pi;
-    V3_pirot.Rotate(rot_angle,V3q);
-    pi_stat=Pi_phot_fid_united(fbeam_en, V3_pirot, q_pi);
-
-
-    if(PFiducialCut(fbeam_en, V3_3p_rotated[0]) && !PFiducialCut(fbeam_en, V3_3p_rotated[1]) && !PFiducialCut(fbeam_en, V3_3p_rotated[2])  && !pi_stat)  N_1p0pi[0]=N_1p0pi[0]+1;
-    if(!PFiducialCut(fbeam_en, V3_3p_rotated[0]) && PFiducialCut(fbeam_en, V3_3p_rotated[1]) && !PFiducialCut(fbeam_en, V3_3p_rotated[2])  && !pi_stat)  N_1p0pi[1]=N_1p0pi[1]+1;
-    if(!PFiducialCut(fbeam_en, V3_3p_rotated[0]) && !PFiducialCut(fbeam_en, V3_3p_rotated[1]) && PFiducialCut(fbeam_en, V3_3p_rotated[2])  && !pi_stat)  N_1p0pi[2]=N_1p0pi[2]+1;
-    if(PFiducialCut(fbeam_en, V3_3p_rotated[0]) && !PFiducialCut(fbeam_en, V3_3p_rotated[1]) && !PFiducialCut(fbeam_en, V3_3p_rotated[2])  && pi_stat)  N_1p1pi[0]=N_1p1pi[0]+1;
-    if(!PFiducialCut(fbeam_en, V3_3p_rotated[0]) && PFiducialCut(fbeam_en, V3_3p_rotated[1]) && !PFiducialCut(fbeam_en, V3_3p_rotated[2])  && pi_stat)  N_1p1pi[1]=N_1p1pi[1]+1;
-    if(!PFiducialCut(fbeam_en, V3_3p_rotated[0]) && !PFiducialCut(fbeam_en, V3_3p_rotated[1]) && PFiducialCut(fbeam_en, V3_3p_rotated[2])  && pi_stat)  N_1p1pi[2]=N_1p1pi[2]+1;
-    if(PFiducialCut(fbeam_en, V3_3p_rotated[0]) && PFiducialCut(fbeam_en, V3_3p_rotated[1]) && !PFiducialCut(fbeam_en, V3_3p_rotated[2])  && !pi_stat)  N_2p0pi[0]=N_2p0pi[0]+1;
-    if(PFiducialCut(fbeam_en, V3_3p_rotated[0]) && !PFiducialCut(fbeam_en, V3_3p_rotated[1]) && PFiducialCut(fbeam_en, V3_3p_rotated[2])  && !pi_stat)  N_2p0pi[1]=N_2p0pi[1]+1;
-    if(!PFiducialCut(fbeam_en, V3_3p_rotated[0]) && PFiducialCut(fbeam_en, V3_3p_rotated[1]) && PFiducialCut(fbeam_en, V3_3p_rotated[2])  && !pi_stat)  N_2p0pi[2]=N_2p0pi[2]+1;
-    if(PFiducialCut(fbeam_en, V3_3p_rotated[0]) && PFiducialCut(fbeam_en, V3_3p_rotated[1]) && !PFiducialCut(fbeam_en, V3_3p_rotated[2])  && pi_stat)  N_2p1pi[0]=N_2p1pi[0]+1;
-    if(PFiducialCut(fbeam_en, V3_3p_rotated[0]) && !PFiducialCut(fbeam_en, V3_3p_rotated[1]) && PFiducialCut(fbeam_en, V3_3p_rotated[2])  && pi_stat)  N_2p1pi[1]=N_2p1pi[1]+1;
-    if(!PFiducialCut(fbeam_en, V3_3p_rotated[0]) && PFiducialCut(fbeam_en, V3_3p_rotated[1]) && PFiducialCut(fbeam_en, V3_3p_rotated[2])  && pi_stat)  N_2p1pi[2]=N_2p1pi[2]+1;
-    if(PFiducialCut(fbeam_en, V3_3p_rotated[0]) && PFiducialCut(fbeam_en, V3_3p_rotated[1]) && PFiducialCut(fbeam_en, V3_3p_rotated[2])  && !pi_stat)  N_3p0pi=N_3p0pi+1;
-    if(PFiducialCut(fbeam_en, V3_3p_rotated[0]) && PFiducialCut(fbeam_en, V3_3p_rotated[1]) && PFiducialCut(fbeam_en, V3_3p_rotated[2])  && pi_stat)  N_all=N_all+1;
+  // Bit i is proton i, bit 3 the pion
+  for(int j=0;j<N_3prot;j++) {
+    N_1p0pi[j]=counts[1<<j];
+    N_1p1pi[j]=counts[(1<<j)|8];
   }
+  N_2p0pi[0]=counts[1|2];
+  N_2p0pi[1]=counts[1|4];
+  N_2p0pi[2]=counts[2|4];
+  N_2p1pi[0]=counts[1|2|8];
+  N_2p1pi[1]=counts[1|4|8];
+  N_2p1pi[2]=counts[2|4|8];
+  double N_3p0pi=counts[1|2|4];
+  double N_all=counts[1|2|4|8];
 
 
   if(N_all!=0){
 
     //----------------------------------3p 1pi ->3p 0pi->1p0pi   ----------------------------------------------
-    prot3_rot_func(V3_3prot_uncorr,V3_3prot_corr,V4_el,E_cal_3pto2p,p_miss_perp_3pto2p, P_3pto2p,N_p1, Ecal_3p1pi,p_miss_perp_3p1pi,&N_p_three);
+    const unsigned int index_3p[3]={0,1,2};
+    double counts_3p[8];
+    ProjectCounts<4,3>(counts,index_3p,counts_3p);
+    prot3_count_func(counts_3p,V3_3prot_uncorr,V4_el,E_cal_3pto2p,p_miss_perp_3pto2p, P_3pto2p,N_p1, Ecal_3p1pi,p_miss_perp_3p1pi,&N_p_three);
 
     if(N_p_three!=0){
       P_3p1pito3p0pi[0]= (N_3p0pi/N_all)*(N_p1[0]/N_p_three);
@@ -554,7 +495,10 @@ void Subtraction::prot3_pi1_rot_func(TVector3 V3_3prot_corr[3],TVector3 V3_3prot
       //---------------------------------- 3p 1pi ->1p 1pi   ----------------------------------------------
 
       N_pidet=N_piundet=0;
-      prot1_pi1_rot_func(V3_3prot_uncorr[z],V3_pi, q_pi, &N_pidet,&N_piundet);
+      const unsigned int index_1p1pi[2]={(unsigned int)z,3};
+      double counts_1p1pi[4];
+      ProjectCounts<4,2>(counts,index_1p1pi,counts_1p1pi);
+      prot1_pi1_count_func(counts_1p1pi,&N_pidet,&N_piundet);
       if(N_pidet!=0) P_3p1pito1p1pi[z]=(N_1p1pi[z]/N_all)*(N_piundet/N_pidet);
 
       //---------------------------------- 3p 1pi ->2p 0pi   ----------------------------------------------
@@ -563,10 +507,12 @@ void Subtraction::prot3_pi1_rot_func(TVector3 V3_3prot_corr[3],TVector3 V3_3prot
 	if(z!=i && z<i){               // 3 pairs of 2proton combinations with z, i indexes(z<i)
 
 	  V3_2p_corr[0]=V3_3prot_corr[z];V3_2p_corr[1]=V3_3prot_corr[i];
-	  V3_2p_uncorr[0]=V3_3prot_uncorr[z];V3_2p_uncorr[1]=V3_3prot_uncorr[i];
 
 	  P_2pto1p[0]=0;P_2pto1p[1]=0;N_2p_det=0;
-	  prot2_rot_func(V3_2p_corr,V3_2p_uncorr, V4_el,Ecal_2p,p_miss_perp_2p,P_2pto1p ,&N_2p_det);
+	  const unsigned int index_2p[2]={(unsigned int)z,(unsigned int)i};
+	  double counts_2p[4];
+	  ProjectCounts<4,2>(counts,index_2p,counts_2p);
+	  prot2_count_func(counts_2p,V3_2p_corr,V4_el,Ecal_2p,p_miss_perp_2p,P_2pto1p,&N_2p_det);
 	  if(N_2p_det!=0){
 	    P_3p1pito2p0pi[z]=P_3p1pito2p0pi[z]+(N_2p0pi[count]/N_all)*P_2pto1p[0];
 	    P_3p1pito2p0pi[i]=P_3p1pito2p0pi[i]+(N_2p0pi[count]/N_all)*P_2pto1p[1];
@@ -583,10 +529,10 @@ void Subtraction::prot3_pi1_rot_func(TVector3 V3_3prot_corr[3],TVector3 V3_3prot
 	  //---------------------------------- 3p 1pi ->2p 1pi   ----------------------------------------------
           P_2p1pito2p0pi[0]=P_2p1pito2p0pi[1]=0; P_2p1pito1p1pi[0]=P_2p1pito1p1pi[1]=0; P_2p1pito1p0pi[0]=P_2p1pito1p0pi[1]=0;Ptot=0;
 
-          prot2_pi1_rot_func(V3_2p_corr,V3_2p_uncorr,V3_pi, q_pi,V4_el,Ecal_2p1pi,p_miss_perp_2p1pi,P_2p1pito2p0pi, P_2p1pito1p1pi, P_2p1pito1p0pi,&Ptot);
-
-	  // P_3p1pito2p1pi[z]=(N_2p1pi[count]/N_all)*(-P_2p1pito2p0pi[z]- P_2p1pito1p1pi[z]+P_2p1pito1p0pi[z]);
-	  // P_3p1pito2p1pi[i]=(N_2p1pi[count]/N_all)*(-P_2p1pito2p0pi[i]- P_2p1pito1p1pi[i]+P_2p1pito1p0pi[i]);
+	  const unsigned int index_2p1pi[3]={(unsigned int)z,(unsigned int)i,3};
+	  double counts_2p1pi[8];
+	  ProjectCounts<4,3>(counts,index_2p1pi,counts_2p1pi);
+          prot2_pi1_count_func(counts_2p1pi,V3_2p_corr,V4_el,Ecal_2p1pi,p_miss_perp_2p1pi,P_2p1pito2p0pi, P_2p1pito1p1pi, P_2p1pito1p0pi,&Ptot);
 
           P_3p1pito2p1pi[z]= P_3p1pito2p1pi[z]+(N_2p1pi[count]/N_all)*(-P_2p1pito2p0pi[0]- P_2p1pito1p1pi[0]+P_2p1pito1p0pi[0]);
           P_3p1pito2p1pi[i]= P_3p1pito2p1pi[i]+(N_2p1pi[count]/N_all)*(-P_2p1pito2p0pi[1]- P_2p1pito1p1pi[1]+P_2p1pito1p0pi[1]);
@@ -595,8 +541,6 @@ void Subtraction::prot3_pi1_rot_func(TVector3 V3_3prot_corr[3],TVector3 V3_3prot
 	}
       }
 
-      // P_tot_3p[z]=P_3p1pito2p1pi[z]+P_3p1pito3p0pi[z]+P_3p1pito2p0pi[z]+P_3p1pito1p1pi[z]+ P_3p1pito1p0pi[z];
-
     }//looping through 3p
 
     P_tot_3p[0]=P_3p1pito2p1pi[0]+P_3p1pito3p0pi[0]+P_3p1pito2p0pi[0]+P_3p1pito1p1pi[0]+ P_3p1pito1p0pi[0];
@@ -614,55 +558,49 @@ void Subtraction::prot3_pi1_rot_func(TVector3 V3_3prot_corr[3],TVector3 V3_3prot
 
 void Subtraction::pi1_rot_func(TVector3 V3_pi, int q_pi, double *P_pi){
 
+  const bool is_proton[1]={false};
+  const int q[1]={q_pi};
+  double counts[2];
+  RotateSubsets<1>(&V3_pi,is_proton,q,counts);
+  pi1_count_func(counts,P_pi);
+}
 
-  double N_pion=0;
-  double rot_angle;
-  TVector3 V3_rot_pi;
-
-  for(int g=0; g<N_tot; g++){
+void Subtraction::pi1_count_func(const double counts[2], double *P_pi){
 
-    V3_rot_pi=V3_pi;
-    rot_angle=gRandom->Uniform(0,2*TMath::Pi());
-    V3_rot_pi.Rotate(rot_angle,V3q);
-    if(Pi_phot_fid_united(fbeam_en, V3_rot_pi,q_pi)) N_pion=N_pion+1;
-  }
+  double N_pion=counts[1];
+  double N_rot=counts[0]+counts[1];
 
-  if(N_pion!=0)     *P_pi=(N_tot-N_pion)/N_pion;
+  if(N_pion!=0)     *P_pi=(N_rot-N_pion)/N_pion;
   else *P_pi=0;
-
-  // if(!radstat) cout<<"nereqev     "<<N_pion<<"   radstat"<<"     "<<radstat<<endl;
 }
 
 
 void Subtraction::pi2_rot_func(TVector3 V3_pi[2], int q_pi[2], double *P_0pi,double P_1pi[2]){
 
-  const int N_pi=2;
-  TVector3 V3_rot_pi[N_pi];
-  double rot_angle;
-  bool status_pi[N_pi]={true};
-  double N_bothpi=0,N_nopi=0,N_1pi[N_pi]={0},P_pi1[N_pi]={0};
-
-
-  for(int g=0; g<N_tot; g++){
-
-    rot_angle=gRandom->Uniform(0,2*TMath::Pi());
-    for(int i=0;i<N_pi;i++){
+  const bool is_proton[2]={false,false};
+  double counts[4];
+  RotateSubsets<2>(V3_pi,is_proton,q_pi,counts);
+  pi2_count_func(counts,P_0pi,P_1pi);
+}
 
-      V3_rot_pi[i]=V3_pi[i];
-      V3_rot_pi[i].Rotate(rot_angle,V3q);
-      status_pi[i]=Pi_phot_fid_united(fbeam_en, V3_rot_pi[i],q_pi[i]);
+void Subtraction::pi2_count_func(const double counts[4], double *P_0pi, double P_1pi[2]){
 
-    }
-    if( status_pi[0] && !status_pi[1]) N_1pi[0]=N_1pi[0]+1;
-    if(!status_pi[0] &&  status_pi[1]) N_1pi[1]=N_1pi[1]+1;
-    if(!status_pi[0] && !status_pi[1]) N_nopi=N_nopi+1;
-    if( status_pi[0] &&  status_pi[1]) N_bothpi=N_bothpi+1;
+  const int N_pi=2;
+  double N_1pi[N_pi]={0},P_pi1[N_pi]={0};
+
+  // Bit i is pion i
+  N_1pi[0]=counts[1];
+  N_1pi[1]=counts[2];
+  double N_nopi=counts[0];
+  double N_bothpi=counts[1|2];
+
+  for(int i=0;i<N_pi;i++){
+    const unsigned int index[1]={(unsigned int)i};
+    double counts_1pi[2];
+    ProjectCounts<2,1>(counts,index,counts_1pi);
+    pi1_count_func(counts_1pi,P_pi1+i);
   }
 
-
-  pi1_rot_func(V3_pi[0],  q_pi[0], P_pi1);
-  pi1_rot_func(V3_pi[1],  q_pi[1], P_pi1+1);
-
   if(N_bothpi!=0){
     *P_0pi=N_nopi/N_bothpi;
     P_1pi[0]=N_1pi[0]/N_bothpi*P_pi1[0];
@@ -677,66 +615,47 @@ void Subtraction::pi2_rot_func(TVector3 V3_pi[2], int q_pi[2], double *P_0pi,dou
 
 void Subtraction::pi3_rot_func(TVector3 V3_pi[3], int q_pi[3], double *P_0pi, double P_1pi[3],double P_320[3],double P_3210[][2]){
 
-  const int N_pi=3;
-  TVector3 V3_rot_pi[N_pi];
-  double rot_angle;
-  bool status_pi[N_pi]={true};
-  double N_1pi[N_pi]={0},N_allpi=0,N_nopi=0,N_2pi[N_pi]={0};
-
-
-
-  for(int g=0; g<N_tot; g++){
-
-    rot_angle=gRandom->Uniform(0,2*TMath::Pi());
-
-    for(int i=0;i<N_pi;i++){
+  const bool is_proton[3]={false,false,false};
+  double counts[8];
+  RotateSubsets<3>(V3_pi,is_proton,q_pi,counts);
+  pi3_count_func(counts,P_0pi,P_1pi,P_320,P_3210);
+}
 
+void Subtraction::pi3_count_func(const double counts[8], double *P_0pi, double P_1pi[3], double P_320[3], double P_3210[][2]){
 
-      V3_rot_pi[i]=V3_pi[i];
-      V3_rot_pi[i].Rotate(rot_angle,V3q);
-      status_pi[i]=Pi_phot_fid_united(fbeam_en, V3_rot_pi[i],q_pi[i]);
+  const int N_pi=3;
+  double N_1pi[N_pi]={0},N_2pi[N_pi]={0};
 
-    }
+  // Bit i is pion i
+  for(int j=0;j<N_pi;j++) N_1pi[j]=counts[1<<j];
+  N_2pi[0]=counts[1|2];
+  N_2pi[1]=counts[1|4];
+  N_2pi[2]=counts[2|4];
+  double N_nopi=counts[0];
+  double N_allpi=counts[1|2|4];
 
-    if( status_pi[0]  && !status_pi[1] &&  !status_pi[2]) N_1pi[0]=N_1pi[0]+1;
-    if(!status_pi[0] &&   status_pi[1]  && !status_pi[2]) N_1pi[1]=N_1pi[1]+1;
-    if(!status_pi[0] &&  !status_pi[1] &&   status_pi[2]) N_1pi[2]=N_1pi[2]+1;
-    if( status_pi[0]  &&  status_pi[1] &&  !status_pi[2]) N_2pi[0]=N_2pi[0]+1;
-    if( status_pi[0] &&  !status_pi[1]  &&  status_pi[2]) N_2pi[1]=N_2pi[1]+1;
-    if(!status_pi[0] &&   status_pi[1] &&   status_pi[2]) N_2pi[2]=N_2pi[2]+1;
-    if(!status_pi[0] &&  !status_pi[1] &&  !status_pi[2]) N_nopi=N_nopi+1;
-    if( status_pi[0]  &&  status_pi[1]  &&  status_pi[2]) N_allpi=N_allpi+1;
-  }
+  // Pion pairs, in the same order as N_2pi
+  const unsigned int pairs[3][2]={{0,1},{0,2},{1,2}};
 
   const int N_pi2=2;
   double P_pi=0;
   double P_1pion[N_pi2]={0},P_0pion=0;
-  TVector3 V3_pion[N_pi2];
-  int q_pion[N_pi2];
 
   if(N_allpi!=0){
     //---------------------------3pi->0pi----------------------------------------------
     *P_0pi=N_nopi/N_allpi;
     //---------------------------3pi->1pi->0pi----------------------------------------------
     for(int h=0;h<N_pi;h++){
-      pi1_rot_func( V3_pi[h],q_pi[h],&P_pi);
+      const unsigned int index_1pi[1]={(unsigned int)h};
+      double counts_1pi[2];
+      ProjectCounts<3,1>(counts,index_1pi,counts_1pi);
+      pi1_count_func(counts_1pi,&P_pi);
       P_1pi[h]=P_pi*(N_1pi[h]/N_allpi);
       //---------------------------3pi->2pi->0pi----------------------------------------------
 
-      if(h==0)   {
-	V3_pion[0]=V3_pi[0];V3_pion[1]=V3_pi[1];
-	q_pion[0]=q_pi[0];q_pion[1]=q_pi[1];
-
-      }
-      if(h==1)   {
-	V3_pion[0]=V3_pi[0];V3_pion[1]=V3_pi[2];
-	q_pion[0]=q_pi[0];q_pion[1]=q_pi[2];
-      }
-      if(h==2)   {
-	V3_pion[0]=V3_pi[1];V3_pion[1]=V3_pi[2];
-	q_pion[0]=q_pi[1];q_pion[1]=q_pi[2];
-      }
-      pi2_rot_func( V3_pion,q_pion,&P_0pion, P_1pion);
+      double counts_2pi[4];
+      ProjectCounts<3,2>(counts,pairs[h],counts_2pi);
+      pi2_count_func(counts_2pi,&P_0pion, P_1pion);
       P_320[h]=P_0pion*(N_2pi[h]/N_allpi);
 
       //---------------------------3pi->2pi->1pi->0pi----------------------------------------------
@@ -764,81 +683,47 @@ void Subtraction::pi3_rot_func(TVector3 V3_pi[3], int q_pi[3], double *P_0pi, do
 
 void Subtraction::pi4_rot_func(TVector3 V3_pi[4], int q_pi[4], double *P_0pi,double *P_410,double *P_420,double *P_4210,double *P_430,double *P_4310,double *P_4320,double *P_43210){
 
-  const int N_pi=4;
-  TVector3 V3_rot_pi[N_pi];
-  double rot_angle;
-  bool status_pi[N_pi]={true};
-  double N_1pi[N_pi]={0},N_allpi=0,N_nopi=0,N_2pi[6]={0},N_3pi[4]={0};
-
-
-
-  for(int g=0; g<N_tot; g++){
-
-    rot_angle=gRandom->Uniform(0,2*TMath::Pi());
+  const bool is_proton[4]={false,false,false,false};
+  double counts[16];
+  RotateSubsets<4>(V3_pi,is_proton,q_pi,counts);
+  pi4_count_func(counts,P_0pi,P_410,P_420,P_4210,P_430,P_4310,P_4320,P_43210);
+}
 
-    for(int i=0;i<N_pi;i++){
+void Subtraction::pi4_count_func(const double counts[16], double *P_0pi, double *P_410, double *P_420, double *P_4210, double *P_430, double *P_4310, double *P_4320, double *P_43210){
 
-      V3_rot_pi[i]=V3_pi[i];
-      V3_rot_pi[i].Rotate(rot_angle,V3q);
-      status_pi[i]=Pi_phot_fid_united(fbeam_en, V3_rot_pi[i],q_pi[i]);
+  const int N_pi=4;
+  double N_1pi[N_pi]={0},N_2pi[6]={0},N_3pi[4]={0};
 
-    }
+  // Pion pairs and triplets (bit i is pion i)
+  const unsigned int pairs[6][2]={{0,1},{0,2},{0,3},{1,2},{1,3},{2,3}};
+  const unsigned int triplets[4][3]={{0,1,2},{0,1,3},{0,2,3},{1,2,3}};
 
-    if( status_pi[0]  && !status_pi[1] &&  !status_pi[2]  &&  !status_pi[3]) N_1pi[0]=N_1pi[0]+1; //1pi or phot
-    if( !status_pi[0]  && status_pi[1] &&  !status_pi[2]  &&  !status_pi[3]) N_1pi[1]=N_1pi[1]+1;
-    if( !status_pi[0]  && !status_pi[1] &&  status_pi[2]  &&  !status_pi[3]) N_1pi[2]=N_1pi[2]+1;
-    if( !status_pi[0]  && !status_pi[1] &&  !status_pi[2]  &&  status_pi[3]) N_1pi[3]=N_1pi[3]+1;
-
-    if( status_pi[0]  && status_pi[1] &&  !status_pi[2]  &&  !status_pi[3]) N_2pi[0]=N_2pi[0]+1;//2pi or phot
-    if( status_pi[0]  &&! status_pi[1] &&  status_pi[2]  &&  !status_pi[3]) N_2pi[1]=N_2pi[1]+1;
-    if( status_pi[0]  &&! status_pi[1] &&  !status_pi[2]  &&  status_pi[3]) N_2pi[2]=N_2pi[2]+1;
-    if( !status_pi[0]  && status_pi[1] &&  status_pi[2]  &&  !status_pi[3]) N_2pi[3]=N_2pi[3]+1;
-    if( !status_pi[0]  && status_pi[1] &&  !status_pi[2]  &&  status_pi[3]) N_2pi[4]=N_2pi[4]+1;
-    if( !status_pi[0]  && !status_pi[1] &&  status_pi[2]  &&  status_pi[3]) N_2pi[5]=N_2pi[5]+1;
-
-    if( status_pi[0]  && status_pi[1] &&  status_pi[2]  &&  !status_pi[3]) N_3pi[0]=N_3pi[0]+1;//3pi or phot
-    if( status_pi[0]  && status_pi[1] &&  !status_pi[2]  &&  status_pi[3]) N_3pi[1]=N_3pi[1]+1;
-    if( status_pi[0]  && !status_pi[1] &&  status_pi[2]  &&  status_pi[3]) N_3pi[2]=N_3pi[2]+1;
-    if( !status_pi[0]  && status_pi[1] &&  status_pi[2]  &&  status_pi[3]) N_3pi[3]=N_3pi[3]+1;
-
-    if( !status_pi[0]  && !status_pi[1] &&  !status_pi[2]  &&  !status_pi[3]) N_nopi=N_nopi+1; //0 pi or phot
-    if( status_pi[0]  && status_pi[1] &&  status_pi[2]  && status_pi[3]) N_allpi=N_allpi+1; //4pi or phot
-  }
+  for(int j=0;j<N_pi;j++) N_1pi[j]=counts[1<<j]; //1pi or phot
+  for(int j=0;j<6;j++) N_2pi[j]=counts[(1<<pairs[j][0])|(1<<pairs[j][1])]; //2pi or phot
+  for(int j=0;j<4;j++) N_3pi[j]=counts[(1<<triplets[j][0])|(1<<triplets[j][1])|(1<<triplets[j][2])]; //3pi or phot
+  double N_nopi=counts[0]; //0 pi or phot
+  double N_allpi=counts[1|2|4|8]; //4pi or phot
 
 
   double P_pi=0;
   const int N_pi3=3;
-  TVector3 V3_pion[N_pi3];
   double P_1pion[N_pi3]={0},P_0pion=0, P_320_pion[3]={0}, P_3210_pion[3][2]={0};
-  int q_pion[N_pi3];
 
   if(N_allpi!=0){
     //---------------------------4pi->0pi----------------------------------------------
     *P_0pi=N_nopi/N_allpi;
     //---------------------------4pi->1pi->0pi----------------------------------------------
     for(int h=0;h<N_pi;h++){
-      pi1_rot_func(V3_pi[h],q_pi[h],&P_pi);
+      const unsigned int index_1pi[1]={(unsigned int)h};
+      double counts_1pi[2];
+      ProjectCounts<4,1>(counts,index_1pi,counts_1pi);
+      pi1_count_func(counts_1pi,&P_pi);
       *P_410=*P_410+P_pi*(N_1pi[h]/N_allpi);
 
       //---------------------------4pi->3pi->0pi----------------------------------------------
-      if(h==0)   {
-	V3_pion[0]=V3_pi[0];V3_pion[1]=V3_pi[1];V3_pion[2]=V3_pi[2];
-	q_pion[0]=q_pi[0];q_pion[1]=q_pi[1];q_pion[2]=q_pi[2];
-      }
-      if(h==1)   {
-	V3_pion[0]=V3_pi[0];V3_pion[1]=V3_pi[1];V3_pion[2]=V3_pi[3];
-	q_pion[0]=q_pi[0];q_pion[1]=q_pi[1];q_pion[2]=q_pi[3];
-      }
-      if(h==2)   {
-	V3_pion[0]=V3_pi[0];V3_pion[1]=V3_pi[2];V3_pion[2]=V3_pi[3];
-	q_pion[0]=q_pi[0];q_pion[1]=q_pi[2];q_pion[2]=q_pi[3];
-      }
-      if(h==3)   {
-	V3_pion[0]=V3_pi[1];V3_pion[1]=V3_pi[2];V3_pion[2]=V3_pi[3];
-	q_pion[0]=q_pi[1];q_pion[1]=q_pi[2];q_pion[2]=q_pi[3];
-      }
-
-      pi3_rot_func(V3_pion,q_pion,&P_0pion, P_1pion,P_320_pion,P_3210_pion);
+      double counts_3pi[8];
+      ProjectCounts<4,3>(counts,triplets[h],counts_3pi);
+      pi3_count_func(counts_3pi,&P_0pion, P_1pion,P_320_pion,P_3210_pion);
       *P_430=*P_430+P_0pion*(N_3pi[h]/N_allpi);
 
       //---------------------------4pi->3pi->1pi->0pi----------------------------------------------
@@ -859,39 +744,13 @@ void Subtraction::pi4_rot_func(TVector3 V3_pi[4], int q_pi[4], double *P_0pi,dou
 
     //---------------------------4pi->2pi->0pi----------------------------------------------
     const int N2pi=2;
-    TVector3 V3_2pi[N2pi];
-    int q_2pi[N2pi];
     double P_0pi_d, P_1pi[N2pi]={0};
 
     for(int h=0;h<6;h++){
 
-      if(h==0)   {
-	V3_2pi[0]=V3_pi[0];      V3_2pi[1]=V3_pi[1];
-	q_2pi[0]=q_pi[0];        q_2pi[1]=q_pi[1];
-
-      }
-      if(h==1)   {
-	V3_2pi[0]=V3_pi[0];      V3_2pi[1]=V3_pi[2];
-	q_2pi[0]=q_pi[0];        q_2pi[1]=q_pi[2];
-      }
-      if(h==2)   {
-	V3_2pi[0]=V3_pi[0];      V3_2pi[1]=V3_pi[3];
-	q_2pi[0]=q_pi[0];        q_2pi[1]=q_pi[3];
-      }
-      if(h==3)   {
-	V3_2pi[0]=V3_pi[1];      V3_2pi[1]=V3_pi[2];
-	q_2pi[0]=q_pi[1];        q_2pi[1]=q_pi[2];
-      }
-      if(h==4)   {
-	V3_2pi[0]=V3_pi[1];      V3_2pi[1]=V3_pi[3];
-	q_2pi[0]=q_pi[1];        q_2pi[1]=q_pi[3];
-      }
-      if(h==5)   {
-	V3_2pi[0]=V3_pi[2];      V3_2pi[1]=V3_pi[3];
-	q_2pi[0]=q_pi[2];        q_2pi[1]=q_pi[3];
-      }
-
-      pi2_rot_func( V3_2pi,q_2pi,&P_0pi_d, P_1pi);
+      double counts_2pi[4];
+      ProjectCounts<4,2>(counts,pairs[h],counts_2pi);
+      pi2_count_func(counts_2pi,&P_0pi_d, P_1pi);
 
       *P_420=*P_420+P_0pi_d*(N_2pi[h]/N_allpi);
 
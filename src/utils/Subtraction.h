@@ -7,20 +7,26 @@
 #include <TGraph.h>
 #include <TCanvas.h>
 #include <TLorentzVector.h>
+#include <TMath.h>
 
 #include <iostream>
+#include <cmath>
 #include <fstream>
 #include <iomanip>
 #include <vector>
 #include <map>
+#include <memory>
 #include "utils/Fiducial.h"
 #include "utils/TargetUtils.h"
+#include "utils/CounterRNG.h"
+#include "utils/RotationKernel.h"
+#include "conf/ParticleI.h"
 
 namespace e4nu{ 
   struct Subtraction {
     //initialize Beam Energy String, Target Name String, Map of binding energies and Fiducial cuts
     //N_tot of rotations, q vector is set to (0,0,0)
-    void InitSubtraction(double EBeam, unsigned int target_pdg, int in_nrot, Fiducial * in_fiducial ) {
+    void InitSubtraction(double EBeam, unsigned int target_pdg, int in_nrot, const Fiducial * in_fiducial ) {
       fbeam_en = EBeam;
       ftarget_pdg = target_pdg ;
       bind_en = e4nu::utils::GetBindingEnergy(ftarget_pdg) ; 
@@ -57,16 +63,128 @@ namespace e4nu{
 
     void  pi4_rot_func(TVector3 V3_pi[4], int q_pi[4], double *P_0pi,double *P_410,double *P_420,double *P_4210,double *P_430,double *P_4310,double *P_4320,double *P_43210);
 
+    // Same probabilities, from the rotation counts of each combination of detected particles (see RotateSubsets)
+    // The particle order (bit i of the count index) is the order of the corresponding *_rot_func arguments, protons first
+    // The sub-topology probabilities are computed from the same counts, so each particle is rotated and checked once per angle
+    void  prot2_count_func(const double counts[4], TVector3 V3prot[2], TLorentzVector V4el, double Ecal_2pto1p[2], double pmiss_perp_2pto1p[2], double P2pto1p[2], double *Nboth);
+
+    void  prot3_count_func(const double counts[8], TVector3 V3prot[3], TLorentzVector V4el, double Ecal_3pto2p[][2], double pmiss_perp_3pto2p[][2],
+			   double P3pto2p[][2], double N_p1[3], double Ecal_3pto1p[3], double pmiss_perp_3pto1p[3], double *N_p3det);
+
+    void  prot1_pi1_count_func(const double counts[4], double *N_pi_p, double *N_nopi_p);
+
+    void  prot1_pi2_count_func(const double counts[8], double *P_1p0pi, double P_1p1pi[2]);
+
+    void  prot1_pi3_count_func(const double counts[16], double *P_tot);
+
+    void  prot2_pi1_count_func(const double counts[8], TVector3 V3_2prot_corr[2], TLorentzVector V4_el, double Ecal_2p1pi_to2p0pi[2],
+			       double p_miss_perp_2p1pi_to2p0pi[2], double P_2p1pito2p0pi[2], double P_2p1pito1p1pi[2], double P_2p1pito1p0pi[2], double *P_tot);
+
+    void  prot2_pi2_count_func(const double counts[16], TVector3 V3_2prot_corr[2], TLorentzVector V4_el, double Ecal_2p2pi[2], double p_miss_perp_2p2pi[2], double P_tot_2p[2]);
+
+    void  prot3_pi1_count_func(const double counts[16], TVector3 V3_3prot_corr[3], TVector3 V3_3prot_uncorr[3], TLorentzVector V4_el, double Ecal_3p1pi[3], double p_miss_perp_3p1pi[3], double P_tot_3p[3]);
+
+    void  pi1_count_func(const double counts[2], double *P_pi);
+
+    void  pi2_count_func(const double counts[4], double *P_0pi, double P_1pi[2]);
+
+    void  pi3_count_func(const double counts[8], double *P_0pi, double P_1pi[3], double P_320[3], double P_3210[][2]);
+
+    void  pi4_count_func(const double counts[16], double *P_0pi, double *P_410, double *P_420, double *P_4210, double *P_430, double *P_4310, double *P_4320, double *P_43210);
+
+    // Generic rotation engine. The N particles are rotated N_tot times around q and each rotated particle is checked once
+    // counts[mask] is the number of rotations where exactly the particles in mask (bit i for particle i) are detected
+    // Protons use PFiducialCut, pions and photons use Pi_phot_fid_united with their charge
+    template <unsigned int N>
+      void  RotateSubsets(const TVector3 V3[N], const bool is_proton[N], const int q[N], double counts[1<<N]) {
+      int pdg[N];
+      for(unsigned int i=0; i<N; i++) pdg[i] = is_proton[i] ? conf::kPdgProton : q[i]>0 ? conf::kPdgPiP : q[i]<0 ? conf::kPdgPiM : conf::kPdgPhoton;
+      RotatedCounts(V3, pdg, N, counts);
+    }
+
+    // Same engine for any list of particles (up to 16), i.e. for topologies defined in the configuration file
+    // The fiducial cut and the charge are set from the particle pdg
+    void  RotateSubsets(const std::vector<TVector3> & V3, const std::vector<int> & pdg, std::vector<double> & counts) {
+      unsigned int n=V3.size();
+      if(n>16 || pdg.size()!=n) {
+	std::cout << " ERROR : Cannot rotate " << n << " particles" << std::endl;
+	counts.clear();
+	return;
+      }
+      // Protons use PFiducialCut, any other particle uses Pi_phot_fid_united with its charge
+      std::vector<int> cut_pdg(n);
+      for(unsigned int i=0; i<n; i++) {
+	cut_pdg[i] = pdg[i];
+	if(pdg[i]!=conf::kPdgProton && pdg[i]!=conf::kPdgPiP && pdg[i]!=conf::kPdgPiM) cut_pdg[i] = conf::kPdgPhoton;
+      }
+      counts.assign(1u<<n, 0);
+      RotatedCounts(V3.data(), cut_pdg.data(), n, counts.data());
+    }
+
+    // Number of rotations where the particles in the particles mask have the status given by detected. The other particles can have any status
+    template <unsigned int N>
+      static double CountStatus(const double counts[1<<N], const unsigned int particles, const unsigned int detected) {
+      double n=0;
+      for(unsigned int mask=0; mask<(1u<<N); mask++) if((mask & particles)==detected) n+=counts[mask];
+      return n;
+    }
+
+    // Counts for the M particles index[0..M-1], summed over the status of the other particles
+    template <unsigned int N, unsigned int M>
+      static void ProjectCounts(const double counts[1<<N], const unsigned int index[M], double sub_counts[1<<M]) {
+      for(unsigned int sub=0; sub<(1u<<M); sub++) sub_counts[sub]=0;
+      for(unsigned int mask=0; mask<(1u<<N); mask++) {
+	unsigned int sub=0;
+	for(unsigned int i=0; i<M; i++) if(mask & (1u<<index[i])) sub|=1u<<i;
+	sub_counts[sub]+=counts[mask];
+      }
+    }
+
+    // The n particles are rotated for the next N_tot angles (see RotationKernel), and each particle is checked
+    // for all the angles at once with Fiducial::DetectorFiducialCutBatch
+    void  RotatedCounts(const TVector3 * V3, const int * pdg, const unsigned int n, double * counts) {
+      for(unsigned int mask=0; mask<(1u<<n); mask++) counts[mask]=0;
+      if(N_tot<=0) return;
+      std::vector<double> angles(N_tot);
+      for(int g=0; g<N_tot; g++) angles[g]=NextRotationAngle();
+      RotationKernel kernel(fUnitQ, std::vector<TVector3>(V3, V3+n));
+      kernel.Rotate(angles);
+      std::vector<unsigned int> masks(N_tot, 0);
+      std::unique_ptr<bool[]> is_detected(new bool[N_tot]);
+      for(unsigned int i=0; i<n; i++) {
+	fiducialcut->DetectorFiducialCutBatch(pdg[i], fbeam_en, N_tot, kernel.GetX(i), kernel.GetY(i), kernel.GetZ(i), is_detected.get());
+	for(int g=0; g<N_tot; g++) if(is_detected[g]) masks[g]|=1u<<i;
+      }
+      for(int g=0; g<N_tot; g++) counts[masks[g]]+=1;
+    }
+
     void  SetQVector(TVector3 qin) {
       V3q.SetX(qin.X());
       V3q.SetY(qin.Y());
       V3q.SetZ(qin.Z());
+      fUnitQ = V3q.Mag() > 0 ? V3q.Unit() : TVector3(0,0,0) ;
     }
 
     void  ResetQVector() {
       V3q.SetX(0);
       V3q.SetY(0);
       V3q.SetZ(0);
+      fUnitQ = TVector3(0,0,0) ;
+    }
+
+    // The rotation angles are drawn from the event stream (see CounterRNG). It must be set for each event
+    void  SetRandomStream( const unsigned long seed, const unsigned long key ) {
+      fRNG = CounterRNG( seed, key, kRandomSubtraction ) ;
+      fRandomCounter = 0 ;
+    }
+
+    void  SetRotationMethod( const RotationMethod method ) {
+      fRotationMethod = method ;
+    }
+
+    // Each rotation loop uses N_tot consecutive angles
+    double NextRotationAngle() {
+      return fRNG.RotationAngle( fRotationMethod, fRandomCounter++, N_tot ) ;
     }
 
     void  PrintQVector() {
@@ -84,12 +202,16 @@ namespace e4nu{
       return fiducialcut->Pi_phot_fid_united(beam_en,V3_pi_phot, q_pi_phot);
     }
 
-    Fiducial * fiducialcut;
+    const Fiducial * fiducialcut;
     TVector3 V3q;
     double fbeam_en;
     unsigned int ftarget_pdg;
     double bind_en;
     int N_tot;
+    CounterRNG fRNG = CounterRNG( 0, 0, kRandomSubtraction ) ;
+    unsigned long fRandomCounter = 0 ;
+    RotationMethod fRotationMethod = kRandomRotations ;
+    TVector3 fUnitQ ;
   };
 }
 #endif
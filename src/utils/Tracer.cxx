@@ -0,0 +1,98 @@
+/**
+ * This class records scoped spans in the trace-event JSON format
+ **/
+#include <iostream>
+#include <atomic>
+#include <unistd.h>
+#include "utils/Tracer.h"
+
+using namespace e4nu ;
+
+namespace {
+  // Small thread ids, in order of appearance
+  unsigned int GetThreadID(void) {
+    static std::atomic<unsigned int> n_threads( 0 ) ;
+    thread_local unsigned int thread_id = n_threads++ ;
+    return thread_id ;
+  }
+}
+
+Tracer & Tracer::Instance(void) {
+  static Tracer tracer ;
+  return tracer ;
+}
+
+Tracer::Tracer() {;}
+
+Tracer::~Tracer() {
+  this->Close() ;
+}
+
+bool Tracer::Open( const std::string file, const unsigned int sampling ) {
+  std::lock_guard<std::mutex> lock( kMutex ) ;
+  if( kIsEnabled ) return true ;
+
+  kFile.open( file.c_str() ) ;
+  if( ! kFile.is_open() ) {
+    std::cout << " ERROR : Cannot open trace file " << file << std::endl;
+    return false ;
+  }
+  kFile << "{\"traceEvents\":[" ;
+  kSampling = sampling == 0 ? 1 : sampling ;
+  kIsFirstEvent = true ;
+  kStart = std::chrono::steady_clock::now() ;
+  kIsEnabled = true ;
+  return true ;
+}
+
+void Tracer::Close(void) {
+  std::lock_guard<std::mutex> lock( kMutex ) ;
+  if( ! kIsEnabled ) return ;
+  kFile << "\n],\"displayTimeUnit\":\"ms\"}\n" ;
+  kFile.close() ;
+  kIsEnabled = false ;
+}
+
+double Tracer::Now(void) const {
+  return std::chrono::duration<double,std::micro>( std::chrono::steady_clock::now() - kStart ).count() ;
+}
+
+void Tracer::AddSpan( const char * name, const double start, const double end, const std::string & args ) {
+  std::lock_guard<std::mutex> lock( kMutex ) ;
+  if( ! kIsEnabled ) return ;
+  if( ! kIsFirstEvent ) kFile << "," ;
+  kIsFirstEvent = false ;
+  kFile << "\n{\"name\":\"" << name << "\",\"cat\":\"e4nu\",\"ph\":\"X\",\"ts\":" << start
+	<< ",\"dur\":" << end - start << ",\"pid\":" << getpid() << ",\"tid\":" << GetThreadID() ;
+  if( args.size() ) kFile << ",\"args\":{" << args << "}" ;
+  kFile << "}" ;
+}
+
+std::string Tracer::Escape( const std::string value ) {
+  std::string escaped ;
+  for( unsigned int i = 0 ; i < value.size() ; ++i ) {
+    if( value[i] == '"' || value[i] == '\\' ) escaped += '\\' ;
+    escaped += value[i] ;
+  }
+  return escaped ;
+}
+
+Tracer::Span::Span( const char * name, const bool record ) : kName( name ) {
+  kRecord = record && Tracer::Instance().IsEnabled() ;
+  if( kRecord ) kStart = Tracer::Instance().Now() ;
+}
+
+Tracer::Span::~Span() {
+  this->End() ;
+}
+
+void Tracer::Span::End(void) {
+  if( kRecord ) Tracer::Instance().AddSpan( kName, kStart, Tracer::Instance().Now(), kArgs ) ;
+  kRecord = false ;
+}
+
+void Tracer::Span::AddArg( const std::string key, const std::string value ) {
+  if( ! kRecord ) return ;
+  if( kArgs.size() ) kArgs += "," ;
+  kArgs += "\"" + Escape( key ) + "\":\"" + Escape( value ) + "\"" ;
+}
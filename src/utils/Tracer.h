@@ -0,0 +1,65 @@
+/**
+ * This class records scoped spans in the trace-event JSON format
+ * The output file can be opened with a local trace viewer (chrome://tracing or Perfetto)
+ *
+ * The tracer is disabled by default. Spans are ignored unless Open is called (see Trace configurable)
+ * Frequent spans (i.e. per-batch Analyse) are sampled, only one in kSampling is recorded
+ **/
+
+#ifndef _TRACER_H_
+#define _TRACER_H_
+
+#include <string>
+#include <fstream>
+#include <mutex>
+#include <chrono>
+
+namespace e4nu {
+
+  class Tracer {
+  public :
+    // Single tracer for the full process
+    static Tracer & Instance(void) ;
+
+    bool Open( const std::string file, const unsigned int sampling ) ;
+    void Close(void) ;
+
+    bool IsEnabled(void) const { return kIsEnabled ; }
+    bool IsSampled( const unsigned long i ) const { return kIsEnabled && i % kSampling == 0 ; }
+
+    // Time in microseconds since the tracer was opened
+    double Now(void) const ;
+
+    // Complete event with the calling thread id. args is a list of "key":"value" pairs
+    void AddSpan( const char * name, const double start, const double end, const std::string & args = "" ) ;
+
+    // Scoped span. It is only recorded if the tracer is enabled and record is true
+    class Span {
+    public :
+      Span( const char * name, const bool record = true ) ;
+      ~Span() ;
+      void End(void) ; // Records the span before the end of the scope
+      void AddArg( const std::string key, const std::string value ) ;
+    private :
+      const char * kName ;
+      std::string kArgs ;
+      double kStart = 0 ;
+      bool kRecord = false ;
+    } ;
+
+    static std::string Escape( const std::string value ) ;
+
+  private :
+    Tracer() ;
+    ~Tracer() ;
+
+    bool kIsEnabled = false ;
+    unsigned int kSampling = 1 ;
+    bool kIsFirstEvent = true ;
+    std::ofstream kFile ;
+    std::mutex kMutex ;
+    std::chrono::steady_clock::time_point kStart ;
+  } ;
+}
+
+#endif
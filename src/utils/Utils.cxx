@@ -26,3 +26,10 @@ void utils::PrintProgressBar( const unsigned int curr_event, const unsigned int
 
   std::cout << std::endl;
 }
+
+unsigned long utils::HashEntry( const unsigned long entry ) {
+  unsigned long z = entry + 0x9E3779B97F4A7C15UL ;
+  z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9UL ;
+  z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBUL ;
+  return z ^ ( z >> 31 ) ;
+}
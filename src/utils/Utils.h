@@ -5,6 +5,8 @@ namespace e4nu {
   namespace utils
   {
     void PrintProgressBar( const unsigned int curr_event, const unsigned int total_events ) ;
+    // 64 bit mixing function (splitmix64 finalizer). Consecutive inputs give uncorrelated outputs
+    unsigned long HashEntry( const unsigned long entry ) ;
   }
 }
 